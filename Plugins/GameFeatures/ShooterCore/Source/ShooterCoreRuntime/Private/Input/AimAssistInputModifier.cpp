@@ -135,6 +135,7 @@ FAimAssistSettings::FAimAssistSettings()
 	SlowMinRotationRate.SetValue(0.0f);
 
 	bEnableAsyncVisibilityTrace = true;
+	bEnableAsyncTargetOverlap = false;
 	bRequireInput = true;
 	bApplyPull = true;
 	bApplySlowing = true;
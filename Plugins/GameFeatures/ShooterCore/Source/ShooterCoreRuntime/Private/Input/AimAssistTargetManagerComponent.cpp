@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Input/AimAssistTargetManagerComponent.h"
+#include "Async/ParallelFor.h"
 #include "CommonInputTypeEnum.h"
 #include "Engine/OverlapResult.h"
 #include "Engine/World.h"
@@ -26,17 +27,36 @@ namespace LyraConsoleVariables
 		bDrawDebugViewfinder,
 		TEXT("Should we draw a debug box for the aim assist target viewfinder?"),
 		ECVF_Cheat);
+
+	static bool bParallelTargetEvaluation = true;
+	static FAutoConsoleVariableRef CVarParallelTargetEvaluation(
+		TEXT("lyra.Weapon.AimAssist.ParallelTargetEvaluation"),
+		bParallelTargetEvaluation,
+		TEXT("Should aim assist candidates be evaluated in parallel?"),
+		ECVF_Default);
+
+	static int32 TargetEvaluationBatchSize = 4;
+	static FAutoConsoleVariableRef CVarTargetEvaluationBatchSize(
+		TEXT("lyra.Weapon.AimAssist.TargetEvaluationBatchSize"),
+		TargetEvaluationBatchSize,
+		TEXT("Minimum number of aim assist candidates evaluated by each parallel task"),
+		ECVF_Default);
 }
 
-const FLyraAimAssistTarget* FindTarget(const TArray<FLyraAimAssistTarget>& Targets, const UShapeComponent* TargetComponent)
+namespace AimAssistTargetManager
 {
-	const FLyraAimAssistTarget* FoundTarget = Targets.FindByPredicate(
-	[&TargetComponent](const FLyraAimAssistTarget& Target)
-	{
-		return (Target.TargetShapeComponent == TargetComponent);
-	});
+	// Asynchronous overlap state is dropped for players that haven't gathered targets for this many frames
+	static constexpr uint64 PendingOverlapTimeoutFrames = 30;
+}
 
-	return FoundTarget;
+void FAimAssistCandidates::Reset(int32 NumCandidates)
+{
+	Locations.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+	ScreenBounds.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+	ViewDistances.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+	SortScores.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+	OldTargetIndices.SetNumUninitialized(NumCandidates, EAllowShrinking::No);
+	bAccepted.SetNumZeroed(NumCandidates, EAllowShrinking::No);
 }
 
 static bool GatherTargetInfo(const AActor* Actor, const UShapeComponent* ShapeComponent, FTransform& OutTransform, FCollisionShape& OutShape, FVector& OutShapeOrigin)
@@ -119,73 +139,64 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 	const FBox2D AssistOuterReticleBounds = OwnerData.ProjectReticleToScreen(Settings.AssistOuterReticleWidth.GetValue(), Settings.AssistOuterReticleHeight.GetValue(), ReticleDepth);
 	const FBox2D TargetingReticleBounds = OwnerData.ProjectReticleToScreen(Settings.TargetingReticleWidth.GetValue(), Settings.TargetingReticleHeight.GetValue(), ReticleDepth);
 
-	static TArray<FOverlapResult> OverlapResults;
 	// Do a world trace on the Aim Assist channel to get any visible targets
-	{
-		UWorld* World = GetWorld();
-		
-		OverlapResults.Reset();
-
-		const FVector PawnLocation = OwnerPawn->GetActorLocation();
-		ECollisionChannel AimAssistChannel = GetAimAssistChannel();
-		FCollisionQueryParams Params(SCENE_QUERY_STAT(AimAssist_QueryTargetsInRange), true);
-		Params.AddIgnoredActor(OwnerPawn);
-
-		// Need to multiply these by 0.5 because MakeBox takes in half extents
-		FCollisionShape BoxShape = FCollisionShape::MakeBox(FVector3f(ReticleDepth * 0.5f, Settings.AssistOuterReticleWidth.GetValue() * 0.5f, Settings.AssistOuterReticleHeight.GetValue() * 0.5f));						
-		World->OverlapMultiByChannel(OUT OverlapResults, PawnLocation, OwnerData.PlayerTransform.GetRotation(), AimAssistChannel, BoxShape, Params);
-
-#if ENABLE_DRAW_DEBUG && !UE_BUILD_SHIPPING
-		if(LyraConsoleVariables::bDrawDebugViewfinder)
-		{
-			DrawDebugBox(World, PawnLocation, BoxShape.GetBox(), OwnerData.PlayerTransform.GetRotation(), FColor::Red);	
-		}
-#endif
-	}
+	const TArray<FOverlapResult>& ReticleOverlaps = GatherReticleOverlaps(Settings, OwnerData, OwnerPawn, ReticleDepth);
 
 	// Gather target options from any visibile hit results that implement the IAimAssistTarget interface
-	TArray<FAimAssistTargetOptions> NewTargetData;
+	Candidates.Options.Reset();
 	{
-		for (const FOverlapResult& Overlap : OverlapResults)
+		for (const FOverlapResult& Overlap : ReticleOverlaps)
 		{
 			TScriptInterface<IAimAssistTaget> TargetActor(Overlap.GetActor());
 			if (TargetActor)
 			{
-				FAimAssistTargetOptions TargetData;
-				TargetActor->GatherTargetOptions(TargetData);
-				NewTargetData.Add(TargetData);
+				TargetActor->GatherTargetOptions(Candidates.Options.AddDefaulted_GetRef());
 			}
 			
 			TScriptInterface<IAimAssistTaget> TargetComponent(Overlap.GetComponent());
 			if (TargetComponent)
 			{
-				FAimAssistTargetOptions TargetData;
-				TargetComponent->GatherTargetOptions(TargetData);
-				NewTargetData.Add(TargetData);
+				TargetComponent->GatherTargetOptions(Candidates.Options.AddDefaulted_GetRef());
 			}			
 		}
 	}
+
+	Candidates.Reset(Candidates.Options.Num());
+
+	// Hash last frame's targets so each candidate can find its previous state directly
+	OldTargetIndexMap.Reset();
+	for (int32 OldTargetIndex = 0; OldTargetIndex < OldTargets.Num(); ++OldTargetIndex)
+	{
+		if (const UShapeComponent* OldShapeComponent = OldTargets[OldTargetIndex].TargetShapeComponent.Get())
+		{
+			OldTargetIndexMap.Add(OldShapeComponent, OldTargetIndex);
+		}
+	}
 	
-	// Gather targets that are in front of the player
+	// Evaluate targets that are in front of the player. Each candidate only reads the world and writes its own slot,
+	// so this runs in parallel and completes before we return to the input modifier.
 	{
-		const FVector PawnLocation = OwnerPawn->GetActorLocation();		
+		TRACE_CPUPROFILER_EVENT_SCOPE(UAimAssistTargetManagerComponent::EvaluateCandidates);
 		
-		for (FAimAssistTargetOptions& AimAssistTarget : NewTargetData)
+		auto EvaluateCandidate = [&](int32 CandidateIndex)
 		{
+			const FAimAssistTargetOptions& AimAssistTarget = Candidates.Options[CandidateIndex];
+			
 			if (!DoesTargetPassFilter(OwnerData, Filter, AimAssistTarget, TargetRange))
 			{
-				continue;
+				return;
 			}
 			
-			AActor* OwningActor = AimAssistTarget.TargetShapeComponent->GetOwner();
+			const UShapeComponent* TargetShapeComponent = AimAssistTarget.TargetShapeComponent.Get();
+			const AActor* OwningActor = TargetShapeComponent->GetOwner();
 
 			FTransform TargetTransform;
 			FCollisionShape TargetShape;
 			FVector TargetShapeOrigin;
 
-			if (!GatherTargetInfo(OwningActor, AimAssistTarget.TargetShapeComponent.Get(), TargetTransform, TargetShape, TargetShapeOrigin))
+			if (!GatherTargetInfo(OwningActor, TargetShapeComponent, TargetTransform, TargetShape, TargetShapeOrigin))
 			{
-				continue;
+				return;
 			}
 			
 			const FVector TargetViewLocation = TargetTransform.TransformPositionNoScale(TargetShapeOrigin);
@@ -197,63 +208,68 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 			const float TargetViewDot = FVector::DotProduct(TargetViewDirection, ViewForward);
 			if (TargetViewDot <= 0.0f)
 			{
-				continue;
+				return;
 			}
-			
-			const FLyraAimAssistTarget* OldTarget = FindTarget(OldTargets, AimAssistTarget.TargetShapeComponent.Get());
 
 			// Calculate the screen bounds for this target
-			FBox2D TargetScreenBounds(ForceInitToZero);
-			const bool bUpdateTargetProjections = true;
-			if (bUpdateTargetProjections)
-			{
-				TargetScreenBounds = OwnerData.ProjectShapeToScreen(TargetShape, TargetShapeOrigin, TargetTransform);
-			}
-			else
-			{
-				// Target projections are not being updated so use the values from the previous frame if the target existed.
-				if (OldTarget)
-				{
-					TargetScreenBounds = OldTarget->ScreenBounds;
-				}
-			}
+			const FBox2D TargetScreenBounds = OwnerData.ProjectShapeToScreen(TargetShape, TargetShapeOrigin, TargetTransform);
 
 			if (!TargetScreenBounds.bIsValid)
 			{
-				continue;
+				return;
 			}
 
 			if (!TargetingReticleBounds.Intersect(TargetScreenBounds))
 			{
-				continue;
+				return;
 			}
 
-			FLyraAimAssistTarget NewTarget;
-
-			NewTarget.TargetShapeComponent = AimAssistTarget.TargetShapeComponent;
-			NewTarget.Location = TargetTransform.GetTranslation();
-			NewTarget.ScreenBounds = TargetScreenBounds;
-			NewTarget.ViewDistance = TargetViewDistance;
-			NewTarget.bUnderAssistInnerReticle = AssistInnerReticleBounds.Intersect(TargetScreenBounds);
-			NewTarget.bUnderAssistOuterReticle = AssistOuterReticleBounds.Intersect(TargetScreenBounds);
-			
-			// Transfer target data from last frame.
-			if (OldTarget)
-			{
-				NewTarget.DeltaMovement = (NewTarget.Location - OldTarget->Location);
-				NewTarget.AssistTime = OldTarget->AssistTime;
-				NewTarget.AssistWeight = OldTarget->AssistWeight;
-				NewTarget.VisibilityTraceHandle = OldTarget->VisibilityTraceHandle;
-			}
+			const int32* OldTargetIndex = OldTargetIndexMap.Find(TargetShapeComponent);
+			const float OldAssistWeight = OldTargetIndex ? OldTargets[*OldTargetIndex].AssistWeight : 0.0f;
 
 			// Calculate a score used for sorting based on previous weight, distance from target, and distance from reticle.
-			const float AssistWeightScore = (NewTarget.AssistWeight * Settings.TargetScore_AssistWeight);
+			const float AssistWeightScore = (OldAssistWeight * Settings.TargetScore_AssistWeight);
 			const float ViewDotScore = ((TargetViewDot * Settings.TargetScore_ViewDot) - Settings.TargetScore_ViewDotOffset);
 			const float ViewDistanceScore = ((1.0f - (TargetViewDistance / TargetRange)) * Settings.TargetScore_ViewDistance);
 
-			NewTarget.SortScore = (AssistWeightScore + ViewDotScore + ViewDistanceScore);
+			Candidates.Locations[CandidateIndex] = TargetTransform.GetTranslation();
+			Candidates.ScreenBounds[CandidateIndex] = TargetScreenBounds;
+			Candidates.ViewDistances[CandidateIndex] = TargetViewDistance;
+			Candidates.SortScores[CandidateIndex] = (AssistWeightScore + ViewDotScore + ViewDistanceScore);
+			Candidates.OldTargetIndices[CandidateIndex] = OldTargetIndex ? *OldTargetIndex : INDEX_NONE;
+			Candidates.bAccepted[CandidateIndex] = true;
+		};
+
+		const EParallelForFlags ParallelForFlags = LyraConsoleVariables::bParallelTargetEvaluation ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+		ParallelFor(TEXT("AimAssist.EvaluateCandidates"), Candidates.Num(), FMath::Max(LyraConsoleVariables::TargetEvaluationBatchSize, 1), EvaluateCandidate, ParallelForFlags);
+	}
 
-			OutNewTargets.Add(NewTarget);
+	// Build the targets from the accepted candidates, in the same order as the overlap
+	for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+	{
+		if (!Candidates.bAccepted[CandidateIndex])
+		{
+			continue;
+		}
+
+		FLyraAimAssistTarget& NewTarget = OutNewTargets.AddDefaulted_GetRef();
+
+		NewTarget.TargetShapeComponent = Candidates.Options[CandidateIndex].TargetShapeComponent;
+		NewTarget.Location = Candidates.Locations[CandidateIndex];
+		NewTarget.ScreenBounds = Candidates.ScreenBounds[CandidateIndex];
+		NewTarget.ViewDistance = Candidates.ViewDistances[CandidateIndex];
+		NewTarget.SortScore = Candidates.SortScores[CandidateIndex];
+		NewTarget.bUnderAssistInnerReticle = AssistInnerReticleBounds.Intersect(NewTarget.ScreenBounds);
+		NewTarget.bUnderAssistOuterReticle = AssistOuterReticleBounds.Intersect(NewTarget.ScreenBounds);
+		
+		// Transfer target data from last frame.
+		if (OldTargets.IsValidIndex(Candidates.OldTargetIndices[CandidateIndex]))
+		{
+			const FLyraAimAssistTarget& OldTarget = OldTargets[Candidates.OldTargetIndices[CandidateIndex]];
+			NewTarget.DeltaMovement = (NewTarget.Location - OldTarget.Location);
+			NewTarget.AssistTime = OldTarget.AssistTime;
+			NewTarget.AssistWeight = OldTarget.AssistWeight;
+			NewTarget.VisibilityTraceHandle = OldTarget.VisibilityTraceHandle;
 		}
 	}
 
@@ -277,6 +293,110 @@ void UAimAssistTargetManagerComponent::GetVisibleTargets(const FAimAssistFilter&
 	}
 }
 
+const TArray<FOverlapResult>& UAimAssistTargetManagerComponent::GatherReticleOverlaps(const FAimAssistSettings& Settings, const FAimAssistOwnerViewData& OwnerData, const APawn* OwnerPawn, float ReticleDepth)
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	const FVector PawnLocation = OwnerPawn->GetActorLocation();
+	const FQuat QueryRotation = OwnerData.PlayerTransform.GetRotation();
+	ECollisionChannel AimAssistChannel = GetAimAssistChannel();
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(AimAssist_QueryTargetsInRange), true);
+	Params.AddIgnoredActor(OwnerPawn);
+
+	// Need to multiply these by 0.5 because MakeBox takes in half extents
+	FCollisionShape BoxShape = FCollisionShape::MakeBox(FVector3f(ReticleDepth * 0.5f, Settings.AssistOuterReticleWidth.GetValue() * 0.5f, Settings.AssistOuterReticleHeight.GetValue() * 0.5f));
+
+#if ENABLE_DRAW_DEBUG && !UE_BUILD_SHIPPING
+	if(LyraConsoleVariables::bDrawDebugViewfinder)
+	{
+		DrawDebugBox(World, PawnLocation, BoxShape.GetBox(), QueryRotation, FColor::Red);	
+	}
+#endif
+
+	PrunePendingOverlaps();
+
+	if (!Settings.bEnableAsyncTargetOverlap)
+	{
+		PendingOverlaps.Remove(OwnerData.PlayerController);
+
+		OverlapResults.Reset();
+		World->OverlapMultiByChannel(OUT OverlapResults, PawnLocation, QueryRotation, AimAssistChannel, BoxShape, Params);
+		return OverlapResults;
+	}
+
+	FAimAssistPendingOverlap& PendingOverlap = PendingOverlaps.FindOrAdd(OwnerData.PlayerController);
+	PendingOverlap.LastGatherFrame = GFrameCounter;
+
+	// Pick up the results of the overlap issued on a previous frame
+	if (PendingOverlap.TraceHandle.IsValid())
+	{
+		FOverlapDatum OverlapDatum;
+		if (World->QueryOverlapData(PendingOverlap.TraceHandle, OverlapDatum))
+		{
+			PendingOverlap.OverlapResults = MoveTemp(OverlapDatum.OutOverlaps);
+			PendingOverlap.bHasResults = true;
+		}
+		else
+		{
+			UE_LOG(LogAimAssist, Verbose, TEXT("UAimAssistTargetManagerComponent::GatherReticleOverlaps() - Async overlap data expired, falling back to a synchronous overlap."));
+			PendingOverlap.bHasResults = false;
+		}
+
+		PendingOverlap.TraceHandle = FTraceHandle();
+	}
+
+	// Nothing to reuse yet, so do this frame's query synchronously
+	if (!PendingOverlap.bHasResults)
+	{
+		PendingOverlap.OverlapResults.Reset();
+		World->OverlapMultiByChannel(OUT PendingOverlap.OverlapResults, PawnLocation, QueryRotation, AimAssistChannel, BoxShape, Params);
+		PendingOverlap.QueryTransform = OwnerData.PlayerTransform;
+		PendingOverlap.NumReusedFrames = 0;
+		PendingOverlap.bHasResults = true;
+		return PendingOverlap.OverlapResults;
+	}
+
+	// Keep using the current candidates while the view has barely changed, the candidates themselves are re-evaluated every frame
+	const float MovedDistanceSq = FVector::DistSquared(PendingOverlap.QueryTransform.GetTranslation(), OwnerData.PlayerTransform.GetTranslation());
+	const float RotatedAngle = FMath::RadiansToDegrees(PendingOverlap.QueryTransform.GetRotation().AngularDistance(QueryRotation));
+	const bool bCanReuseCandidates = (MovedDistanceSq <= FMath::Square(Settings.CandidateReuseMaxDistance))
+		&& (RotatedAngle <= Settings.CandidateReuseMaxAngle)
+		&& (PendingOverlap.NumReusedFrames < Settings.CandidateReuseMaxFrames);
+
+	if (bCanReuseCandidates)
+	{
+		++PendingOverlap.NumReusedFrames;
+	}
+	else
+	{
+		// Issue the overlap for next frame
+		PendingOverlap.TraceHandle = World->AsyncOverlapByChannel(PawnLocation, QueryRotation, AimAssistChannel, BoxShape, Params);
+		PendingOverlap.QueryTransform = OwnerData.PlayerTransform;
+		PendingOverlap.NumReusedFrames = 0;
+	}
+
+	return PendingOverlap.OverlapResults;
+}
+
+void UAimAssistTargetManagerComponent::PrunePendingOverlaps()
+{
+	if (LastPruneFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastPruneFrame = GFrameCounter;
+
+	for (auto It = PendingOverlaps.CreateIterator(); It; ++It)
+	{
+		const bool bTimedOut = (GFrameCounter - It.Value().LastGatherFrame) > AimAssistTargetManager::PendingOverlapTimeoutFrames;
+		if (bTimedOut || (It.Key().ResolveObjectPtr() == nullptr))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
 bool UAimAssistTargetManagerComponent::DoesTargetPassFilter(const FAimAssistOwnerViewData& OwnerData, const FAimAssistFilter& Filter, const FAimAssistTargetOptions& Target, const float AcceptableRange) const
 {
 	const APawn* OwnerPawn = OwnerData.PlayerController ? OwnerData.PlayerController->GetPawn() : nullptr;
@@ -17,20 +17,23 @@ void UAssistProcessor::StartListening()
 {
 	UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
 	AddListenerHandle(MessageSubsystem.RegisterListener(TAG_Lyra_Elimination_Message, this, &ThisClass::OnEliminationMessage));
-	AddListenerHandle(MessageSubsystem.RegisterListener(TAG_Lyra_Damage_Message, this, &ThisClass::OnDamageMessage));
+	AddListenerHandle(MessageSubsystem.RegisterBatchListener(TAG_Lyra_Damage_Message, this, &ThisClass::OnDamageMessages));
 }
 
-void UAssistProcessor::OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload)
+void UAssistProcessor::OnDamageMessages(FGameplayTag Channel, TConstArrayView<FLyraVerbMessage> Payloads)
 {
-	if (Payload.Instigator != Payload.Target)
+	for (const FLyraVerbMessage& Payload : Payloads)
 	{
-		if (APlayerState* InstigatorPS = ULyraVerbMessageHelpers::GetPlayerStateFromObject(Payload.Instigator))
+		if (Payload.Instigator != Payload.Target)
 		{
-			if (APlayerState* TargetPS = ULyraVerbMessageHelpers::GetPlayerStateFromObject(Payload.Target))
+			if (APlayerState* InstigatorPS = ULyraVerbMessageHelpers::GetPlayerStateFromObject(Payload.Instigator))
 			{
-				FPlayerAssistDamageTracking& Damage = DamageHistory.FindOrAdd(TargetPS);
-				float& DamageTotalFromTarget = Damage.AccumulatedDamageByPlayer.FindOrAdd(InstigatorPS);
-				DamageTotalFromTarget += Payload.Magnitude;
+				if (APlayerState* TargetPS = ULyraVerbMessageHelpers::GetPlayerStateFromObject(Payload.Target))
+				{
+					FPlayerAssistDamageTracking& Damage = DamageHistory.FindOrAdd(TargetPS);
+					float& DamageTotalFromTarget = Damage.AccumulatedDamageByPlayer.FindOrAdd(InstigatorPS);
+					DamageTotalFromTarget += Payload.Magnitude;
+				}
 			}
 		}
 	}
@@ -290,10 +290,26 @@ struct FAimAssistSettings
 	UPROPERTY(EditAnywhere)
 	float StrengthScale = 1.0f;
 
+	// Candidates found by the asynchronous reticle overlap are reused while the player has moved less than this distance since the overlap was issued.
+	UPROPERTY(EditAnywhere)
+	float CandidateReuseMaxDistance = 10.0f;
+
+	// Candidates found by the asynchronous reticle overlap are reused while the player has rotated less than this many degrees since the overlap was issued.
+	UPROPERTY(EditAnywhere)
+	float CandidateReuseMaxAngle = 1.0f;
+
+	// Maximum number of consecutive frames the same candidates can be reused, so targets moving into the reticle are still found.
+	UPROPERTY(EditAnywhere)
+	int32 CandidateReuseMaxFrames = 3;
+
 	/** Enabled/Disable asynchronous visibility traces. */
 	UPROPERTY(EditAnywhere)
 	uint8 bEnableAsyncVisibilityTrace : 1;
 
+	/** Enabled/Disable the asynchronous reticle overlap. The overlap is issued one frame ahead and its results are used to find candidates the next frame, so it is opt-in. */
+	UPROPERTY(EditAnywhere)
+	uint8 bEnableAsyncTargetOverlap : 1;
+
 	/** Whether or not we require input for aim assist to be applied */
 	UPROPERTY(EditAnywhere)
 	uint8 bRequireInput : 1;
@@ -3,6 +3,10 @@
 #pragma once
 
 #include "Components/GameStateComponent.h"
+#include "Engine/OverlapResult.h"
+#include "WorldCollision.h"
+#include "Input/IAimAssistTargetInterface.h"
+#include "UObject/ObjectKey.h"
 
 #include "AimAssistTargetManagerComponent.generated.h"
 
@@ -19,6 +23,52 @@ struct FAimAssistTargetOptions;
 struct FCollisionQueryParams;
 struct FLyraAimAssistTarget;
 
+/**
+ * Candidates considered by GetVisibleTargets, stored as a structure of arrays so they can be evaluated in parallel.
+ * Kept on the manager between frames so evaluating targets doesn't reallocate.
+ */
+struct FAimAssistCandidates
+{
+	void Reset(int32 NumCandidates);
+
+	int32 Num() const { return Options.Num(); }
+
+	// Gathered on the game thread from the overlap results
+	TArray<FAimAssistTargetOptions> Options;
+
+	// Written by the evaluation pass, one entry per candidate
+	TArray<FVector> Locations;
+	TArray<FBox2D> ScreenBounds;
+	TArray<float> ViewDistances;
+	TArray<float> SortScores;
+	TArray<int32> OldTargetIndices;
+	TArray<uint8> bAccepted;
+};
+
+/**
+ * State of the asynchronous reticle overlap for a single player
+ */
+struct FAimAssistPendingOverlap
+{
+	/** Handle of the overlap issued last frame, invalid if none is in flight */
+	FTraceHandle TraceHandle;
+
+	/** Results of the most recent overlap, used as the candidate set until a newer one completes */
+	TArray<FOverlapResult> OverlapResults;
+
+	/** Player transform the most recent overlap was issued from */
+	FTransform QueryTransform = FTransform::Identity;
+
+	/** How many frames in a row the candidate set has been reused without issuing a new overlap */
+	int32 NumReusedFrames = 0;
+
+	/** Frame the player last gathered overlaps on, players that stop gathering are pruned */
+	uint64 LastGatherFrame = 0;
+
+	/** False until the first overlap has completed */
+	bool bHasResults = false;
+};
+
 /**
  * The Aim Assist Target Manager Component is used to gather all aim assist targets that are within
  * a given player's view. Targets must implement the IAimAssistTargetInterface and be on the
@@ -53,6 +103,33 @@ protected:
 	
 	/** Setup CollisionQueryParams to ignore a set of actors based on filter settings. Such as Ignoring Requester or Instigator. */
 	UE_API void InitTargetSelectionCollisionParams(FCollisionQueryParams& OutParams, const AActor& RequestedBy, const FAimAssistFilter& Filter) const;
+
+private:
+
+	/**
+	 * Finds everything under the outer reticle on the Aim Assist channel.
+	 * With asynchronous overlaps enabled this returns the results of the overlap issued on a previous frame (or a synchronous one on first use)
+	 * and issues the next overlap, unless the player's view has barely changed and the current results can be reused.
+	 */
+	const TArray<FOverlapResult>& GatherReticleOverlaps(const FAimAssistSettings& Settings, const FAimAssistOwnerViewData& OwnerData, const APawn* OwnerPawn, float ReticleDepth);
+
+	/** Removes the asynchronous overlap state of players that were destroyed or stopped gathering targets, at most once per frame */
+	void PrunePendingOverlaps();
+
+	/** Results of the synchronous reticle overlap, reused every frame */
+	TArray<FOverlapResult> OverlapResults;
+
+	/** Asynchronous reticle overlap state for each local player using aim assist */
+	TMap<TObjectKey<APlayerController>, FAimAssistPendingOverlap> PendingOverlaps;
+
+	/** Frame PendingOverlaps was last pruned on */
+	uint64 LastPruneFrame = 0;
+
+	/** Candidates gathered from the overlap, reused every frame */
+	FAimAssistCandidates Candidates;
+
+	/** Index of each of last frame's targets, keyed by their shape component */
+	TMap<TObjectKey<UShapeComponent>, int32> OldTargetIndexMap;
 };
 
 #undef UE_API
@@ -33,7 +33,7 @@ public:
 	virtual void StartListening() override;
 
 private:
-	void OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
+	void OnDamageMessages(FGameplayTag Channel, TConstArrayView<FLyraVerbMessage> Payloads);
 	void OnEliminationMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
 
 private:
@@ -3,6 +3,7 @@
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
+#include "Engine/Level.h"
 #include "Engine/World.h"
 #include "UObject/ScriptMacros.h"
 #include "UObject/Stack.h"
@@ -11,6 +12,11 @@
 
 DEFINE_LOG_CATEGORY(LogGameplayMessageSubsystem);
 
+DECLARE_STATS_GROUP(TEXT("GameplayMessages"), STATGROUP_GameplayMessages, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Broadcasts"), STAT_GameplayMessages_Broadcasts, STATGROUP_GameplayMessages);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Listener Invocations"), STAT_GameplayMessages_ListenerInvocations, STATGROUP_GameplayMessages);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Messages"), STAT_GameplayMessages_QueuedMessages, STATGROUP_GameplayMessages);
+
 namespace UE
 {
 	namespace GameplayMessageSubsystem
@@ -19,9 +25,46 @@ namespace UE
 		static FAutoConsoleVariableRef CVarShouldLogMessages(TEXT("GameplayMessageSubsystem.LogMessages"),
 			ShouldLogMessages,
 			TEXT("Should messages broadcast through the gameplay message subsystem be logged?"));
+
+		static void LogMessage(const UGameplayMessageSubsystem* Subsystem, const TCHAR* Action, FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
+		{
+			FString* pContextString = nullptr;
+#if WITH_EDITOR
+			if (GIsEditor)
+			{
+				extern ENGINE_API FString GPlayInEditorContextString;
+				pContextString = &GPlayInEditorContextString;
+			}
+#endif
+
+			FString HumanReadableMessage;
+			StructType->ExportText(/*out*/ HumanReadableMessage, MessageBytes, /*Defaults=*/ nullptr, /*OwnerObject=*/ nullptr, PPF_None, /*ExportRootScope=*/ nullptr);
+			UE_LOG(LogGameplayMessageSubsystem, Log, TEXT("%s(%s, %s, %s)"), Action, pContextString ? **pContextString : *GetPathNameSafe(Subsystem), *Channel.ToString(), *HumanReadableMessage);
+		}
 	}
 }
 
+//////////////////////////////////////////////////////////////////////
+// FGameplayMessageQueueTickFunction
+
+void FGameplayMessageQueueTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target != nullptr)
+	{
+		Target->FlushQueuedMessages();
+	}
+}
+
+FString FGameplayMessageQueueTickFunction::DiagnosticMessage()
+{
+	return TEXT("FGameplayMessageQueueTickFunction");
+}
+
+FName FGameplayMessageQueueTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("GameplayMessageQueue"));
+}
+
 //////////////////////////////////////////////////////////////////////
 // FGameplayMessageListenerHandle
 
@@ -57,67 +100,324 @@ bool UGameplayMessageSubsystem::HasInstance(const UObject* WorldContextObject)
 
 void UGameplayMessageSubsystem::Deinitialize()
 {
+	ensureMsgf(BroadcastDepth == 0, TEXT("GameplayMessageSubsystem deinitialized while a broadcast was in flight"));
+
+	if (QueueFlushTickFunction.IsTickFunctionRegistered())
+	{
+		QueueFlushTickFunction.UnRegisterTickFunction();
+	}
+	QueueFlushTickFunction.Target = nullptr;
+	QueueFlushTickLevel.Reset();
+
+	// Drop anything still queued without delivering it, the listeners are going away too
+	for (TArray<FQueuedMessageBatch>* Batches : { &QueuedBatches, &FlushingBatches })
+	{
+		for (FQueuedMessageBatch& Batch : *Batches)
+		{
+			if (Batch.NumMessages > 0)
+			{
+				Batch.StructType->DestroyStruct(Batch.Data, Batch.NumMessages);
+			}
+		}
+		Batches->Reset();
+	}
+
 	ListenerMap.Reset();
+	ResolvedChannelMap.Reset();
+	DeferredListeners.Reset();
+	bHasPendingRemovals = false;
+	++ListenerGeneration;
 
 	Super::Deinitialize();
 }
 
+void UGameplayMessageSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	UGameplayMessageSubsystem* This = CastChecked<UGameplayMessageSubsystem>(InThis);
+	for (TArray<FQueuedMessageBatch>* Batches : { &This->QueuedBatches, &This->FlushingBatches })
+	{
+		for (FQueuedMessageBatch& Batch : *Batches)
+		{
+			const int32 Stride = Batch.NumMessages > 0 ? Batch.StructType->GetStructureSize() : 0;
+			for (int32 MessageIndex = 0; MessageIndex < Batch.NumMessages; ++MessageIndex)
+			{
+				Collector.AddPropertyReferencesWithStructARO(Batch.StructType, Batch.Data + (MessageIndex * Stride), This);
+			}
+		}
+	}
+}
+
 void UGameplayMessageSubsystem::BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
 {
 	// Log the message if enabled
 	if (UE::GameplayMessageSubsystem::ShouldLogMessages != 0)
 	{
-		FString* pContextString = nullptr;
-#if WITH_EDITOR
-		if (GIsEditor)
-		{
-			extern ENGINE_API FString GPlayInEditorContextString;
-			pContextString = &GPlayInEditorContextString;
-		}
-#endif
+		UE::GameplayMessageSubsystem::LogMessage(this, TEXT("BroadcastMessage"), Channel, StructType, MessageBytes);
+	}
+
+	// Batch listeners get a copy at the next flush, everyone else receives the message right away
+	const bool bHeldForBatchListeners = ResolveChannel(Channel).bHasBatchListeners && EnqueueMessage(Channel, StructType, MessageBytes, EDispatchTarget::BatchListeners);
+
+	DispatchMessages(Channel, StructType, static_cast<const uint8*>(MessageBytes), 1, bHeldForBatchListeners ? EDispatchTarget::ImmediateListeners : EDispatchTarget::AllListeners);
+}
 
-		FString HumanReadableMessage;
-		StructType->ExportText(/*out*/ HumanReadableMessage, MessageBytes, /*Defaults=*/ nullptr, /*OwnerObject=*/ nullptr, PPF_None, /*ExportRootScope=*/ nullptr);
-		UE_LOG(LogGameplayMessageSubsystem, Log, TEXT("BroadcastMessage(%s, %s, %s)"), pContextString ? **pContextString : *GetPathNameSafe(this), *Channel.ToString(), *HumanReadableMessage);
+void UGameplayMessageSubsystem::DispatchMessages(FGameplayTag Channel, const UScriptStruct* StructType, const uint8* MessageBytes, int32 NumMessages, EDispatchTarget Target)
+{
+	if (Target != EDispatchTarget::BatchListeners)
+	{
+		INC_DWORD_STAT_BY(STAT_GameplayMessages_Broadcasts, NumMessages);
 	}
 
-	// Broadcast the message
-	bool bOnInitialTag = true;
-	for (FGameplayTag Tag = Channel; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	const int32 Stride = StructType->GetStructureSize();
+
+	// Listener slots cannot move while we are broadcasting, so registrations and removals made by callbacks are
+	// deferred until the outermost broadcast returns. This lets us walk the resolved set without copying it.
+	// We hold a view rather than the FResolvedChannel itself as nested broadcasts may add entries to ResolvedChannelMap.
+	const TConstArrayView<FResolvedListener> ResolvedListeners = ResolveChannel(Channel).Listeners;
+
+	++BroadcastDepth;
+
+	for (const FResolvedListener& Resolved : ResolvedListeners)
 	{
-		if (const FChannelListenerList* pList = ListenerMap.Find(Tag))
+		const FGameplayMessageListenerData& Listener = *Resolved.Listener;
+		if (Listener.bPendingRemoval)
 		{
-			// Copy in case there are removals while handling callbacks
-			TArray<FGameplayMessageListenerData> ListenerArray(pList->Listeners);
+			continue;
+		}
 
-			for (const FGameplayMessageListenerData& Listener : ListenerArray)
+		const bool bIsBatchListener = static_cast<bool>(Listener.BatchReceivedCallback);
+		if ((bIsBatchListener && (Target == EDispatchTarget::ImmediateListeners)) || (!bIsBatchListener && (Target == EDispatchTarget::BatchListeners)))
+		{
+			continue;
+		}
+
+		if (Listener.bHadValidType && !Listener.ListenerStructType.IsValid())
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Warning, TEXT("Listener struct type has gone invalid on Channel %s. Removing listener from list"), *Resolved.ListenerChannel.ToString());
+			UnregisterListenerInternal(Resolved.ListenerChannel, Listener.HandleID);
+			continue;
+		}
+
+		// The receiving type must be either a parent of the sending type or completely ambiguous (for internal use)
+		if (!Listener.bHadValidType || StructType->IsChildOf(Listener.ListenerStructType.Get()))
+		{
+			if (Listener.BatchReceivedCallback && (Listener.BatchMode == EGameplayMessageBatchMode::LatestOnly))
+			{
+				INC_DWORD_STAT(STAT_GameplayMessages_ListenerInvocations);
+				Listener.BatchReceivedCallback(Channel, StructType, MessageBytes + ((NumMessages - 1) * Stride), 1);
+			}
+			else if (Listener.BatchReceivedCallback && (Listener.ListenerStructType.Get() == StructType))
+			{
+				INC_DWORD_STAT(STAT_GameplayMessages_ListenerInvocations);
+				Listener.BatchReceivedCallback(Channel, StructType, MessageBytes, NumMessages);
+			}
+			else
 			{
-				if (bOnInitialTag || (Listener.MatchType == EGameplayMessageMatch::PartialMatch))
+				// Either a single message listener, or a batch listener expecting a parent struct type that cannot be viewed with our stride
+				for (int32 MessageIndex = 0; (MessageIndex < NumMessages) && !Listener.bPendingRemoval; ++MessageIndex)
 				{
-					if (Listener.bHadValidType && !Listener.ListenerStructType.IsValid())
+					INC_DWORD_STAT(STAT_GameplayMessages_ListenerInvocations);
+					const uint8* Message = MessageBytes + (MessageIndex * Stride);
+					if (Listener.BatchReceivedCallback)
 					{
-						UE_LOG(LogGameplayMessageSubsystem, Warning, TEXT("Listener struct type has gone invalid on Channel %s. Removing listener from list"), *Channel.ToString());
-						UnregisterListenerInternal(Channel, Listener.HandleID);
-						continue;
+						Listener.BatchReceivedCallback(Channel, StructType, Message, 1);
 					}
-
-					// The receiving type must be either a parent of the sending type or completely ambiguous (for internal use)
-					if (!Listener.bHadValidType || StructType->IsChildOf(Listener.ListenerStructType.Get()))
+					else
 					{
-						Listener.ReceivedCallback(Channel, StructType, MessageBytes);
+						Listener.ReceivedCallback(Channel, StructType, Message);
 					}
-					else
+				}
+			}
+		}
+		else
+		{
+			UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("Struct type mismatch on channel %s (broadcast type %s, listener at %s was expecting type %s)"),
+				*Channel.ToString(),
+				*StructType->GetPathName(),
+				*Resolved.ListenerChannel.ToString(),
+				*Listener.ListenerStructType->GetPathName());
+		}
+	}
+
+	--BroadcastDepth;
+
+	if (BroadcastDepth == 0)
+	{
+		FlushDeferredListenerChanges();
+	}
+}
+
+void UGameplayMessageSubsystem::QueueMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
+{
+	if (UE::GameplayMessageSubsystem::ShouldLogMessages != 0)
+	{
+		UE::GameplayMessageSubsystem::LogMessage(this, TEXT("QueueMessage"), Channel, StructType, MessageBytes);
+	}
+
+	if (!EnqueueMessage(Channel, StructType, MessageBytes, EDispatchTarget::AllListeners))
+	{
+		// Nothing would ever flush the queue, so deliver it right away
+		DispatchMessages(Channel, StructType, static_cast<const uint8*>(MessageBytes), 1, EDispatchTarget::AllListeners);
+	}
+}
+
+bool UGameplayMessageSubsystem::EnqueueMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, EDispatchTarget Target)
+{
+	if (!RegisterQueueFlushTickFunction())
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_GameplayMessages_QueuedMessages);
+
+	// Only a handful of channels are queued in any given frame, so a linear search beats hashing here
+	FQueuedMessageBatch* Batch = QueuedBatches.FindByPredicate([Channel, StructType, Target](const FQueuedMessageBatch& Other) { return (Other.Channel == Channel) && (Other.StructType == StructType) && (Other.Target == Target); });
+	if (Batch == nullptr)
+	{
+		Batch = QueuedBatches.FindByPredicate([](const FQueuedMessageBatch& Other) { return Other.NumMessages == 0; });
+		if (Batch == nullptr)
+		{
+			Batch = &QueuedBatches.AddDefaulted_GetRef();
+		}
+		Batch->Channel = Channel;
+		Batch->StructType = StructType;
+		Batch->Target = Target;
+	}
+
+	uint8* Dest = Batch->AddUninitializedMessage();
+	StructType->InitializeStruct(Dest);
+	StructType->CopyScriptStruct(Dest, MessageBytes);
+
+	return true;
+}
+
+void UGameplayMessageSubsystem::FlushQueuedMessages()
+{
+	if (bIsFlushingQueuedMessages)
+	{
+		return;
+	}
+
+	TGuardValue<bool> FlushGuard(bIsFlushingQueuedMessages, true);
+
+	// Anything queued by listeners from here on goes into the other set of buffers and waits for the next flush
+	Swap(QueuedBatches, FlushingBatches);
+
+	for (FQueuedMessageBatch& Batch : FlushingBatches)
+	{
+		if (Batch.NumMessages > 0)
+		{
+			DispatchMessages(Batch.Channel, Batch.StructType, Batch.Data, Batch.NumMessages, Batch.Target);
+
+			Batch.StructType->DestroyStruct(Batch.Data, Batch.NumMessages);
+			Batch.NumMessages = 0;
+		}
+	}
+}
+
+void UGameplayMessageSubsystem::SetQueueFlushTickGroup(ETickingGroup InTickGroup)
+{
+	QueueFlushTickGroup = InTickGroup;
+	QueueFlushTickFunction.TickGroup = InTickGroup;
+	QueueFlushTickFunction.EndTickGroup = InTickGroup;
+}
+
+bool UGameplayMessageSubsystem::RegisterQueueFlushTickFunction()
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	ULevel* Level = World ? World->PersistentLevel.Get() : nullptr;
+	if (Level == nullptr)
+	{
+		return false;
+	}
+
+	if (QueueFlushTickFunction.IsTickFunctionRegistered() && (QueueFlushTickLevel.Get() == Level))
+	{
+		return true;
+	}
+
+	if (QueueFlushTickFunction.IsTickFunctionRegistered())
+	{
+		QueueFlushTickFunction.UnRegisterTickFunction();
+	}
+
+	QueueFlushTickFunction.Target = this;
+	QueueFlushTickFunction.bCanEverTick = true;
+	QueueFlushTickFunction.bTickEvenWhenPaused = true;
+	QueueFlushTickFunction.bAllowTickOnDedicatedServer = true;
+	QueueFlushTickFunction.TickGroup = QueueFlushTickGroup;
+	QueueFlushTickFunction.EndTickGroup = QueueFlushTickGroup;
+	QueueFlushTickFunction.RegisterTickFunction(Level);
+	QueueFlushTickLevel = Level;
+
+	return true;
+}
+
+const UGameplayMessageSubsystem::FResolvedChannel& UGameplayMessageSubsystem::ResolveChannel(FGameplayTag Channel)
+{
+	FResolvedChannel& Resolved = ResolvedChannelMap.FindOrAdd(Channel);
+	if (Resolved.Generation != ListenerGeneration)
+	{
+		Resolved.Listeners.Reset();
+		Resolved.Generation = ListenerGeneration;
+		Resolved.bHasBatchListeners = false;
+
+		bool bOnInitialTag = true;
+		for (FGameplayTag Tag = Channel; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+		{
+			if (FChannelListenerList* pList = ListenerMap.Find(Tag))
+			{
+				for (FGameplayMessageListenerData& Listener : pList->Listeners)
+				{
+					if (bOnInitialTag || (Listener.MatchType == EGameplayMessageMatch::PartialMatch))
 					{
-						UE_LOG(LogGameplayMessageSubsystem, Error, TEXT("Struct type mismatch on channel %s (broadcast type %s, listener at %s was expecting type %s)"),
-							*Channel.ToString(),
-							*StructType->GetPathName(),
-							*Tag.ToString(),
-							*Listener.ListenerStructType->GetPathName());
+						Resolved.Listeners.Add({ &Listener, Tag });
+						Resolved.bHasBatchListeners |= static_cast<bool>(Listener.BatchReceivedCallback);
 					}
 				}
 			}
+			bOnInitialTag = false;
+		}
+	}
+
+	return Resolved;
+}
+
+void UGameplayMessageSubsystem::FlushDeferredListenerChanges()
+{
+	check(BroadcastDepth == 0);
+
+	bool bSlotsChanged = false;
+
+	if (DeferredListeners.Num() > 0)
+	{
+		for (TPair<FGameplayTag, FGameplayMessageListenerData>& Deferred : DeferredListeners)
+		{
+			ListenerMap.FindOrAdd(Deferred.Key).Listeners.Add(MoveTemp(Deferred.Value));
+		}
+		DeferredListeners.Reset();
+		bSlotsChanged = true;
+	}
+
+	if (bHasPendingRemovals)
+	{
+		for (auto It = ListenerMap.CreateIterator(); It; ++It)
+		{
+			It.Value().Listeners.RemoveAllSwap([](const FGameplayMessageListenerData& Listener) { return Listener.bPendingRemoval; });
+			if (It.Value().Listeners.Num() == 0)
+			{
+				It.RemoveCurrent();
+			}
 		}
-		bOnInitialTag = false;
+		bHasPendingRemovals = false;
+		bSlotsChanged = true;
+	}
+
+	if (bSlotsChanged)
+	{
+		++ListenerGeneration;
 	}
 }
 
@@ -148,16 +448,36 @@ FGameplayMessageListenerHandle UGameplayMessageSubsystem::RegisterListenerIntern
 {
 	FChannelListenerList& List = ListenerMap.FindOrAdd(Channel);
 
-	FGameplayMessageListenerData& Entry = List.Listeners.AddDefaulted_GetRef();
+	// Appending to the channel list could reallocate slots that an in-flight broadcast is still walking
+	const bool bDefer = BroadcastDepth > 0;
+	FGameplayMessageListenerData& Entry = bDefer ? DeferredListeners.Emplace_GetRef(Channel, FGameplayMessageListenerData()).Value : List.Listeners.AddDefaulted_GetRef();
 	Entry.ReceivedCallback = MoveTemp(Callback);
 	Entry.ListenerStructType = StructType;
 	Entry.bHadValidType = StructType != nullptr;
 	Entry.HandleID = ++List.HandleID;
 	Entry.MatchType = MatchType;
 
+	if (!bDefer)
+	{
+		++ListenerGeneration;
+	}
+
 	return FGameplayMessageListenerHandle(this, Channel, Entry.HandleID);
 }
 
+FGameplayMessageListenerHandle UGameplayMessageSubsystem::RegisterBatchListenerInternal(FGameplayTag Channel, TFunction<void(FGameplayTag, const UScriptStruct*, const void*, int32)>&& Callback, const UScriptStruct* StructType, EGameplayMessageMatch MatchType, EGameplayMessageBatchMode BatchMode)
+{
+	FGameplayMessageListenerHandle Handle = RegisterListenerInternal(Channel, nullptr, StructType, MatchType);
+
+	// The entry we just added is either the last deferred listener or the last listener on the channel
+	FGameplayMessageListenerData& Entry = (BroadcastDepth > 0) ? DeferredListeners.Last().Value : ListenerMap.FindChecked(Channel).Listeners.Last();
+	check(Entry.HandleID == Handle.ID);
+	Entry.BatchReceivedCallback = MoveTemp(Callback);
+	Entry.BatchMode = BatchMode;
+
+	return Handle;
+}
+
 void UGameplayMessageSubsystem::UnregisterListener(FGameplayMessageListenerHandle Handle)
 {
 	if (Handle.IsValid())
@@ -174,12 +494,37 @@ void UGameplayMessageSubsystem::UnregisterListener(FGameplayMessageListenerHandl
 
 void UGameplayMessageSubsystem::UnregisterListenerInternal(FGameplayTag Channel, int32 HandleID)
 {
+	// Listeners that were registered during a broadcast have not made it into a channel list yet
+	const int32 DeferredIndex = DeferredListeners.IndexOfByPredicate([Channel, ID = HandleID](const TPair<FGameplayTag, FGameplayMessageListenerData>& Other) { return (Other.Key == Channel) && (Other.Value.HandleID == ID); });
+	if (DeferredIndex != INDEX_NONE)
+	{
+		DeferredListeners.RemoveAtSwap(DeferredIndex);
+
+		// Registering created the channel list to hand out the ID, don't leave it behind empty. It has to stay while
+		// other deferred listeners on the channel still need their IDs to be unique.
+		const FChannelListenerList* pList = ListenerMap.Find(Channel);
+		if ((pList != nullptr) && (pList->Listeners.Num() == 0) && !DeferredListeners.ContainsByPredicate([Channel](const TPair<FGameplayTag, FGameplayMessageListenerData>& Other) { return Other.Key == Channel; }))
+		{
+			ListenerMap.Remove(Channel);
+		}
+		return;
+	}
+
 	if (FChannelListenerList* pList = ListenerMap.Find(Channel))
 	{
 		int32 MatchIndex = pList->Listeners.IndexOfByPredicate([ID = HandleID](const FGameplayMessageListenerData& Other) { return Other.HandleID == ID; });
 		if (MatchIndex != INDEX_NONE)
 		{
+			if (BroadcastDepth > 0)
+			{
+				// Flag the slot rather than removing it, it will be compacted once the outermost broadcast returns
+				pList->Listeners[MatchIndex].bPendingRemoval = true;
+				bHasPendingRemovals = true;
+				return;
+			}
+
 			pList->Listeners.RemoveAtSwap(MatchIndex);
+			++ListenerGeneration;
 		}
 
 		if (pList->Listeners.Num() == 0)
@@ -188,4 +533,3 @@ void UGameplayMessageSubsystem::UnregisterListenerInternal(FGameplayTag Channel,
 		}
 	}
 }
-
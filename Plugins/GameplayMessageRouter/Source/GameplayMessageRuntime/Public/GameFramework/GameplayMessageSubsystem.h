@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Engine/EngineBaseTypes.h"
 #include "GameplayMessageTypes2.h"
 #include "GameplayTagContainer.h"
 #include "Subsystems/GameInstanceSubsystem.h"
@@ -12,6 +13,7 @@
 #define UE_API GAMEPLAYMESSAGERUNTIME_API
 
 class UGameplayMessageSubsystem;
+class ULevel;
 struct FFrame;
 
 GAMEPLAYMESSAGERUNTIME_API DECLARE_LOG_CATEGORY_EXTERN(LogGameplayMessageSubsystem, Log, All);
@@ -62,12 +64,45 @@ struct FGameplayMessageListenerData
 	// Callback for when a message has been received
 	TFunction<void(FGameplayTag, const UScriptStruct*, const void*)> ReceivedCallback;
 
+	// Callback for when a contiguous batch of messages has been received, used instead of ReceivedCallback when bound
+	TFunction<void(FGameplayTag, const UScriptStruct*, const void*, int32)> BatchReceivedCallback;
+
 	int32 HandleID;
 	EGameplayMessageMatch MatchType;
+	EGameplayMessageBatchMode BatchMode = EGameplayMessageBatchMode::AllMessages;
 
 	// Adding some logging and extra variables around some potential problems with this
 	TWeakObjectPtr<const UScriptStruct> ListenerStructType = nullptr;
 	bool bHadValidType = false;
+
+	// Set when the listener was unregistered while a broadcast was in flight, the slot is compacted once the outermost broadcast returns
+	bool bPendingRemoval = false;
+};
+
+/**
+ * Tick function that flushes messages queued on the gameplay message subsystem
+ */
+USTRUCT()
+struct FGameplayMessageQueueTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UGameplayMessageSubsystem* Target = nullptr;
+
+	//~FTickFunction interface
+	UE_API virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	UE_API virtual FString DiagnosticMessage() override;
+	UE_API virtual FName DiagnosticContext(bool bDetailed) override;
+	//~End of FTickFunction interface
+};
+
+template<>
+struct TStructOpsTypeTraits<FGameplayMessageQueueTickFunction> : public TStructOpsTypeTraitsBase2<FGameplayMessageQueueTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
 };
 
 /**
@@ -83,6 +118,19 @@ struct FGameplayMessageListenerData
  *
  * Note that call order when there are multiple listeners for the same channel is
  * not guaranteed and can change over time!
+ *
+ * Listeners registered while a broadcast is in flight will start receiving messages
+ * once the outermost broadcast returns, and listeners removed while a broadcast is in
+ * flight stop receiving messages immediately.
+ *
+ * Listeners added with RegisterBatchListener opt into batched delivery: messages broadcast
+ * on their channel are copied into a per-channel buffer and delivered to them once per frame
+ * as one batch, when the world reaches the queue flush tick group. Other listeners still
+ * receive those broadcasts immediately.
+ *
+ * Messages can also be queued with QueueMessage, in which case every listener receives them
+ * at the next flush. Regular listeners receive them one at a time, while batch listeners
+ * receive every message queued on the channel as one batch.
  */
 UCLASS(MinimalAPI)
 class UGameplayMessageSubsystem : public UGameInstanceSubsystem
@@ -107,6 +155,9 @@ public:
 	UE_API virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
+	// Reports the properties of queued messages so any objects they reference survive until they are flushed
+	static UE_API void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
 	/**
 	 * Broadcast a message on the specified channel
 	 *
@@ -120,6 +171,30 @@ public:
 		BroadcastMessageInternal(Channel, StructType, &Message);
 	}
 
+	/**
+	 * Queue a message on the specified channel, it will be delivered to listeners when the queue is next flushed
+	 *
+	 * @param Channel			The message channel to broadcast on
+	 * @param Message			The message to send, it is copied so it does not need to outlive this call (must be the same type of UScriptStruct expected by the listeners for this channel, otherwise an error will be logged)
+	 */
+	template <typename FMessageStructType>
+	void QueueMessage(FGameplayTag Channel, const FMessageStructType& Message)
+	{
+		const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
+		QueueMessageInternal(Channel, StructType, &Message);
+	}
+
+	/**
+	 * Delivers every queued message now rather than waiting for the queue flush tick
+	 * Messages queued by listeners while flushing will be delivered by the next flush
+	 */
+	UE_API void FlushQueuedMessages();
+
+	/**
+	 * Sets the tick group in which queued messages are delivered, defaults to TG_PostUpdateWork
+	 */
+	UE_API void SetQueueFlushTickGroup(ETickingGroup InTickGroup);
+
 	/**
 	 * Register to receive messages on a specified channel
 	 *
@@ -193,6 +268,55 @@ public:
 		return Handle;
 	}
 
+	/**
+	 * Register to receive messages on a specified channel as contiguous batches
+	 * Messages broadcast or queued on the channel are held for this listener and delivered once per flush as a single batch
+	 *
+	 * @param Channel			The message channel to listen to
+	 * @param Callback			Function to call with the messages when they are delivered (must be the same type of UScriptStruct provided by broadcasters for this channel, otherwise an error will be logged)
+	 * @param BatchMode			Whether to receive every queued message or only the most recent one on each channel
+	 * @param MatchType			Whether Callback should be called for messages on more derived channels or only for exact matches
+	 *
+	 * @return a handle that can be used to unregister this listener (either by calling Unregister() on the handle or calling UnregisterListener on the router)
+	 */
+	template <typename FMessageStructType>
+	FGameplayMessageListenerHandle RegisterBatchListener(FGameplayTag Channel, TFunction<void(FGameplayTag, TConstArrayView<FMessageStructType>)>&& Callback, EGameplayMessageBatchMode BatchMode = EGameplayMessageBatchMode::AllMessages, EGameplayMessageMatch MatchType = EGameplayMessageMatch::ExactMatch)
+	{
+		auto ThunkCallback = [InnerCallback = MoveTemp(Callback)](FGameplayTag ActualTag, const UScriptStruct* SenderStructType, const void* SenderPayload, int32 NumMessages)
+		{
+			InnerCallback(ActualTag, TConstArrayView<FMessageStructType>(reinterpret_cast<const FMessageStructType*>(SenderPayload), NumMessages));
+		};
+
+		const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
+		return RegisterBatchListenerInternal(Channel, ThunkCallback, StructType, MatchType, BatchMode);
+	}
+
+	/**
+	 * Register to receive messages on a specified channel as contiguous batches and handle them with a specified member function
+	 * Executes a weak object validity check to ensure the object registering the function still exists before triggering the callback
+	 *
+	 * @param Channel			The message channel to listen to
+	 * @param Object			The object instance to call the function on
+	 * @param Function			Member function to call with the messages when they are delivered
+	 * @param BatchMode			Whether to receive every queued message or only the most recent one on each channel
+	 *
+	 * @return a handle that can be used to unregister this listener (either by calling Unregister() on the handle or calling UnregisterListener on the router)
+	 */
+	template <typename FMessageStructType, typename TOwner = UObject>
+	FGameplayMessageListenerHandle RegisterBatchListener(FGameplayTag Channel, TOwner* Object, void(TOwner::* Function)(FGameplayTag, TConstArrayView<FMessageStructType>), EGameplayMessageBatchMode BatchMode = EGameplayMessageBatchMode::AllMessages)
+	{
+		TWeakObjectPtr<TOwner> WeakObject(Object);
+		return RegisterBatchListener<FMessageStructType>(Channel,
+			[WeakObject, Function](FGameplayTag Channel, TConstArrayView<FMessageStructType> Payloads)
+			{
+				if (TOwner* StrongObject = WeakObject.Get())
+				{
+					(StrongObject->*Function)(Channel, Payloads);
+				}
+			},
+			BatchMode);
+	}
+
 	/**
 	 * Remove a message listener previously registered by RegisterListener
 	 *
@@ -216,6 +340,31 @@ private:
 	// Internal helper for broadcasting a message
 	UE_API void BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes);
 
+	// Internal helper for queueing a message until the next flush
+	UE_API void QueueMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes);
+
+	// Which of the listeners resolved for a channel a dispatch is delivered to
+	enum class EDispatchTarget : uint8
+	{
+		// Queued messages, or broadcasts that could not be held for batch listeners
+		AllListeners,
+
+		// Broadcasts that are being held for the batch listeners until the next flush
+		ImmediateListeners,
+
+		// Broadcasts that were held for the batch listeners, delivered by the flush
+		BatchListeners
+	};
+
+	// Delivers a contiguous array of messages of the same type to the listeners resolved for the channel
+	void DispatchMessages(FGameplayTag Channel, const UScriptStruct* StructType, const uint8* MessageBytes, int32 NumMessages, EDispatchTarget Target);
+
+	// Copies a message into the queue for the next flush, returns false if there is no world to flush it in
+	bool EnqueueMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, EDispatchTarget Target);
+
+	// Registers the queue flush tick function with the current world if needed, returns false if there is no world to tick in
+	bool RegisterQueueFlushTickFunction();
+
 	// Internal helper for registering a message listener
 	UE_API FGameplayMessageListenerHandle RegisterListenerInternal(
 		FGameplayTag Channel, 
@@ -223,8 +372,19 @@ private:
 		const UScriptStruct* StructType,
 		EGameplayMessageMatch MatchType);
 
+	// Internal helper for registering a batch message listener
+	UE_API FGameplayMessageListenerHandle RegisterBatchListenerInternal(
+		FGameplayTag Channel,
+		TFunction<void(FGameplayTag, const UScriptStruct*, const void*, int32)>&& Callback,
+		const UScriptStruct* StructType,
+		EGameplayMessageMatch MatchType,
+		EGameplayMessageBatchMode BatchMode);
+
 	UE_API void UnregisterListenerInternal(FGameplayTag Channel, int32 HandleID);
 
+	// Applies registrations and removals that were deferred while a broadcast was in flight
+	void FlushDeferredListenerChanges();
+
 private:
 	// List of all entries for a given channel
 	struct FChannelListenerList
@@ -233,8 +393,104 @@ private:
 		int32 HandleID = 0;
 	};
 
+	// A listener that will receive broadcasts on a given channel, either directly or through a PartialMatch on a parent channel
+	struct FResolvedListener
+	{
+		FGameplayMessageListenerData* Listener = nullptr;
+		FGameplayTag ListenerChannel;
+	};
+
+	// Every listener that should receive broadcasts on a given channel, rebuilt lazily when ListenerGeneration changes
+	struct FResolvedChannel
+	{
+		TArray<FResolvedListener> Listeners;
+		uint32 Generation = 0;
+		bool bHasBatchListeners = false;
+	};
+
+	// Messages of a single type queued on a channel, stored back to back so they can be delivered as one batch
+	struct FQueuedMessageBatch
+	{
+		FQueuedMessageBatch() = default;
+		UE_NONCOPYABLE(FQueuedMessageBatch);
+
+		// Queued messages must have been destroyed already, this only releases the buffer
+		~FQueuedMessageBatch()
+		{
+			FMemory::Free(Data);
+		}
+
+		// Returns room for one more message at the end of the batch, the buffer is allocated with the alignment of StructType
+		uint8* AddUninitializedMessage()
+		{
+			const int32 Stride = StructType->GetStructureSize();
+			const uint32 Alignment = FMath::Max<uint32>(StructType->GetMinAlignment(), 1);
+			if (Alignment > DataAlignment)
+			{
+				// Only an empty batch can be reused for another struct type, so there is nothing to keep
+				check(NumMessages == 0);
+				FMemory::Free(Data);
+				Data = nullptr;
+				MaxBytes = 0;
+				DataAlignment = Alignment;
+			}
+
+			const int32 Offset = NumMessages * Stride;
+			if (Offset + Stride > MaxBytes)
+			{
+				// Script structs are bitwise relocatable, so the buffer is free to move underneath previously queued messages
+				MaxBytes = FMath::Max(Offset + Stride, MaxBytes * 2);
+				Data = static_cast<uint8*>(FMemory::Realloc(Data, MaxBytes, DataAlignment));
+			}
+
+			++NumMessages;
+			return Data + Offset;
+		}
+
+		FGameplayTag Channel;
+		const UScriptStruct* StructType = nullptr;
+		EDispatchTarget Target = EDispatchTarget::AllListeners;
+		uint8* Data = nullptr;
+		int32 MaxBytes = 0;
+		uint32 DataAlignment = 0;
+		int32 NumMessages = 0;
+	};
+
+	// Returns the up to date resolved listener set for a channel, rebuilding it if the listener slots changed since it was last used
+	const FResolvedChannel& ResolveChannel(FGameplayTag Channel);
+
 private:
 	TMap<FGameplayTag, FChannelListenerList> ListenerMap;
+
+	// Cache of resolved listener sets, keyed by broadcast channel
+	TMap<FGameplayTag, FResolvedChannel> ResolvedChannelMap;
+
+	// Registrations made while a broadcast was in flight, added to ListenerMap once the outermost broadcast returns
+	TArray<TPair<FGameplayTag, FGameplayMessageListenerData>> DeferredListeners;
+
+	// Bumped whenever listener slots are added or compacted, invalidating every resolved channel
+	uint32 ListenerGeneration = 1;
+
+	// Number of broadcasts currently on the stack, listener slots may not move while this is non-zero
+	int32 BroadcastDepth = 0;
+
+	// True if any slot was flagged with bPendingRemoval during a broadcast
+	bool bHasPendingRemovals = false;
+
+	// Batches being filled by QueueMessage, entries are kept once empty so their buffers are reused in later frames
+	TArray<FQueuedMessageBatch> QueuedBatches;
+
+	// Batches being delivered by FlushQueuedMessages, swapped with QueuedBatches at the start of each flush
+	TArray<FQueuedMessageBatch> FlushingBatches;
+
+	FGameplayMessageQueueTickFunction QueueFlushTickFunction;
+
+	// Level the flush tick function was registered with, it is re-registered when the game instance moves to a new world
+	TWeakObjectPtr<ULevel> QueueFlushTickLevel;
+
+	TEnumAsByte<ETickingGroup> QueueFlushTickGroup = TG_PostUpdateWork;
+
+	bool bIsFlushingQueuedMessages = false;
 };
 
 #undef UE_API
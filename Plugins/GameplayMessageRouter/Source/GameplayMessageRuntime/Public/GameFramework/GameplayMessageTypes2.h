@@ -22,6 +22,17 @@ enum class EGameplayMessageMatch : uint8
 	PartialMatch
 };
 
+// How a batch listener wants to receive the messages queued on its channel since the last flush
+UENUM(BlueprintType)
+enum class EGameplayMessageBatchMode : uint8
+{
+	// Every queued message is delivered in a single contiguous batch, in the order they were queued
+	AllMessages,
+
+	// Queued messages are coalesced per channel, and only the most recent one is delivered
+	LatestOnly
+};
+
 /**
  * Struct used to specify advanced behavior when registering a listener for gameplay messages
  */
@@ -0,0 +1,8 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#include "Data/NinjaCombatProjectilePoolData.h"
+
+FPrimaryAssetId UNinjaCombatProjectilePoolData::GetPrimaryAssetId() const
+{
+	static const FPrimaryAssetType BaseAssetType = TEXT("CombatProjectilePool");
+	return FPrimaryAssetId(BaseAssetType, GetFName());
+}
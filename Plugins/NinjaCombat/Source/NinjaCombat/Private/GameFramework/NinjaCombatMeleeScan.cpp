@@ -2,6 +2,9 @@
 #include "GameFramework/NinjaCombatMeleeScan.h"
 
 #include "NinjaCombatSettings.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Engine/SkinnedAsset.h"
 
 DEFINE_LOG_CATEGORY(LogNinjaCombatMeleeScan);
 
@@ -46,81 +49,129 @@ UNinjaCombatMeleeScan* UNinjaCombatMeleeScan::NewInstance(const TSubclassOf<UNin
 		default: ;
 	}
 	
+	MeleeScan->ResolveSockets();
+	MeleeScan->ResolveSubStepChains();
+	MeleeScan->InitializeTraceParams();
 	MeleeScan->SnapshotSocketPositions();
 	return MeleeScan;
 }
 
 void UNinjaCombatMeleeScan::ScanForTargets_Implementation(TArray<FHitResult>& OutHits)
 {
-	if (IsValid(ScanOwner))
+	if (IsValid(ScanOwner) && IsValid(ScanMesh))
 	{
 		UWorld* World = ScanOwner->GetWorld();
 		if (IsValid(this) && IsValid(World))
 		{
-			FCollisionQueryParams TraceParams = FCollisionQueryParams(SCENE_QUERY_STAT(GetCombatTargets));
-			TraceParams.TraceTag = TEXT("MeleeScanTrace");
-			TraceParams.bReturnPhysicalMaterial = true;
-			TraceParams.bTraceComplex = true;
-	
-			TArray<AActor*> IgnoredActors = GetIgnoredActors();
-			for (const AActor* AttachedActor : IgnoredActors)
+			QUICK_SCOPE_CYCLE_COUNTER(STAT_UNinjaCombatMeleeScan_ScanForTargets);
+			
+			// Read the whole pose once, the line trace mode needs the next socket as well.
+			ScratchSocketTransforms.Reset(ScanSockets.Num());
+			for (const FNinjaCombatMeleeScanSocket& Socket : ScanSockets)
 			{
-				TraceParams.AddIgnoredActor(AttachedActor);
+				ScratchSocketTransforms.Add(Socket.bExists ? GetSocketTransform(Socket) : FTransform::Identity);
 			}
-	
-			for (int32 SocketIdx = 0; SocketIdx < SocketNames.Num(); ++SocketIdx)
+
+			// Sample enough intermediate poses to cover the time since the last scan at a fixed interval.
+			const bool bSubStep = CanSubStep();
+			const double CurrentTime = World->GetTimeSeconds();
+			FTransform PoseMeshTransform = FTransform::Identity;
+			int32 NumSteps = 1;
+			
+			if (bSubStep)
 			{
-				const FName SocketName = SocketNames[SocketIdx];
-		
-				const FVector LastSocketPosition = *LastSocketPositions.Find(SocketName);
-				const FVector SocketPosition = ScanMesh->GetSocketLocation(SocketName);
-				const FQuat SocketRotation = ScanMesh->GetSocketQuaternion(SocketName);
-				LastSocketPositions[SocketName] = SocketPosition;
-		
-				TArray<FHitResult> HitResults;
+				const UNinjaCombatSettings* Settings = GetDefault<UNinjaCombatSettings>();
+				const double ElapsedTime = CurrentTime - LastScanTime;
+				NumSteps = FMath::Clamp(FMath::CeilToInt32(ElapsedTime / FMath::Max(Settings->MeleeScanSubStepInterval, UE_KINDA_SMALL_NUMBER)), 1, FMath::Max(Settings->MeleeScanMaxSubSteps, 1));
+				PoseMeshTransform = PoseMesh->GetComponentTransform();
+				CaptureChainTransforms(CurrentChainTransforms);
+			}
 
-				if (ScanMode == EMeleeScanMode::LineTrace)
-				{
-					const int32 NextIdx = SocketIdx + 1;
-					if (SocketNames.IsValidIndex(NextIdx))
-					{
-						const FVector OtherSocketPosition = ScanMesh->GetSocketLocation(SocketNames[NextIdx]);
-						World->LineTraceMultiByChannel(HitResults, SocketPosition, OtherSocketPosition, ScanChannel, TraceParams);
-						DrawScanLine(LastSocketPosition, OtherSocketPosition);
-					}
-				
-					World->LineTraceMultiByChannel(HitResults, LastSocketPosition, SocketPosition, ScanChannel, TraceParams);
-					DrawScanLine(LastSocketPosition, SocketPosition);
-				}
-				else
+			LastScanTime = CurrentTime;
+
+			// Build every query first, so all of them run back to back in a single pass.
+			ScratchQueries.Reset();
+			for (int32 SocketIdx = 0; SocketIdx < ScanSockets.Num(); ++SocketIdx)
+			{
+				const FNinjaCombatMeleeScanSocket& Socket = ScanSockets[SocketIdx];
+				if (!Socket.bExists)
 				{
-					World->SweepMultiByChannel(HitResults, LastSocketPosition, SocketPosition, SocketRotation, ScanChannel, ScanShape, TraceParams);
-					DrawScanSweep(SocketPosition, SocketRotation);
+					continue;
 				}
+
+				const int32 NextIdx = SocketIdx + 1;
+				const bool bHasNextSocket = ScanMode == EMeleeScanMode::LineTrace && ScanSockets.IsValidIndex(NextIdx) && ScanSockets[NextIdx].bExists;
+				const int32 SocketSteps = Socket.ChainNum > 0 ? NumSteps : 1;
 				
-				FHitResult NewHit(ForceInit);
-				for (int32 HitIdx = 0; HitIdx < HitResults.Num(); ++HitIdx)
+				FVector StepStart = LastSocketPositions[SocketIdx];
+				for (int32 Step = 1; Step <= SocketSteps; ++Step)
 				{
-					NewHit = HitResults[HitIdx];
-			
-					const bool bAlreadyFoundInThisScan = OutHits.ContainsByPredicate([NewHit](const FHitResult& Hit)
-						{ return NewHit.GetActor() == Hit.GetActor(); });
+					const bool bFinalStep = Step == SocketSteps;
+					const float Alpha = static_cast<float>(Step) / SocketSteps;
+					const FTransform StepTransform = bFinalStep ? ScratchSocketTransforms[SocketIdx]
+						: GetSubStepSocketTransform(Socket, PoseMeshTransform, Alpha);
 
-					const bool bEverFound = ConsolidatedHits.ContainsByPredicate([NewHit](const FHitResult& Hit)
-						{ return NewHit.GetActor() == Hit.GetActor(); });
-			
-					if (!bAlreadyFoundInThisScan && !bEverFound)
+					if (ScanMode == EMeleeScanMode::LineTrace)
 					{
-						OutHits.Add(NewHit);
-						ConsolidatedHits.Add(NewHit);
-						DrawNewTarget(NewHit);
+						// The line between two sockets represents the blade, at the final step or any step the next socket can be rebuilt for.
+						if (bHasNextSocket && (bFinalStep || ScanSockets[NextIdx].ChainNum > 0))
+						{
+							const FTransform NextTransform = bFinalStep ? ScratchSocketTransforms[NextIdx]
+								: GetSubStepSocketTransform(ScanSockets[NextIdx], PoseMeshTransform, Alpha);
+							
+							ScratchQueries.Add({ StepTransform.GetLocation(), NextTransform.GetLocation(), FQuat::Identity });
+						}
 					}
+
+					ScratchQueries.Add({ StepStart, StepTransform.GetLocation(), StepTransform.GetRotation() });
+					StepStart = StepTransform.GetLocation();
+				}
+
+				LastSocketPositions[SocketIdx] = StepStart;
+			}
+
+			for (const FNinjaCombatMeleeScanQuery& Query : ScratchQueries)
+			{
+				if (ScanMode == EMeleeScanMode::LineTrace)
+				{
+					World->LineTraceMultiByChannel(ScratchHitResults, Query.Start, Query.End, ScanChannel, TraceParams);
+					DrawScanLine(Query.Start, Query.End);
 				}
+				else
+				{
+					World->SweepMultiByChannel(ScratchHitResults, Query.Start, Query.End, Query.Rotation, ScanChannel, ScanShape, TraceParams);
+					DrawScanSweep(Query.End, Query.Rotation);
+				}
+
+				ConsolidateHits(ScratchHitResults, OutHits);
+			}
+
+			if (bSubStep)
+			{
+				Swap(LastChainTransforms, CurrentChainTransforms);
+				LastPoseMeshTransform = PoseMeshTransform;
 			}
 		}
 	}
 }
 
+void UNinjaCombatMeleeScan::ConsolidateHits(const TArray<FHitResult>& NewHits, TArray<FHitResult>& OutHits)
+{
+	for (const FHitResult& NewHit : NewHits)
+	{
+		// Anything in the output for this scan is also in the consolidated hits, so one lookup covers both.
+		bool bAlreadyFound = false;
+		HitActors.Add(NewHit.GetActor(), &bAlreadyFound);
+		
+		if (!bAlreadyFound)
+		{
+			OutHits.Add(NewHit);
+			ConsolidatedHits.Add(NewHit);
+			DrawNewTarget(NewHit);
+		}
+	}
+}
+
 TArray<AActor*> UNinjaCombatMeleeScan::GetIgnoredActors_Implementation() const
 {
 	TArray<AActor*> IgnoredActors;
@@ -134,16 +185,221 @@ TArray<AActor*> UNinjaCombatMeleeScan::GetIgnoredActors_Implementation() const
 	return IgnoredActors;
 }
 
-void UNinjaCombatMeleeScan::SnapshotSocketPositions()
+void UNinjaCombatMeleeScan::InitializeTraceParams()
+{
+	TraceParams = FCollisionQueryParams(SCENE_QUERY_STAT(GetCombatTargets));
+	TraceParams.TraceTag = TEXT("MeleeScanTrace");
+	TraceParams.bReturnPhysicalMaterial = true;
+	TraceParams.bTraceComplex = true;
+	
+	const TArray<AActor*> IgnoredActors = GetIgnoredActors();
+	for (const AActor* AttachedActor : IgnoredActors)
+	{
+		TraceParams.AddIgnoredActor(AttachedActor);
+	}
+}
+
+void UNinjaCombatMeleeScan::ResolveSockets()
 {
+	ScanSockets.Reset(SocketNames.Num());
+	
+	// Skeletal meshes following a leader pose don't own their bone transforms, so those go through the regular socket lookup.
+	const USkeletalMeshComponent* SkeletalMesh = Cast<USkeletalMeshComponent>(ScanMesh);
+	if (IsValid(SkeletalMesh) && SkeletalMesh->LeaderPoseComponent.IsValid())
+	{
+		SkeletalMesh = nullptr;
+	}
+	
 	for (const FName& SocketName : SocketNames)
 	{
-		if (ScanMesh->DoesSocketExist(SocketName))
+		FNinjaCombatMeleeScanSocket& Socket = ScanSockets.AddDefaulted_GetRef();
+		Socket.SocketName = SocketName;
+		Socket.bExists = IsValid(ScanMesh) && ScanMesh->DoesSocketExist(SocketName);
+
+		if (Socket.bExists && IsValid(SkeletalMesh))
 		{
-			const FVector Location = ScanMesh->GetSocketLocation(SocketName);
-			LastSocketPositions.Add(SocketName, Location);
+			if (const USkeletalMeshSocket* MeshSocket = SkeletalMesh->GetSocketByName(SocketName))
+			{
+				Socket.BoneIndex = SkeletalMesh->GetBoneIndex(MeshSocket->BoneName);
+				Socket.LocalTransform = MeshSocket->GetSocketLocalTransform();
+			}
+			else
+			{
+				// Not a socket, so it must be a bone.
+				Socket.BoneIndex = SkeletalMesh->GetBoneIndex(SocketName);
+			}
 		}
 	}
+
+	LastSocketPositions.SetNumZeroed(ScanSockets.Num());
+}
+
+FTransform UNinjaCombatMeleeScan::GetSocketTransform(const FNinjaCombatMeleeScanSocket& Socket) const
+{
+	if (Socket.BoneIndex != INDEX_NONE)
+	{
+		// Bone indices are only resolved for skeletal meshes.
+		const USkeletalMeshComponent* SkeletalMesh = CastChecked<USkeletalMeshComponent>(ScanMesh);
+		return Socket.LocalTransform * SkeletalMesh->GetBoneTransform(Socket.BoneIndex);
+	}
+
+	return ScanMesh->GetSocketTransform(Socket.SocketName);
+}
+
+void UNinjaCombatMeleeScan::ResolveSubStepChains()
+{
+	PoseMesh.Reset();
+	ChainBoneIndices.Reset();
+
+	if (!GetDefault<UNinjaCombatSettings>()->bEnableMeleeScanSubStepping || !IsValid(ScanMesh))
+	{
+		return;
+	}
+
+	// Sockets are either driven by the scan mesh itself (i.e. a punch), or by the bone the scan mesh is attached to (i.e. a weapon in a hand).
+	USkeletalMeshComponent* SkeletalMesh = Cast<USkeletalMeshComponent>(ScanMesh);
+	int32 AttachBoneIndex = INDEX_NONE;
+	
+	if (!IsValid(SkeletalMesh) || SkeletalMesh->LeaderPoseComponent.IsValid())
+	{
+		SkeletalMesh = nullptr;
+		
+		const USceneComponent* AttachedComponent = ScanMesh;
+		while (IsValid(AttachedComponent) && !IsValid(SkeletalMesh))
+		{
+			SkeletalMesh = Cast<USkeletalMeshComponent>(AttachedComponent->GetAttachParent());
+			if (!IsValid(SkeletalMesh))
+			{
+				AttachedComponent = AttachedComponent->GetAttachParent();
+			}
+		}
+
+		if (!IsValid(SkeletalMesh))
+		{
+			return;
+		}
+
+		const FName AttachSocketName = AttachedComponent->GetAttachSocketName();
+		const USkeletalMeshSocket* AttachSocket = SkeletalMesh->GetSocketByName(AttachSocketName);
+		AttachBoneIndex = SkeletalMesh->GetBoneIndex(AttachSocket ? AttachSocket->BoneName : AttachSocketName);
+		
+		if (AttachBoneIndex == INDEX_NONE)
+		{
+			return;
+		}
+	}
+
+	if (SkeletalMesh->LeaderPoseComponent.IsValid() || !IsValid(SkeletalMesh->GetSkinnedAsset()))
+	{
+		return;
+	}
+
+	const FReferenceSkeleton& RefSkeleton = SkeletalMesh->GetSkinnedAsset()->GetRefSkeleton();
+	for (FNinjaCombatMeleeScanSocket& Socket : ScanSockets)
+	{
+		Socket.ChainStart = ChainBoneIndices.Num();
+		Socket.ChainNum = 0;
+		
+		if (!Socket.bExists)
+		{
+			continue;
+		}
+
+		int32 BoneIndex = Socket.BoneIndex;
+		Socket.PoseBoneToSocket = Socket.LocalTransform;
+		
+		if (AttachBoneIndex != INDEX_NONE)
+		{
+			// The scan mesh is rigidly attached for the duration of the swing.
+			BoneIndex = AttachBoneIndex;
+			Socket.PoseBoneToSocket = ScanMesh->GetSocketTransform(Socket.SocketName).GetRelativeTransform(SkeletalMesh->GetBoneTransform(AttachBoneIndex));
+		}
+
+		for (; BoneIndex != INDEX_NONE; BoneIndex = RefSkeleton.GetParentIndex(BoneIndex))
+		{
+			ChainBoneIndices.Add(BoneIndex);
+		}
+		
+		Socket.ChainNum = ChainBoneIndices.Num() - Socket.ChainStart;
+	}
+
+	if (!ChainBoneIndices.IsEmpty())
+	{
+		PoseMesh = SkeletalMesh;
+	}
+}
+
+bool UNinjaCombatMeleeScan::CanSubStep() const
+{
+	return PoseMesh.IsValid() && !ChainBoneIndices.IsEmpty() && GetDefault<UNinjaCombatSettings>()->bEnableMeleeScanSubStepping;
+}
+
+void UNinjaCombatMeleeScan::CaptureChainTransforms(TArray<FTransform>& OutChainTransforms) const
+{
+	const USkeletalMeshComponent* SkeletalMesh = PoseMesh.Get();
+	const TArray<FTransform>& ComponentSpaceTransforms = SkeletalMesh->GetComponentSpaceTransforms();
+	const FReferenceSkeleton& RefSkeleton = SkeletalMesh->GetSkinnedAsset()->GetRefSkeleton();
+
+	OutChainTransforms.SetNumUninitialized(ChainBoneIndices.Num(), EAllowShrinking::No);
+	for (int32 ChainIdx = 0; ChainIdx < ChainBoneIndices.Num(); ++ChainIdx)
+	{
+		const int32 BoneIndex = ChainBoneIndices[ChainIdx];
+		if (!ComponentSpaceTransforms.IsValidIndex(BoneIndex))
+		{
+			OutChainTransforms[ChainIdx] = FTransform::Identity;
+			continue;
+		}
+		
+		const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+		OutChainTransforms[ChainIdx] = ParentIndex == INDEX_NONE ? ComponentSpaceTransforms[BoneIndex]
+			: ComponentSpaceTransforms[BoneIndex].GetRelativeTransform(ComponentSpaceTransforms[ParentIndex]);
+	}
+}
+
+FTransform UNinjaCombatMeleeScan::GetSubStepSocketTransform(const FNinjaCombatMeleeScanSocket& Socket,
+	const FTransform& PoseMeshTransform, const float Alpha) const
+{
+	// Compose from the root down to the driving bone.
+	FTransform ComponentSpaceTransform = FTransform::Identity;
+	for (int32 ChainIdx = Socket.ChainStart + Socket.ChainNum - 1; ChainIdx >= Socket.ChainStart; --ChainIdx)
+	{
+		FTransform BoneTransform;
+		BoneTransform.Blend(LastChainTransforms[ChainIdx], CurrentChainTransforms[ChainIdx], Alpha);
+		ComponentSpaceTransform = BoneTransform * ComponentSpaceTransform;
+	}
+
+	FTransform MeshTransform;
+	MeshTransform.Blend(LastPoseMeshTransform, PoseMeshTransform, Alpha);
+	
+	return Socket.PoseBoneToSocket * ComponentSpaceTransform * MeshTransform;
+}
+
+void UNinjaCombatMeleeScan::SnapshotSocketPositions()
+{
+	if (ScanSockets.Num() != SocketNames.Num())
+	{
+		ResolveSockets();
+		ResolveSubStepChains();
+	}
+	
+	for (int32 SocketIdx = 0; SocketIdx < ScanSockets.Num(); ++SocketIdx)
+	{
+		if (ScanSockets[SocketIdx].bExists)
+		{
+			LastSocketPositions[SocketIdx] = GetSocketTransform(ScanSockets[SocketIdx]).GetLocation();
+		}
+	}
+
+	if (CanSubStep())
+	{
+		LastPoseMeshTransform = PoseMesh->GetComponentTransform();
+		CaptureChainTransforms(LastChainTransforms);
+	}
+
+	if (IsValid(ScanOwner) && IsValid(ScanOwner->GetWorld()))
+	{
+		LastScanTime = ScanOwner->GetWorld()->GetTimeSeconds();
+	}
 }
 
 AActor* UNinjaCombatMeleeScan::GetInstigator() const
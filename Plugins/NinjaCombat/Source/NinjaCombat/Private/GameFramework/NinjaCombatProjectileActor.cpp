@@ -8,10 +8,12 @@
 #include "NinjaCombatSettings.h"
 #include "Components/SphereComponent.h"
 #include "Engine/AssetManager.h"
+#include "GameFramework/NinjaCombatProjectilePoolSubsystem.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Net/UnrealNetwork.h"
 #include "Sound/SoundBase.h"
 #include "TargetingSystem/TargetingPreset.h"
 #include "TargetingSystem/TargetingSubsystem.h"
@@ -30,6 +32,8 @@ ANinjaCombatProjectileActor::ANinjaCombatProjectileActor(const FObjectInitialize
 	ImpactStrength = 1000000.f;
 	TraceChannel = GetDefault<UNinjaCombatSettings>()->ProjectileChannel;
 	TargetingPreset = nullptr;
+	bPooled = false;
+	bProjectileActive = true;
 	SetReplicatingMovement(true);
 	
 	SphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("SphereComponent"));
@@ -56,14 +60,15 @@ void ANinjaCombatProjectileActor::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (IsValid(SphereComponent))
-	{
-		SphereComponent->MoveIgnoreActors.Add(GetInstigator());
-		GetInstigator()->MoveIgnoreActorAdd(this);
+	RegisterInstigatorIgnores();
 
-		TArray<AActor*> AttachedActors;
-		GetInstigator()->GetAttachedActors(AttachedActors);
-		SphereComponent->MoveIgnoreActors.Append(AttachedActors);
+	// Clients never acquire projectiles, so their pools only keep the cosmetics of replicated ones loaded.
+	if (GetNetMode() == NM_Client)
+	{
+		if (UNinjaCombatProjectilePoolSubsystem* ProjectilePool = UNinjaCombatProjectilePoolSubsystem::Get(GetWorld()))
+		{
+			ProjectilePool->HandleReplicatedProjectileBeginPlay(this);
+		}
 	}
 	
 	if (IsValid(ProjectileMovement))
@@ -74,6 +79,40 @@ void ANinjaCombatProjectileActor::BeginPlay()
 	}
 }
 
+void ANinjaCombatProjectileActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ThisClass, bProjectileActive);
+}
+
+void ANinjaCombatProjectileActor::RegisterInstigatorIgnores()
+{
+	APawn* ProjectileInstigator = GetInstigator();
+	if (IsValid(SphereComponent) && IsValid(ProjectileInstigator))
+	{
+		SphereComponent->MoveIgnoreActors.Add(ProjectileInstigator);
+		ProjectileInstigator->MoveIgnoreActorAdd(this);
+
+		TArray<AActor*> AttachedActors;
+		ProjectileInstigator->GetAttachedActors(AttachedActors);
+		SphereComponent->MoveIgnoreActors.Append(AttachedActors);
+	}
+}
+
+void ANinjaCombatProjectileActor::UnregisterInstigatorIgnores()
+{
+	APawn* ProjectileInstigator = GetInstigator();
+	if (IsValid(ProjectileInstigator))
+	{
+		ProjectileInstigator->MoveIgnoreActorRemove(this);
+	}
+
+	if (IsValid(SphereComponent))
+	{
+		SphereComponent->ClearMoveIgnoreActors();
+	}
+}
+
 void ANinjaCombatProjectileActor::Launch_Implementation()
 {
 	if (bUsesTargetingSystem && TargetingPreset)
@@ -115,10 +154,21 @@ void ANinjaCombatProjectileActor::ExecuteTargeting()
 	SourceContext.SourceLocation = GetActorLocation();
 	SourceContext.InstigatorActor = GetInstigator();
 
+	// A bounce can retarget before the previous request finished, only the latest one should steer the projectile.
+	CancelTargeting();
+
 	const FTargetingRequestHandle TargetingHandle = UTargetingSubsystem::MakeTargetRequestHandle(TargetingPreset, SourceContext);
+	PendingTargetingHandle = TargetingHandle;
 	
 	const FTargetingRequestDelegate Delegate = FTargetingRequestDelegate::CreateWeakLambda(this, [this](const FTargetingRequestHandle& Handle)
-		{ HandleTargetReceived(Handle); });
+		{
+			// Pooled projectiles are reset and launched again, so late results may belong to a previous launch.
+			if (Handle == PendingTargetingHandle)
+			{
+				PendingTargetingHandle.Reset();
+				HandleTargetReceived(Handle);
+			}
+		});
 
 	if (bExecuteAsync)
 	{
@@ -134,6 +184,19 @@ void ANinjaCombatProjectileActor::ExecuteTargeting()
 	}	
 }
 
+void ANinjaCombatProjectileActor::CancelTargeting()
+{
+	if (PendingTargetingHandle.IsValid())
+	{
+		if (UTargetingSubsystem* TargetingSubsystem = UTargetingSubsystem::Get(GetWorld()))
+		{
+			TargetingSubsystem->RemoveAsyncTargetingRequestWithHandle(PendingTargetingHandle);
+		}
+
+		PendingTargetingHandle.Reset();
+	}
+}
+
 void ANinjaCombatProjectileActor::HandleTargetReceived(const FTargetingRequestHandle& TargetingHandle)
 {
 	TArray<AActor*> TargetedActors;
@@ -283,7 +346,104 @@ void ANinjaCombatProjectileActor::AdjustHitResult_Implementation(const FHitResul
 void ANinjaCombatProjectileActor::HandleProjectileExhausted_Implementation()
 {
 	ProjectileMovement->StopMovementImmediately();
-	Destroy();
+
+	UNinjaCombatProjectilePoolSubsystem* ProjectilePool = UNinjaCombatProjectilePoolSubsystem::Get(GetWorld());
+	if (!IsValid(ProjectilePool) || !ProjectilePool->ReleaseProjectile(this))
+	{
+		Destroy();
+	}
+}
+
+void ANinjaCombatProjectileActor::ResetProjectile_Implementation()
+{
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	UnregisterInstigatorIgnores();
+	CancelTargeting();
+
+	bHasExhausted = false;
+	TargetIndex = 0;
+	BounceCount = 0;
+	LastBounceVelocity = FVector::ZeroVector;
+	ImpactEffectHandle = FGameplayEffectSpecHandle();
+	CurrentTarget = nullptr;
+	ActorsHit.Reset();
+}
+
+void ANinjaCombatProjectileActor::ReactivateProjectile_Implementation()
+{
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(PrimaryActorTick.bStartWithTickEnabled);
+	RegisterInstigatorIgnores();
+
+	// The movement component releases its updated component when it stops, so restore it
+	// along with the initial velocity, in the same way the component does when it initializes.
+	const UProjectileMovementComponent* DefaultMovement = GetClass()->GetDefaultObject<ThisClass>()->GetProjectileMovement();
+	ProjectileMovement->SetUpdatedComponent(GetRootComponent());
+	ProjectileMovement->Velocity = DefaultMovement->Velocity;
+	
+	if (ProjectileMovement->Velocity.SizeSquared() > 0.f)
+	{
+		if (ProjectileMovement->InitialSpeed > 0.f)
+		{
+			ProjectileMovement->Velocity = ProjectileMovement->Velocity.GetSafeNormal() * ProjectileMovement->InitialSpeed;
+		}
+
+		if (ProjectileMovement->bInitialVelocityInLocalSpace)
+		{
+			ProjectileMovement->SetVelocityInLocalSpace(ProjectileMovement->Velocity);
+		}
+
+		ProjectileMovement->UpdateComponentVelocity();
+	}
+	
+	ProjectileMovement->Activate(true);
+}
+
+void ANinjaCombatProjectileActor::DeactivatePooledProjectile(const bool bPlayCosmetics)
+{
+	if (bPlayCosmetics && !UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
+	{
+		Execute_HandleDestructionCosmetics(this);
+	}
+
+	bProjectileActive = false;
+	ResetProjectile();
+
+	// Nothing changes while the projectile is pooled, so it can stop replicating until the next launch.
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void ANinjaCombatProjectileActor::ActivatePooledProjectile()
+{
+	SetNetDormancy(DORM_Awake);
+
+	bProjectileActive = true;
+	ReactivateProjectile();
+
+	ForceNetUpdate();
+}
+
+void ANinjaCombatProjectileActor::OnRep_ProjectileActive()
+{
+	if (bProjectileActive)
+	{
+		ReactivateProjectile();
+		return;
+	}
+
+	// Projectiles replicated for the first time while pooled were never visible.
+	if (HasActorBegunPlay() && !UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
+	{
+		Execute_HandleDestructionCosmetics(this);
+	}
+
+	ResetProjectile();
 }
 
 void ANinjaCombatProjectileActor::HandleImpactCosmetics_Implementation(const FHitResult& HitResult) const
@@ -312,10 +472,12 @@ void ANinjaCombatProjectileActor::HandleImpactCosmetics_Implementation(const FHi
 		}
 		else
 		{
-			UAssetManager::GetStreamableManager().RequestAsyncLoad(EffectPaths, [this, ImpactLocation, ImpactRotation]()
+			// The projectile may be pooled or destroyed by the time the assets are loaded.
+			UAssetManager::GetStreamableManager().RequestAsyncLoad(EffectPaths,
+				[WeakWorld = MakeWeakObjectPtr(GetWorld()), System = ImpactFX, Sound = ImpactSound, ImpactLocation, ImpactRotation]()
 			{
-				PlayNiagaraSystem(GetWorld(), ImpactFX.Get(), ImpactLocation, ImpactRotation);
-				PlaySound(GetWorld(), ImpactSound.Get(), ImpactLocation, ImpactRotation);
+				PlayNiagaraSystem(WeakWorld.Get(), System.Get(), ImpactLocation, ImpactRotation);
+				PlaySound(WeakWorld.Get(), Sound.Get(), ImpactLocation, ImpactRotation);
 			});
 		}
 	}
@@ -325,13 +487,22 @@ void ANinjaCombatProjectileActor::EndPlay(const EEndPlayReason::Type EndPlayReas
 {
 	// If this projectile was destroyed in the world, then play the destruction cosmetics.
 	// Destroyed in the world: Too many Bounces, lower speed than allowed.
+	// Projectiles waiting in the pool already played them when they were exhausted.
 	//
-	if (!UKismetSystemLibrary::IsDedicatedServer(GetWorld()) && EndPlayReason == EEndPlayReason::Destroyed)
+	if (!UKismetSystemLibrary::IsDedicatedServer(GetWorld()) && EndPlayReason == EEndPlayReason::Destroyed && bProjectileActive)
 	{
 		Execute_HandleDestructionCosmetics(this);	
 	}
 
-	GetInstigator()->MoveIgnoreActorRemove(this);
+	if (bPooled)
+	{
+		if (UNinjaCombatProjectilePoolSubsystem* ProjectilePool = UNinjaCombatProjectilePoolSubsystem::Get(GetWorld()))
+		{
+			ProjectilePool->HandlePooledProjectileEndPlay(this);
+		}
+	}
+
+	UnregisterInstigatorIgnores();
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -344,14 +515,37 @@ void ANinjaCombatProjectileActor::HandleDestructionCosmetics_Implementation() co
 		EffectPaths.Emplace(DestructionFX.ToSoftObjectPath());
 	}
 
+	const FVector DestructionLocation = GetActorLocation();
+	const FRotator DestructionRotation = GetActorRotation();
+
 	if (EffectPaths.IsEmpty())
 	{
-		PlayNiagaraSystem(GetWorld(), DestructionFX.Get(), GetActorLocation(), GetActorRotation());
+		PlayNiagaraSystem(GetWorld(), DestructionFX.Get(), DestructionLocation, DestructionRotation);
 	}
 	else
 	{
-		UAssetManager::GetStreamableManager().RequestAsyncLoad(EffectPaths, [this]()
-			{ PlayNiagaraSystem(GetWorld(), DestructionFX.Get(), GetActorLocation(), GetActorRotation()); });
+		// The projectile may be pooled and launched again, or destroyed, by the time the asset is loaded.
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(EffectPaths,
+			[WeakWorld = MakeWeakObjectPtr(GetWorld()), System = DestructionFX, DestructionLocation, DestructionRotation]()
+			{ PlayNiagaraSystem(WeakWorld.Get(), System.Get(), DestructionLocation, DestructionRotation); });
+	}
+}
+
+void ANinjaCombatProjectileActor::GetCosmeticAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (!ImpactFX.IsNull())
+	{
+		OutPaths.AddUnique(ImpactFX.ToSoftObjectPath());
+	}
+
+	if (!DestructionFX.IsNull())
+	{
+		OutPaths.AddUnique(DestructionFX.ToSoftObjectPath());
+	}
+
+	if (!ImpactSound.IsNull())
+	{
+		OutPaths.AddUnique(ImpactSound.ToSoftObjectPath());
 	}
 }
 
@@ -0,0 +1,284 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#include "GameFramework/NinjaCombatProjectilePoolSubsystem.h"
+
+#include "NinjaCombatSettings.h"
+#include "Data/NinjaCombatProjectilePoolData.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "GameFramework/NinjaCombatProjectileActor.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+DEFINE_LOG_CATEGORY(LogNinjaCombatProjectilePool);
+
+static FAutoConsoleCommandWithWorld DumpProjectilePoolsCommand(
+	TEXT("NinjaCombat.ProjectilePool.Dump"),
+	TEXT("Logs the hit, miss and high-water statistics of every projectile pool in the world."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+	{
+		if (const UNinjaCombatProjectilePoolSubsystem* ProjectilePool = UNinjaCombatProjectilePoolSubsystem::Get(World))
+		{
+			ProjectilePool->DumpPoolStats();
+		}
+	}));
+
+UNinjaCombatProjectilePoolSubsystem* UNinjaCombatProjectilePoolSubsystem::Get(const UWorld* World)
+{
+	return IsValid(World) ? World->GetSubsystem<UNinjaCombatProjectilePoolSubsystem>() : nullptr;
+}
+
+bool UNinjaCombatProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UNinjaCombatProjectilePoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Replicated projectiles are spawned by the server, so clients have nothing to prewarm.
+	const UNinjaCombatSettings* Settings = GetDefault<UNinjaCombatSettings>();
+	if (IsPoolingEnabled() && !Settings->ProjectilePoolData.IsNull() && InWorld.GetNetMode() != NM_Client)
+	{
+		PrewarmPools(Settings->ProjectilePoolData.LoadSynchronous());
+	}
+}
+
+void UNinjaCombatProjectilePoolSubsystem::Deinitialize()
+{
+	// Pooled actors are owned by the world and go away with it.
+	Pools.Empty();
+	Super::Deinitialize();
+}
+
+bool UNinjaCombatProjectilePoolSubsystem::CanPoolClass(const UClass* ProjectileClass)
+{
+	return IsValid(ProjectileClass)
+		&& ProjectileClass->IsChildOf(ANinjaCombatProjectileActor::StaticClass())
+		&& !ProjectileClass->HasAnyClassFlags(CLASS_Abstract);
+}
+
+bool UNinjaCombatProjectilePoolSubsystem::IsPoolingEnabled()
+{
+	return GetDefault<UNinjaCombatSettings>()->bEnableProjectilePooling;
+}
+
+void UNinjaCombatProjectilePoolSubsystem::PrewarmPools(const UNinjaCombatProjectilePoolData* PoolData)
+{
+	if (IsValid(PoolData))
+	{
+		for (const FNinjaCombatProjectilePoolEntry& Entry : PoolData->Projectiles)
+		{
+			PrewarmPool(Entry.ProjectileClass, Entry.PrewarmCount, Entry.MaxPoolSize);
+		}
+	}
+}
+
+void UNinjaCombatProjectilePoolSubsystem::PrewarmPool(const TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass, const int32 Count, const int32 MaxPoolSize)
+{
+	if (!IsPoolingEnabled() || !CanPoolClass(ProjectileClass))
+	{
+		return;
+	}
+
+	FNinjaCombatProjectilePool& Pool = FindOrAddPool(ProjectileClass);
+	Pool.MaxPoolSize = FMath::Max(MaxPoolSize, 0);
+
+	const int32 TargetCount = Pool.MaxPoolSize > 0 ? FMath::Min(Count, Pool.MaxPoolSize) : Count;
+	const int32 SpawnCount = TargetCount - Pool.Available.Num();
+	Pool.Available.Reserve(TargetCount);
+
+	for (int32 Idx = 0; Idx < SpawnCount; ++Idx)
+	{
+		ANinjaCombatProjectileActor* Projectile = SpawnPooledProjectile(ProjectileClass, FTransform::Identity, nullptr, nullptr);
+		if (IsValid(Projectile))
+		{
+			Projectile->FinishSpawning(FTransform::Identity);
+			Projectile->DeactivatePooledProjectile(false);
+			Pool.Available.Add(Projectile);
+		}
+	}
+
+	UE_LOG(LogNinjaCombatProjectilePool, Verbose, TEXT("Prewarmed %d projectiles of class %s (%d available)."),
+		FMath::Max(SpawnCount, 0), *GetNameSafe(ProjectileClass), Pool.Available.Num());
+}
+
+AActor* UNinjaCombatProjectilePoolSubsystem::AcquireProjectile(const TSubclassOf<AActor> ProjectileClass, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	if (!IsPoolingEnabled() || !CanPoolClass(ProjectileClass))
+	{
+		return nullptr;
+	}
+
+	const TSubclassOf<ANinjaCombatProjectileActor> PoolClass = ProjectileClass.Get();
+	FNinjaCombatProjectilePool& Pool = FindOrAddPool(PoolClass);
+
+	ANinjaCombatProjectileActor* Projectile = nullptr;
+	while (!Pool.Available.IsEmpty() && !IsValid(Projectile))
+	{
+		Projectile = Pool.Available.Pop(EAllowShrinking::No);
+	}
+
+	if (IsValid(Projectile))
+	{
+		Pool.Stats.Hits++;
+		Projectile->SetOwner(Owner);
+		Projectile->SetInstigator(Instigator);
+		Projectile->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	}
+	else
+	{
+		Pool.Stats.Misses++;
+		Projectile = SpawnPooledProjectile(PoolClass, Transform, Owner, Instigator);
+		if (!IsValid(Projectile))
+		{
+			return nullptr;
+		}
+	}
+
+	Pool.Stats.NumActive++;
+	Pool.Stats.HighWater = FMath::Max(Pool.Stats.HighWater, Pool.Stats.NumActive);
+	return Projectile;
+}
+
+void UNinjaCombatProjectilePoolSubsystem::FinishAcquireProjectile(AActor* Projectile, const FTransform& Transform)
+{
+	ANinjaCombatProjectileActor* PooledProjectile = CastChecked<ANinjaCombatProjectileActor>(Projectile);
+	if (PooledProjectile->IsActorInitialized())
+	{
+		PooledProjectile->ActivatePooledProjectile();
+	}
+	else
+	{
+		PooledProjectile->FinishSpawning(Transform);
+	}
+}
+
+bool UNinjaCombatProjectilePoolSubsystem::ReleaseProjectile(ANinjaCombatProjectileActor* Projectile)
+{
+	if (!IsValid(Projectile) || !Projectile->bPooled)
+	{
+		return false;
+	}
+
+	if (!Projectile->bProjectileActive)
+	{
+		// Already waiting in the pool.
+		return true;
+	}
+
+	FNinjaCombatProjectilePool* Pool = Pools.Find(Projectile->GetClass());
+	if (Pool == nullptr)
+	{
+		return false;
+	}
+
+	Pool->Stats.NumActive = FMath::Max(Pool->Stats.NumActive - 1, 0);
+
+	if (!IsPoolingEnabled() || (Pool->MaxPoolSize > 0 && Pool->Available.Num() >= Pool->MaxPoolSize))
+	{
+		// The pool is full, so this one is destroyed like an unpooled projectile.
+		Projectile->bPooled = false;
+		return false;
+	}
+
+	Projectile->DeactivatePooledProjectile(true);
+	Pool->Available.Add(Projectile);
+	return true;
+}
+
+void UNinjaCombatProjectilePoolSubsystem::HandlePooledProjectileEndPlay(ANinjaCombatProjectileActor* Projectile)
+{
+	FNinjaCombatProjectilePool* Pool = Pools.Find(Projectile->GetClass());
+	if (Pool == nullptr)
+	{
+		return;
+	}
+
+	if (Projectile->bProjectileActive)
+	{
+		Pool->Stats.NumActive = FMath::Max(Pool->Stats.NumActive - 1, 0);
+	}
+	else
+	{
+		Pool->Available.RemoveSingleSwap(Projectile, EAllowShrinking::No);
+	}
+}
+
+void UNinjaCombatProjectilePoolSubsystem::HandleReplicatedProjectileBeginPlay(const ANinjaCombatProjectileActor* Projectile)
+{
+	// Pooled projectiles begin play once on clients, and are shown and hidden afterwards.
+	// Creating the pool keeps the cosmetics loaded, it never has projectiles available.
+	if (IsPoolingEnabled() && IsValid(Projectile) && CanPoolClass(Projectile->GetClass()))
+	{
+		FindOrAddPool(Projectile->GetClass());
+	}
+}
+
+FProjectilePoolStats UNinjaCombatProjectilePoolSubsystem::GetPoolStats(const TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass) const
+{
+	FProjectilePoolStats Stats;
+
+	if (const FNinjaCombatProjectilePool* Pool = Pools.Find(ProjectileClass))
+	{
+		Stats = Pool->Stats;
+		Stats.NumAvailable = Pool->Available.Num();
+	}
+
+	return Stats;
+}
+
+void UNinjaCombatProjectilePoolSubsystem::DumpPoolStats() const
+{
+	UE_LOG(LogNinjaCombatProjectilePool, Log, TEXT("Projectile pools in %s:"), *GetNameSafe(GetWorld()));
+
+	for (const TPair<TSubclassOf<ANinjaCombatProjectileActor>, FNinjaCombatProjectilePool>& Entry : Pools)
+	{
+		const FProjectilePoolStats Stats = GetPoolStats(Entry.Key);
+		const int32 Acquired = Stats.Hits + Stats.Misses;
+		const float HitRate = Acquired > 0 ? 100.f * Stats.Hits / Acquired : 0.f;
+
+		UE_LOG(LogNinjaCombatProjectilePool, Log, TEXT("  %s: %d hits, %d misses (%.1f%% hit rate), high-water %d, %d active, %d available."),
+			*GetNameSafe(Entry.Key), Stats.Hits, Stats.Misses, HitRate, Stats.HighWater, Stats.NumActive, Stats.NumAvailable);
+	}
+}
+
+FNinjaCombatProjectilePool& UNinjaCombatProjectilePoolSubsystem::FindOrAddPool(const TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass)
+{
+	if (FNinjaCombatProjectilePool* Pool = Pools.Find(ProjectileClass))
+	{
+		return *Pool;
+	}
+
+	FNinjaCombatProjectilePool& Pool = Pools.Add(ProjectileClass);
+
+	// Cosmetics are only played by clients and listen servers.
+	if (!UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
+	{
+		TArray<FSoftObjectPath> CosmeticPaths;
+		GetDefault<ANinjaCombatProjectileActor>(ProjectileClass)->GetCosmeticAssetPaths(CosmeticPaths);
+
+		if (!CosmeticPaths.IsEmpty())
+		{
+			Pool.CosmeticsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(CosmeticPaths);
+		}
+	}
+
+	return Pool;
+}
+
+ANinjaCombatProjectileActor* UNinjaCombatProjectilePoolSubsystem::SpawnPooledProjectile(const TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass,
+	const FTransform& Transform, AActor* Owner, APawn* Instigator) const
+{
+	UWorld* World = GetWorld();
+	check(IsValid(World));
+
+	ANinjaCombatProjectileActor* Projectile = World->SpawnActorDeferred<ANinjaCombatProjectileActor>(ProjectileClass, Transform,
+		Owner, Instigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+	if (IsValid(Projectile))
+	{
+		Projectile->bPooled = true;
+	}
+
+	return Projectile;
+}
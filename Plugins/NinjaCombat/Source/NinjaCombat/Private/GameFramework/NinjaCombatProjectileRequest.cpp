@@ -1,6 +1,7 @@
 ﻿// Ninja Bear Studio Inc., all rights reserved.
 #include "GameFramework/NinjaCombatProjectileRequest.h"
 
+#include "GameFramework/NinjaCombatProjectilePoolSubsystem.h"
 #include "Interfaces/CombatProjectileInterface.h"
 #include "Kismet/KismetMathLibrary.h"
 
@@ -76,11 +77,28 @@ AActor* UNinjaCombatProjectileRequest::SpawnProjectile() const
 	SpawnTransform.SetLocation(GetSourceLocation());
 	SpawnTransform.SetRotation(FQuat::MakeFromRotator(GetSourceRotation()));
 	
-	AActor* Projectile = World->SpawnActorDeferred<AActor>(ProjectileClass, SpawnTransform, RequestOwner, Instigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	// Pooled projectiles are acquired in the same deferred state as a new spawn.
+	UNinjaCombatProjectilePoolSubsystem* ProjectilePool = UNinjaCombatProjectilePoolSubsystem::Get(World);
+	AActor* Projectile = IsValid(ProjectilePool) ? ProjectilePool->AcquireProjectile(ProjectileClass, SpawnTransform, RequestOwner, Instigator) : nullptr;
+	const bool bFromPool = IsValid(Projectile);
+
+	if (!bFromPool)
+	{
+		Projectile = World->SpawnActorDeferred<AActor>(ProjectileClass, SpawnTransform, RequestOwner, Instigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	}
+	
 	if (IsValid(Projectile))
 	{
 		ModifyProjectile(Projectile);
-		Projectile->FinishSpawning(SpawnTransform);
+
+		if (bFromPool)
+		{
+			ProjectilePool->FinishAcquireProjectile(Projectile, SpawnTransform);
+		}
+		else
+		{
+			Projectile->FinishSpawning(SpawnTransform);
+		}
 	}
 
 	return Projectile;
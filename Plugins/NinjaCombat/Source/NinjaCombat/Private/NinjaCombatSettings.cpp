@@ -16,10 +16,14 @@ UNinjaCombatSettings::UNinjaCombatSettings()
 	MeleeScanChannel = ECC_Visibility;
 	MeleeScanClass = UNinjaCombatMeleeScan::StaticClass();
 	MeleeScanDebugDuration = 2.;
+	bEnableMeleeScanSubStepping = false;
+	MeleeScanSubStepInterval = 1.f / 60.f;
+	MeleeScanMaxSubSteps = 4;
 
 	ProjectileSocketName = TEXT("sProjectile");
 	ProjectileChannel = ECC_Visibility;
 	ProjectileRequestClass = UNinjaCombatProjectileRequest::StaticClass();
+	bEnableProjectilePooling = true;
 	
 	DamageRegistrySize = 10;
 }
@@ -0,0 +1,252 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "AbilitySystemGlobals.h"
+#include "GameplayEffect.h"
+#include "Math/RandomStream.h"
+#include "Tests/NinjaCombatTestDamageManagerComponent.h"
+#include "Tests/NinjaCombatTestWorld.h"
+#include "Types/FDamageList.h"
+#include "UObject/CoreNet.h"
+#include "UObject/UnrealType.h"
+
+namespace NinjaCombatDamageListTest
+{
+	// Sustained hit spam, replicated every few hits so several entries arrive together, but never more than the list can hold
+	static constexpr int32 NumHits = 5000;
+
+	// Checks that a list holds the newest entries, from the oldest to the newest, and that evicted entries are gone
+	FString CheckEntries(const FDamageList& List, const int32 NumRegistered)
+	{
+		const FDamageListView View = List.GetEntries();
+		const int32 ExpectedNum = FMath::Min(NumRegistered, List.GetCapacity());
+		if (View.Num() != ExpectedNum)
+		{
+			return FString::Printf(TEXT("%d entries, expected %d"), View.Num(), ExpectedNum);
+		}
+
+		int32 ExpectedSequence = NumRegistered - ExpectedNum;
+		for (const FDamageEntry& Entry : View)
+		{
+			if (Entry.Sequence != ExpectedSequence)
+			{
+				return FString::Printf(TEXT("entry %d found where entry %d was expected"), Entry.Sequence, ExpectedSequence);
+			}
+
+			if (List.FindEntry(ExpectedSequence) != &Entry)
+			{
+				return FString::Printf(TEXT("entry %d not found by its sequence"), ExpectedSequence);
+			}
+
+			++ExpectedSequence;
+		}
+
+		const int32 LastEvictedSequence = NumRegistered - ExpectedNum - 1;
+		if (LastEvictedSequence >= 0 && List.FindEntry(LastEvictedSequence) != nullptr)
+		{
+			return FString::Printf(TEXT("evicted entry %d is still found"), LastEvictedSequence);
+		}
+
+		return FString();
+	}
+
+	bool IsSequential(const TArray<int32>& Sequences, const int32 ExpectedNum)
+	{
+		if (Sequences.Num() != ExpectedNum)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Sequences.Num(); ++Index)
+		{
+			if (Sequences[Index] != Index)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Provides the items a fast array receives into, the replication system reaches them through the property
+	TArray<FDamageEntry>& GetReceivedItems(FDamageList& List)
+	{
+		const FArrayProperty* EntriesProperty = FindFProperty<FArrayProperty>(FDamageList::StaticStruct(), TEXT("Entries"));
+		check(EntriesProperty);
+		return *EntriesProperty->ContainerPtrToValuePtr<TArray<FDamageEntry>>(&List);
+	}
+
+	// Sends an entry through its net serializer, as the fast array does for each item it replicates
+	bool ReceiveEntry(const FDamageEntry& ServerEntry, FDamageEntry& ClientEntry)
+	{
+		FDamageEntry SentEntry = ServerEntry;
+		bool bWritten = false;
+		FNetBitWriter Writer(nullptr, 1024 * 8);
+		SentEntry.NetSerialize(Writer, nullptr, bWritten);
+
+		bool bRead = false;
+		FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+		ClientEntry.NetSerialize(Reader, nullptr, bRead);
+
+		// The replication ID is sent by the fast array itself, ahead of the item
+		ClientEntry.ReplicationID = ServerEntry.ReplicationID;
+		return bWritten && bRead && !Writer.IsError() && !Reader.IsError() && Reader.AtEnd();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDamageListRingBufferTest, "NinjaCombat.Damage.DamageList.RingBuffer", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FDamageListRingBufferTest::RunTest(const FString& Parameters)
+{
+	using namespace NinjaCombatDamageListTest;
+	using namespace NinjaCombatTestWorld;
+
+	UWorld* World = CreateHeadlessWorld(TEXT("NinjaCombatDamageListTest"));
+	AActor* Owner = World->SpawnActor<AActor>();
+	UNinjaCombatTestDamageManagerComponent* ServerManager = NewObject<UNinjaCombatTestDamageManagerComponent>(Owner);
+	UNinjaCombatTestDamageManagerComponent* ClientManager = NewObject<UNinjaCombatTestDamageManagerComponent>(Owner);
+
+	FDamageList ServerList(ServerManager);
+	FDamageList ClientList(ClientManager);
+	const int32 Capacity = ServerList.GetCapacity();
+
+	const FGameplayEffectContextHandle EffectContext(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+	const FGameplayEffectSpec EffectSpec(GetDefault<UGameplayEffect>(), EffectContext, 1.f);
+
+	// Mirrors the fast array serializer on a client: each item with a replication key that was not sent yet is serialized, items
+	// are matched by replication ID, new IDs are appended in the order they arrive and the others are received in place
+	TArray<FDamageEntry>& ClientItems = GetReceivedItems(ClientList);
+	TMap<int32, int32> SentReplicationKeys;
+
+	auto ReplicateToClient = [&ServerList, &ClientList, &ClientItems, &SentReplicationKeys, Capacity](const bool bOutOfSlotOrder, int32& OutNumRemoved)
+	{
+		TArray<const FDamageEntry*> Outgoing;
+		TSet<int32> ServerIDs;
+		for (const FDamageEntry& Entry : ServerList.GetEntries())
+		{
+			Outgoing.Add(&Entry);
+			ServerIDs.Add(Entry.ReplicationID);
+		}
+
+		// The server stores each entry in the slot given by its sequence, and the fast array sends them in that order
+		Outgoing.Sort([Capacity, bOutOfSlotOrder](const FDamageEntry& A, const FDamageEntry& B)
+		{
+			const int32 SlotA = A.Sequence % Capacity;
+			const int32 SlotB = B.Sequence % Capacity;
+			return bOutOfSlotOrder ? SlotA > SlotB : SlotA < SlotB;
+		});
+
+		OutNumRemoved = 0;
+		for (const FDamageEntry& ClientEntry : ClientItems)
+		{
+			OutNumRemoved += ServerIDs.Contains(ClientEntry.ReplicationID) ? 0 : 1;
+		}
+
+		bool bReceived = true;
+		TArray<int32> AddedIndices;
+		TArray<int32> ChangedIndices;
+		for (const FDamageEntry* ServerEntry : Outgoing)
+		{
+			const int32* SentReplicationKey = SentReplicationKeys.Find(ServerEntry->ReplicationID);
+			if (SentReplicationKey && *SentReplicationKey == ServerEntry->ReplicationKey)
+			{
+				continue;
+			}
+
+			int32 ClientIndex = ClientItems.IndexOfByPredicate([ServerEntry](const FDamageEntry& Entry) { return Entry.ReplicationID == ServerEntry->ReplicationID; });
+			if (ClientIndex == INDEX_NONE)
+			{
+				ClientIndex = ClientItems.AddDefaulted();
+				AddedIndices.Add(ClientIndex);
+			}
+			else
+			{
+				ChangedIndices.Add(ClientIndex);
+			}
+
+			bReceived &= ReceiveEntry(*ServerEntry, ClientItems[ClientIndex]);
+			SentReplicationKeys.Add(ServerEntry->ReplicationID, ServerEntry->ReplicationKey);
+		}
+
+		if (!AddedIndices.IsEmpty())
+		{
+			ClientList.PostReplicatedAdd(AddedIndices, ClientItems.Num());
+		}
+
+		if (!ChangedIndices.IsEmpty())
+		{
+			ClientList.PostReplicatedChange(ChangedIndices, ClientItems.Num());
+		}
+
+		ClientList.PostReplicatedReceive(FFastArraySerializer::FPostReplicatedReceiveParameters{});
+		return bReceived;
+	};
+
+	// The first update fills the client list, so it receives every entry out of slot order
+	FRandomStream Random(0xDA3A);
+	int32 HitsUntilReplication = Capacity;
+	int32 NumReplications = 0;
+
+	for (int32 HitIndex = 0; HitIndex < NumHits; ++HitIndex)
+	{
+		const int32 ArrayReplicationKey = ServerList.ArrayReplicationKey;
+		TMap<int32, int32> ReplicationKeys;
+		for (const FDamageEntry& Entry : ServerList.GetEntries())
+		{
+			ReplicationKeys.Add(Entry.ReplicationID, Entry.ReplicationKey);
+		}
+
+		ServerList.RegisterDamageTaken(EffectSpec);
+
+		// Eviction must only dirty the reused item, marking it dirty advances the array key once
+		int32 NumDirtyItems = 0;
+		for (const FDamageEntry& Entry : ServerList.GetEntries())
+		{
+			const int32* ReplicationKey = ReplicationKeys.Find(Entry.ReplicationID);
+			NumDirtyItems += (ReplicationKey == nullptr || *ReplicationKey != Entry.ReplicationKey) ? 1 : 0;
+		}
+
+		if (NumDirtyItems != 1 || ServerList.ArrayReplicationKey != ArrayReplicationKey + 1)
+		{
+			AddError(FString::Printf(TEXT("Hit %d dirtied %d items and advanced the array key by %d"), HitIndex, NumDirtyItems, ServerList.ArrayReplicationKey - ArrayReplicationKey));
+			break;
+		}
+
+		const FString ServerError = CheckEntries(ServerList, HitIndex + 1);
+		if (!ServerError.IsEmpty())
+		{
+			AddError(FString::Printf(TEXT("Server list after hit %d: %s"), HitIndex, *ServerError));
+			break;
+		}
+
+		if (--HitsUntilReplication == 0 || HitIndex == NumHits - 1)
+		{
+			// Every other update, starting with the first one, delivers the items in reverse slot order
+			const bool bOutOfSlotOrder = (NumReplications++ % 2) == 0;
+
+			int32 NumRemoved = 0;
+			const bool bReceived = ReplicateToClient(bOutOfSlotOrder, NumRemoved);
+			const FString ClientError = CheckEntries(ClientList, HitIndex + 1);
+
+			if (!bReceived || NumRemoved > 0 || !ClientError.IsEmpty())
+			{
+				AddError(FString::Printf(TEXT("Client list after hit %d (%s): %s, %d items removed, %s"), HitIndex, bOutOfSlotOrder ? TEXT("out of slot order") : TEXT("in slot order"),
+					bReceived ? TEXT("serialized") : TEXT("failed to serialize"), NumRemoved, ClientError.IsEmpty() ? TEXT("entries match") : *ClientError));
+				break;
+			}
+
+			HitsUntilReplication = Random.RandRange(1, Capacity);
+		}
+	}
+
+	TestTrue(TEXT("Every hit was handled once by the server, in order"), IsSequential(ServerManager->HandledSequences, NumHits));
+	TestTrue(TEXT("Every hit was handled once by the client replication callbacks, in order"), IsSequential(ClientManager->HandledSequences, NumHits));
+	TestEqual(TEXT("Stored entries"), ServerList.Num(), FMath::Min(NumHits, Capacity));
+
+	DestroyHeadlessWorld(World);
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,246 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "EngineUtils.h"
+#include "NinjaCombatSettings.h"
+#include "Data/NinjaCombatProjectilePoolData.h"
+#include "GameFramework/NinjaCombatProjectilePoolSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Interfaces/CombatProjectileInterface.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "TargetingSystem/TargetingPreset.h"
+#include "Tests/NinjaCombatTestProjectileActor.h"
+#include "Tests/NinjaCombatTestTargetingTask.h"
+#include "Tests/NinjaCombatTestWorld.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+namespace NinjaCombatProjectilePoolTest
+{
+	// Sustained barrage: 100 projectiles fired every frame at 60Hz (6000 per second) for 10 seconds, each flying for half a second
+	static constexpr int32 NumFrames = 600;
+	static constexpr int32 ProjectilesPerFrame = 100;
+	static constexpr int32 FramesInFlight = 30;
+	static constexpr int32 MaxInFlight = ProjectilesPerFrame * FramesInFlight;
+	static constexpr float DeltaSeconds = 1.f / 60.f;
+
+	// Fires the barrage, exhausting each projectile once its flight is over, and returns the time taken in seconds
+	template<typename SpawnFunctionType>
+	double RunBarrage(UWorld* World, SpawnFunctionType&& SpawnProjectile)
+	{
+		TArray<TArray<ANinjaCombatTestProjectileActor*>> InFlight;
+		InFlight.SetNum(FramesInFlight);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+		{
+			TArray<ANinjaCombatTestProjectileActor*>& Volley = InFlight[FrameIndex % FramesInFlight];
+			for (ANinjaCombatTestProjectileActor* Projectile : Volley)
+			{
+				Projectile->Exhaust();
+			}
+			Volley.Reset();
+
+			for (int32 ProjectileIndex = 0; ProjectileIndex < ProjectilesPerFrame; ++ProjectileIndex)
+			{
+				const FRotator Direction(0.f, 360.f * ProjectileIndex / ProjectilesPerFrame, 0.f);
+				ANinjaCombatTestProjectileActor* Projectile = SpawnProjectile(FTransform(Direction));
+				ICombatProjectileInterface::Execute_Launch(Projectile);
+				Volley.Add(Projectile);
+			}
+
+			World->Tick(LEVELTICK_All, DeltaSeconds);
+		}
+
+		for (TArray<ANinjaCombatTestProjectileActor*>& Volley : InFlight)
+		{
+			for (ANinjaCombatTestProjectileActor* Projectile : Volley)
+			{
+				Projectile->Exhaust();
+			}
+		}
+
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	// Creates a preset that always targets the same actor, the task set is only exposed to the editor
+	UTargetingPreset* MakeTargetingPreset(AActor* Target)
+	{
+		UTargetingPreset* Preset = NewObject<UTargetingPreset>(GetTransientPackage());
+
+		UNinjaCombatTestTargetingTask* Task = NewObject<UNinjaCombatTestTargetingTask>(Preset);
+		Task->Target = Target;
+
+		const FStructProperty* TaskSetProperty = FindFProperty<FStructProperty>(UTargetingPreset::StaticClass(), TEXT("TargetingTaskSet"));
+		check(TaskSetProperty && (TaskSetProperty->Struct == FTargetingTaskSet::StaticStruct()));
+		TaskSetProperty->ContainerPtrToValuePtr<FTargetingTaskSet>(Preset)->Tasks.Add(Task);
+
+		return Preset;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNinjaCombatProjectilePoolStressTest, "NinjaCombat.Projectiles.ProjectilePool.StressTest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::PerfFilter)
+
+bool FNinjaCombatProjectilePoolStressTest::RunTest(const FString& Parameters)
+{
+	using namespace NinjaCombatProjectilePoolTest;
+	using namespace NinjaCombatTestWorld;
+
+	if (!GetDefault<UNinjaCombatSettings>()->bEnableProjectilePooling)
+	{
+		AddWarning(TEXT("Projectile pooling is disabled in the Ninja Combat settings."));
+		return true;
+	}
+
+	const TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass = ANinjaCombatTestProjectileActor::StaticClass();
+	const int32 NumProjectiles = NumFrames * ProjectilesPerFrame;
+
+	// The previous lifecycle: a new actor for every shot, destroyed once exhausted
+	UWorld* SpawnWorld = CreateHeadlessWorld(TEXT("NinjaCombatProjectilePoolTest"));
+	APawn* SpawnInstigator = SpawnWorld->SpawnActor<APawn>();
+
+	const double SpawnSeconds = RunBarrage(SpawnWorld, [SpawnWorld, SpawnInstigator](const FTransform& Transform)
+	{
+		ANinjaCombatTestProjectileActor* Projectile = SpawnWorld->SpawnActorDeferred<ANinjaCombatTestProjectileActor>(ANinjaCombatTestProjectileActor::StaticClass(),
+			Transform, SpawnInstigator, SpawnInstigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		Projectile->FinishSpawning(Transform);
+		return Projectile;
+	});
+
+	DestroyHeadlessWorld(SpawnWorld);
+
+	// Pooled, prewarmed from a data asset for the most projectiles in flight at once
+	UWorld* PoolWorld = CreateHeadlessWorld(TEXT("NinjaCombatProjectilePoolTest"));
+	APawn* PoolInstigator = PoolWorld->SpawnActor<APawn>();
+	UNinjaCombatProjectilePoolSubsystem* ProjectilePool = UNinjaCombatProjectilePoolSubsystem::Get(PoolWorld);
+
+	if (!TestNotNull(TEXT("Projectile pool in a game world"), ProjectilePool))
+	{
+		DestroyHeadlessWorld(PoolWorld);
+		return false;
+	}
+
+	UNinjaCombatProjectilePoolData* PoolData = NewObject<UNinjaCombatProjectilePoolData>(GetTransientPackage());
+	FNinjaCombatProjectilePoolEntry& Entry = PoolData->Projectiles.AddDefaulted_GetRef();
+	Entry.ProjectileClass = ProjectileClass;
+	Entry.PrewarmCount = MaxInFlight;
+
+	const double PrewarmStartTime = FPlatformTime::Seconds();
+	ProjectilePool->PrewarmPools(PoolData);
+	const double PrewarmSeconds = FPlatformTime::Seconds() - PrewarmStartTime;
+
+	TestEqual(TEXT("Prewarmed projectiles"), ProjectilePool->GetPoolStats(ProjectileClass).NumAvailable, MaxInFlight);
+
+	const double PoolSeconds = RunBarrage(PoolWorld, [ProjectilePool, PoolInstigator](const FTransform& Transform)
+	{
+		AActor* Projectile = ProjectilePool->AcquireProjectile(ANinjaCombatTestProjectileActor::StaticClass(), Transform, PoolInstigator, PoolInstigator);
+		ProjectilePool->FinishAcquireProjectile(Projectile, Transform);
+		return CastChecked<ANinjaCombatTestProjectileActor>(Projectile);
+	});
+
+	const FProjectilePoolStats Stats = ProjectilePool->GetPoolStats(ProjectileClass);
+	TestEqual(TEXT("Pool hits"), Stats.Hits, NumProjectiles);
+	TestEqual(TEXT("Pool misses"), Stats.Misses, 0);
+	TestEqual(TEXT("Pool high-water"), Stats.HighWater, MaxInFlight);
+	TestEqual(TEXT("Active projectiles after the barrage"), Stats.NumActive, 0);
+	TestEqual(TEXT("Available projectiles after the barrage"), Stats.NumAvailable, MaxInFlight);
+
+	// Exhausted projectiles must come back clean
+	int32 NumDirtyProjectiles = 0;
+	for (TActorIterator<ANinjaCombatTestProjectileActor> It(PoolWorld); It; ++It)
+	{
+		if (It->IsProjectileActive() || !It->IsHidden() || It->GetActorEnableCollision() || It->GetBounceCount() != 0)
+		{
+			++NumDirtyProjectiles;
+		}
+	}
+	TestEqual(TEXT("Pooled projectiles that were not reset"), NumDirtyProjectiles, 0);
+
+	ProjectilePool->DumpPoolStats();
+	DestroyHeadlessWorld(PoolWorld);
+
+	AddInfo(FString::Printf(TEXT("Spawn/Destroy: %.3f ms for %d projectiles (%.1f us/projectile)"), SpawnSeconds * 1000.0, NumProjectiles, SpawnSeconds * 1.0e6 / NumProjectiles));
+	AddInfo(FString::Printf(TEXT("Pooled:        %.3f ms for %d projectiles (%.1f us/projectile), %.3f ms to prewarm %d"), PoolSeconds * 1000.0, NumProjectiles, PoolSeconds * 1.0e6 / NumProjectiles, PrewarmSeconds * 1000.0, MaxInFlight));
+
+	PoolData->MarkAsGarbage();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNinjaCombatProjectilePoolLateTargetingTest, "NinjaCombat.Projectiles.ProjectilePool.LateTargetingIgnored", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FNinjaCombatProjectilePoolLateTargetingTest::RunTest(const FString& Parameters)
+{
+	using namespace NinjaCombatProjectilePoolTest;
+	using namespace NinjaCombatTestWorld;
+
+	if (!GetDefault<UNinjaCombatSettings>()->bEnableProjectilePooling)
+	{
+		AddWarning(TEXT("Projectile pooling is disabled in the Ninja Combat settings."));
+		return true;
+	}
+
+	// The targeting subsystem lives in the game instance
+	UWorld* World = CreateGameInstanceWorld(TEXT("NinjaCombatProjectilePoolTest"));
+	UNinjaCombatProjectilePoolSubsystem* ProjectilePool = UNinjaCombatProjectilePoolSubsystem::Get(World);
+
+	if (!TestNotNull(TEXT("Projectile pool in a game world"), ProjectilePool))
+	{
+		DestroyGameInstanceWorld(World);
+		return false;
+	}
+
+	// The target is ahead on X, while projectiles are launched facing Y
+	const FVector TargetLocation(1000.f, 0.f, 0.f);
+	const FTransform LaunchTransform(FRotator(0.f, 90.f, 0.f));
+
+	AActor* Target = World->SpawnActor<AActor>();
+	USceneComponent* TargetRoot = NewObject<USceneComponent>(Target);
+	Target->SetRootComponent(TargetRoot);
+	TargetRoot->RegisterComponent();
+	Target->SetActorLocation(TargetLocation);
+
+	UTargetingPreset* Preset = MakeTargetingPreset(Target);
+
+	// Launch, then return to the pool before the asynchronous targeting had a chance to run
+	AActor* FirstAcquired = ProjectilePool->AcquireProjectile(ANinjaCombatTestProjectileActor::StaticClass(), LaunchTransform, nullptr, nullptr);
+	ANinjaCombatTestProjectileActor* Projectile = CastChecked<ANinjaCombatTestProjectileActor>(FirstAcquired);
+	Projectile->SetTargetingPreset(Preset);
+	ProjectilePool->FinishAcquireProjectile(Projectile, LaunchTransform);
+	ICombatProjectileInterface::Execute_Launch(Projectile);
+	Projectile->Exhaust();
+
+	for (int32 FrameIndex = 0; FrameIndex < 5; ++FrameIndex)
+	{
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+
+	TestFalse(TEXT("Pooled projectile is active"), Projectile->IsProjectileActive());
+	TestTrue(TEXT("Pooled projectile stays still after its targeting completes"), Projectile->GetProjectileMovement()->Velocity.IsNearlyZero());
+
+	// The pool hands the same projectile back, and only its new launch steers it.
+	// It moves a little along Y before the targeting runs, so the direction is compared loosely.
+	AActor* SecondAcquired = ProjectilePool->AcquireProjectile(ANinjaCombatTestProjectileActor::StaticClass(), LaunchTransform, nullptr, nullptr);
+	TestTrue(TEXT("Pool reused the projectile"), SecondAcquired == Projectile);
+	ProjectilePool->FinishAcquireProjectile(SecondAcquired, LaunchTransform);
+	ICombatProjectileInterface::Execute_Launch(Projectile);
+
+	for (int32 FrameIndex = 0; FrameIndex < 5; ++FrameIndex)
+	{
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+
+	const FVector LaunchDirection = Projectile->GetProjectileMovement()->Velocity.GetSafeNormal();
+	TestTrue(FString::Printf(TEXT("Relaunched projectile heads to its target (direction %s)"), *LaunchDirection.ToString()), FVector::DotProduct(LaunchDirection, FVector::XAxisVector) > 0.99f);
+
+	Projectile->Exhaust();
+	DestroyGameInstanceWorld(World);
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
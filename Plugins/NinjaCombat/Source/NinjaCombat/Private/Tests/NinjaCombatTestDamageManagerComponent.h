@@ -0,0 +1,26 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/NinjaCombatDamageManagerComponent.h"
+#include "NinjaCombatTestDamageManagerComponent.generated.h"
+
+/**
+ * Damage Manager used by automation tests, which only records the damage entries it handles.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UNinjaCombatTestDamageManagerComponent : public UNinjaCombatDamageManagerComponent
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/** Sequence of every damage entry handled by this component, in the order they were handled. */
+	TArray<int32> HandledSequences;
+
+	// -- Begin Damage Manager implementation
+	virtual void HandleDamageReceived_Implementation(const FDamageEntry& DamageEntry) override { HandledSequences.Add(DamageEntry.Sequence); }
+	// -- End Damage Manager implementation
+
+};
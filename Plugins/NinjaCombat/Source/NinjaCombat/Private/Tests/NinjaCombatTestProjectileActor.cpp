@@ -0,0 +1,18 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#include "Tests/NinjaCombatTestProjectileActor.h"
+
+#include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "TargetingSystem/TargetingPreset.h"
+
+ANinjaCombatTestProjectileActor::ANinjaCombatTestProjectileActor(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	GetCapsuleComponent()->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+}
+
+void ANinjaCombatTestProjectileActor::SetTargetingPreset(UTargetingPreset* Preset)
+{
+	bUsesTargetingSystem = IsValid(Preset);
+	bExecuteAsync = true;
+	TargetingPreset = Preset;
+}
@@ -0,0 +1,29 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/NinjaCombatProjectileActor.h"
+#include "NinjaCombatTestProjectileActor.generated.h"
+
+class UTargetingPreset;
+
+/**
+ * Concrete projectile used by automation tests, without collision so projectiles don't hit each other.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class ANinjaCombatTestProjectileActor : public ANinjaCombatProjectileActor
+{
+
+	GENERATED_BODY()
+
+public:
+
+	ANinjaCombatTestProjectileActor(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** Exhausts the projectile, as if it had reached its last target. */
+	void Exhaust() { HandleProjectileExhausted(); }
+
+	/** Makes the projectile launch towards targets collected asynchronously by a preset. */
+	void SetTargetingPreset(UTargetingPreset* Preset);
+
+};
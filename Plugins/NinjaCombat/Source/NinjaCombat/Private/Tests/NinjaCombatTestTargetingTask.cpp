@@ -0,0 +1,17 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#include "Tests/NinjaCombatTestTargetingTask.h"
+
+#include "Types/TargetingSystemTypes.h"
+
+void UNinjaCombatTestTargetingTask::Execute(const FTargetingRequestHandle& TargetingHandle) const
+{
+	Super::Execute(TargetingHandle);
+
+	if (IsValid(Target))
+	{
+		FTargetingDefaultResultData& Result = FTargetingDefaultResultsSet::FindOrAdd(TargetingHandle).TargetResults.AddDefaulted_GetRef();
+		Result.HitResult.HitObjectHandle = FActorInstanceHandle(Target);
+	}
+
+	SetTaskAsyncState(TargetingHandle, ETargetingTaskAsyncState::Completed);
+}
@@ -0,0 +1,27 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/TargetingTask.h"
+#include "NinjaCombatTestTargetingTask.generated.h"
+
+/**
+ * Targeting task used by automation tests, always reporting the same actor as the target.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UNinjaCombatTestTargetingTask : public UTargetingTask
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/** Actor reported as the only target. */
+	UPROPERTY()
+	TObjectPtr<AActor> Target;
+
+	// -- Begin Targeting Task implementation
+	virtual void Execute(const FTargetingRequestHandle& TargetingHandle) const override;
+	// -- End Targeting Task implementation
+
+};
@@ -0,0 +1,54 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+namespace NinjaCombatTestWorld
+{
+	/** Creates a game world without a viewport that has begun play, so actors can be spawned and ticked. */
+	inline UWorld* CreateHeadlessWorld(const TCHAR* WorldName)
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, WorldName);
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	/** Destroys a world created by CreateHeadlessWorld. */
+	inline void DestroyHeadlessWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	/** Creates a game world owned by a game instance, for tests that need game instance subsystems. */
+	inline UWorld* CreateGameInstanceWorld(const TCHAR* WorldName)
+	{
+		UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+		GameInstance->AddToRoot();
+		GameInstance->InitializeStandalone(WorldName);
+
+		UWorld* World = GameInstance->GetWorld();
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	/** Destroys a world created by CreateGameInstanceWorld, along with its game instance. */
+	inline void DestroyGameInstanceWorld(UWorld* World)
+	{
+		UGameInstance* GameInstance = World->GetGameInstance();
+		GameInstance->Shutdown();
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		GameInstance->RemoveFromRoot();
+	}
+}
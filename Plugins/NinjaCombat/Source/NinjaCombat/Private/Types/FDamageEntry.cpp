@@ -12,17 +12,12 @@ void FDamageEntry::Initialize(const float InTimestamp, const FGameplayEffectSpec
     EffectContext = InEffectSpec.GetContext();
     bHandled = false;
     
+    // Entries are reused by the damage list, so tags from a previous damage must not be kept.
     const FGameplayTagContainer* SourceContainer = InEffectSpec.CapturedSourceTags.GetAggregatedTags();
-    if (SourceContainer != nullptr)
-    {
-        CapturedSourceTags = *SourceContainer;
-    }
+    CapturedSourceTags = SourceContainer != nullptr ? *SourceContainer : FGameplayTagContainer::EmptyContainer;
 
     const FGameplayTagContainer* TargetContainer = InEffectSpec.CapturedTargetTags.GetAggregatedTags();
-    if (TargetContainer != nullptr)
-    {
-        CapturedTargetTags = *TargetContainer;
-    }
+    CapturedTargetTags = TargetContainer != nullptr ? *TargetContainer : FGameplayTagContainer::EmptyContainer;
 }
 
 bool FDamageEntry::IsValid() const
@@ -107,6 +102,16 @@ bool FDamageEntry::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSucces
     {
         Ar << Timestamp;
     }
+
+    uint32 PackedSequence = static_cast<uint32>(Sequence);
+    Ar.SerializeIntPacked(PackedSequence);
+
+    if (Ar.IsLoading())
+    {
+        // Entries are only replicated again when the damage list reuses them for a new damage.
+        Sequence = static_cast<int32>(PackedSequence);
+        bHandled = false;
+    }
         
     bOutSuccess = true;
     return true;
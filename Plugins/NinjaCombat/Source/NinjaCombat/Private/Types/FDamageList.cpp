@@ -5,26 +5,30 @@
 #include "Engine/World.h"
 #include "Components/NinjaCombatDamageManagerComponent.h"
 
-FDamageList::FDamageList(): DamageManager(nullptr)
+FDamageList::FDamageList(): HeadIndex(0), NextSequence(0), DamageManager(nullptr)
 {
-	DefaultArraySize = GetDefault<UNinjaCombatSettings>()->DamageRegistrySize;
-	Entries.Reserve(DefaultArraySize);
+	Capacity = FMath::Max(GetDefault<UNinjaCombatSettings>()->DamageRegistrySize, 1);
+	Entries.Reserve(Capacity);
 }
 
-FDamageList::FDamageList(UActorComponent* DamageManager): DamageManager(DamageManager)
+FDamageList::FDamageList(UActorComponent* DamageManager): HeadIndex(0), NextSequence(0), DamageManager(DamageManager)
 {
 	check(DamageManager && DamageManager->Implements<UCombatDamageManagerInterface>());
-	DefaultArraySize = GetDefault<UNinjaCombatSettings>()->DamageRegistrySize;
-	Entries.Reserve(DefaultArraySize);
+	Capacity = FMath::Max(GetDefault<UNinjaCombatSettings>()->DamageRegistrySize, 1);
+	Entries.Reserve(Capacity);
 }
 
 void FDamageList::RegisterDamageTaken(const FGameplayEffectSpec& EffectSpec)
 {
-	CheckArrayLimits();
+	// Once the list is full, the oldest entry is reused in place. It keeps its replication ID, so it
+	// is replicated as a changed item and the other entries are not touched.
+	const int32 SlotIndex = NextSequence % Capacity;
+	FDamageEntry& NewEntry = Entries.IsValidIndex(SlotIndex) ? Entries[SlotIndex] : Entries.AddDefaulted_GetRef();
 
 	const float Timestamp = DamageManager->GetWorld()->GetTimeSeconds();
-	FDamageEntry& NewEntry = Entries.AddDefaulted_GetRef();
 	NewEntry.Initialize(Timestamp, EffectSpec);
+	NewEntry.Sequence = NextSequence++;
+	HeadIndex = Entries.Num() < Capacity ? 0 : NextSequence % Capacity;
 
 	ICombatDamageManagerInterface::Execute_HandleDamageReceived(DamageManager, NewEntry);
 	NewEntry.bHandled = true;
@@ -32,33 +36,82 @@ void FDamageList::RegisterDamageTaken(const FGameplayEffectSpec& EffectSpec)
 	MarkItemDirty(NewEntry);	
 }
 
-TArray<FDamageEntry> FDamageList::GetEntries() const
+FDamageListView FDamageList::GetEntries() const
 {
-	return Entries;
+	return FDamageListView(Entries, HeadIndex);
 }
 
-void FDamageList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+const FDamageEntry* FDamageList::FindEntry(const int32 Sequence) const
 {
-	for (const int32 Idx : AddedIndices)
+	const FDamageListView View = GetEntries();
+	if (View.IsEmpty())
 	{
-		BroadcastDamageTaken(Entries[Idx]);
-	}	
+		return nullptr;
+	}
+
+	const int32 Age = Sequence - View[0].Sequence;
+	return Age >= 0 && Age < View.Num() ? &View[Age] : nullptr;
+}
+
+void FDamageList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
+{
+	UpdateHeadIndex();
+	BroadcastReplicatedEntries(AddedIndices);
 }
 
 void FDamageList::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
 {
-	for (const int32 Idx : ChangedIndices)
+	UpdateHeadIndex();
+	BroadcastReplicatedEntries(ChangedIndices);
+}
+
+void FDamageList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	RestoreSequenceOrder();
+}
+
+void FDamageList::UpdateHeadIndex()
+{
+	HeadIndex = 0;
+	
+	for (int32 Idx = 1; Idx < Entries.Num(); ++Idx)
 	{
-		BroadcastDamageTaken(Entries[Idx]);
+		if (Entries[Idx].Sequence < Entries[HeadIndex].Sequence)
+		{
+			HeadIndex = Idx;
+		}
 	}
 }
 
-void FDamageList::CheckArrayLimits()
+void FDamageList::RestoreSequenceOrder()
 {
-	if (Entries.Num() == DefaultArraySize)
+	// New items are appended in the order they are received, which may not follow the ring buffer.
+	for (int32 Age = 1; Age < Entries.Num(); ++Age)
 	{
-		Entries.RemoveAtSwap(0);
-		MarkArrayDirty();
+		const FDamageEntry& Previous = Entries[(HeadIndex + Age - 1) % Entries.Num()];
+		const FDamageEntry& Current = Entries[(HeadIndex + Age) % Entries.Num()];
+		
+		if (Current.Sequence <= Previous.Sequence)
+		{
+			// Items are matched by replication ID, so they can be moved once all callbacks ran, as long as
+			// the item map is rebuilt. Reused entries are then replaced in place, keeping this order.
+			Entries.Sort([](const FDamageEntry& A, const FDamageEntry& B) { return A.Sequence < B.Sequence; });
+			HeadIndex = 0;
+			MarkArrayDirty();
+			return;
+		}
+	}
+}
+
+void FDamageList::BroadcastReplicatedEntries(const TArrayView<int32>& Indices)
+{
+	// Several entries can arrive together, so handle them in the order they were registered.
+	TArray<int32, TInlineAllocator<16>> SortedIndices(Indices.GetData(), Indices.Num());
+	SortedIndices.Sort([this](const int32 A, const int32 B) { return Entries[A].Sequence < Entries[B].Sequence; });
+
+	for (const int32 Idx : SortedIndices)
+	{
+		BroadcastDamageTaken(Entries[Idx]);
 	}
 }
 
@@ -0,0 +1,55 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "NinjaCombatProjectilePoolData.generated.h"
+
+class ANinjaCombatProjectileActor;
+
+/**
+ * Pooling setup for a single projectile class.
+ */
+USTRUCT(BlueprintType)
+struct NINJACOMBAT_API FNinjaCombatProjectilePoolEntry
+{
+
+	GENERATED_BODY()
+
+	/** Projectile class that will be pooled. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile Pool")
+	TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass;
+
+	/** Projectiles spawned ahead of time. Ideally, the most projectiles expected in flight at once. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile Pool", meta = (ClampMin = "0", UIMin = "0"))
+	int32 PrewarmCount;
+
+	/** Maximum projectiles kept in the pool. Projectiles returning to a full pool are destroyed. Zero means no limit. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile Pool", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxPoolSize;
+
+	FNinjaCombatProjectilePoolEntry() : ProjectileClass(nullptr), PrewarmCount(8), MaxPoolSize(0)
+	{
+	}
+
+};
+
+/**
+ * Configures projectile classes that are pooled ahead of time.
+ */
+UCLASS()
+class NINJACOMBAT_API UNinjaCombatProjectilePoolData : public UPrimaryDataAsset
+{
+
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile Pool", meta = (TitleProperty = "ProjectileClass"))
+	TArray<FNinjaCombatProjectilePoolEntry> Projectiles;
+
+	// -- Begin Primary Data Asset implementation
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+	// -- End Primary Data Asset implementation
+
+};
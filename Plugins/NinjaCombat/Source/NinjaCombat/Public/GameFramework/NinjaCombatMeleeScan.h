@@ -6,12 +6,49 @@
 #include "Engine/DataAsset.h"
 #include "Engine/EngineTypes.h"
 #include "Types/EMeleeScanMode.h"
+#include "UObject/ObjectKey.h"
 #include "NinjaCombatMeleeScan.generated.h"
 
 class UMeshComponent;
+class USkeletalMeshComponent;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogNinjaCombatMeleeScan, Log, All);
 
+/**
+ * A scan socket, resolved once when the scan is created so each tick only reads the pose.
+ */
+struct FNinjaCombatMeleeScanSocket
+{
+	/** Name of the socket (or bone) in the Scan Mesh. */
+	FName SocketName = NAME_None;
+
+	/** Bone the socket is attached to, if the scan mesh is a skeletal mesh that owns its pose. */
+	int32 BoneIndex = INDEX_NONE;
+
+	/** Socket transform relative to its bone. */
+	FTransform LocalTransform = FTransform::Identity;
+
+	/** Whether the socket exists in the Scan Mesh. Missing sockets are skipped. */
+	bool bExists = false;
+
+	/** Socket transform relative to the bone that drives it in the Pose Mesh, used for sub-stepping. */
+	FTransform PoseBoneToSocket = FTransform::Identity;
+
+	/** Range of the bone chain (from the driving bone up to the root) in the sub-stepping chain arrays. */
+	int32 ChainStart = 0;
+	int32 ChainNum = 0;
+};
+
+/**
+ * A single query batched by a melee scan.
+ */
+struct FNinjaCombatMeleeScanQuery
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+};
+
 /**
  * Represents a Melee Scan happening in the Combat System.
  */
@@ -71,6 +108,9 @@ public:
 	 *
 	 * The scan is done by collecting targets between the previous and current Socket Positions
 	 * in the provided Mesh Component. Anything hit in between will be added to the result array.
+	 *
+	 * If sub-stepping is enabled in the Combat Settings, intermediate poses are sampled between the
+	 * previous and current positions, so the scan follows the arc of the swing.
 	 * 
 	 * @param OutHits
 	 *		All Hit Results collected for this scan.
@@ -131,19 +171,87 @@ protected:
 	
 	/** Shape used for the scan, if the scan mode is set to use a sweep. */
 	FCollisionShape ScanShape;
+
+	/** Sockets resolved from the Socket Names, in the same order. */
+	TArray<FNinjaCombatMeleeScanSocket> ScanSockets;
 	
-	/** Last positions scanned for each socket. */
-	TMap<FName, FVector> LastSocketPositions;
+	/** Last positions scanned for each socket, indexed like the Scan Sockets. */
+	TArray<FVector> LastSocketPositions;
 
 	/** Targets that were hit during this scan. */
 	TArray<FHitResult> ConsolidatedHits;
 
-	/** Determines all actors that should be ignored in a hit-scan. */
+	/** Actors already hit during this scan, so each actor is only reported once. */
+	TSet<TObjectKey<AActor>> HitActors;
+
+	/**
+	 * Determines all actors that should be ignored in a hit-scan.
+	 * Collected once when the scan is created, since the ignored actors are not expected to change during a swing.
+	 */
 	UFUNCTION(BlueprintNativeEvent, Category = "Melee Scan")
 	TArray<AActor*> GetIgnoredActors() const;
 
+	/** Resolves the Socket Names into Scan Sockets. */
+	virtual void ResolveSockets();
+
+	/** Gets the current world transform of a resolved socket. */
+	FTransform GetSocketTransform(const FNinjaCombatMeleeScanSocket& Socket) const;
+
+	/**
+	 * Adds all hits from a query that were not reported yet to the output and the consolidated hits.
+	 */
+	void ConsolidateHits(const TArray<FHitResult>& NewHits, TArray<FHitResult>& OutHits);
+
+	/**
+	 * Resolves the bone chains used to rebuild intermediate poses when sub-stepping.
+	 * Sub-stepping is only available when the sockets are driven by a skeletal mesh that owns its pose.
+	 */
+	virtual void ResolveSubStepChains();
+
+	/** Whether this scan can be sub-stepped. */
+	bool CanSubStep() const;
+
+	/** Copies the parent-relative transforms of all chain bones from the Pose Mesh. */
+	void CaptureChainTransforms(TArray<FTransform>& OutChainTransforms) const;
+
+	/**
+	 * Gets the world transform of a socket at a point between the last and current captured poses.
+	 * The chain is blended in parent space, so the socket follows the arc of the animation.
+	 */
+	FTransform GetSubStepSocketTransform(const FNinjaCombatMeleeScanSocket& Socket, const FTransform& PoseMeshTransform, float Alpha) const;
+
 private:
 
+	/** Skeletal mesh whose pose drives the sockets when sub-stepping. */
+	TWeakObjectPtr<USkeletalMeshComponent> PoseMesh;
+
+	/** Pose Mesh world transform at the last scan. */
+	FTransform LastPoseMeshTransform;
+
+	/** Bone indices of every socket chain, flattened. */
+	TArray<int32> ChainBoneIndices;
+
+	/** Parent-relative transforms of the chain bones at the last and current scan. */
+	TArray<FTransform> LastChainTransforms;
+	TArray<FTransform> CurrentChainTransforms;
+
+	/** World time of the last scan, used to decide how many sub-steps to take. */
+	double LastScanTime = 0.;
+
+	/** Reusable buffer for the queries of a scan. */
+	TArray<FNinjaCombatMeleeScanQuery> ScratchQueries;
+
+	/** Query parameters, built once when the scan is created. */
+	FCollisionQueryParams TraceParams;
+
+	/** Reusable buffer for query results. */
+	TArray<FHitResult> ScratchHitResults;
+
+	/** Reusable buffer for the current socket transforms. */
+	TArray<FTransform> ScratchSocketTransforms;
+
+	void InitializeTraceParams();
+
 	void DrawScanLine(const FVector& StartPosition, const FVector& EndPosition) const;
 	void DrawScanSweep(const FVector& StartPosition, const FQuat& Rotation) const;
 	void DrawNewTarget(const FHitResult& NewHit) const;
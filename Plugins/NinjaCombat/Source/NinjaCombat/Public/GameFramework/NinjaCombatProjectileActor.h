@@ -31,6 +31,7 @@ public:
 	// -- Begin Actor implementation
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	// -- End Actor implementation
 
 	// -- Begin Projectile implementation
@@ -61,6 +62,17 @@ public:
 	 */
 	UFUNCTION(BlueprintPure, Category = "Ninja Combat|Combat Projectile")
 	FORCEINLINE int32 GetBounceCount() const { return BounceCount; }
+
+	/**
+	 * Informs if this projectile is launched, or waiting in the Projectile Pool.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ninja Combat|Combat Projectile")
+	FORCEINLINE bool IsProjectileActive() const { return bProjectileActive; }
+
+	/**
+	 * Collects the cosmetic assets used by this projectile, so they can be kept loaded by the Projectile Pool.
+	 */
+	void GetCosmeticAssetPaths(TArray<FSoftObjectPath>& OutPaths) const;
 	
 protected:
 
@@ -156,6 +168,20 @@ protected:
 	UFUNCTION(BlueprintNativeEvent, Category = "Combat Projectile")
 	void HandleProjectileExhausted();
 
+	/**
+	 * Resets the projectile when it returns to the Projectile Pool, so it can be launched again.
+	 * The actor is not destroyed, so anything set up for a launch must be cleared here.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Combat Projectile")
+	void ResetProjectile();
+
+	/**
+	 * Reactivates a projectile acquired from the Projectile Pool, before it is launched again.
+	 * Owner, Instigator and Transform have already been set for the new launch.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Combat Projectile")
+	void ReactivateProjectile();
+
 	/**
 	 * Handles a target that has been collected by the targeting system.
 	 */  
@@ -175,6 +201,8 @@ protected:
 	
 private:
 
+	friend class UNinjaCombatProjectilePoolSubsystem;
+
 	/** Checks if this projectile has been exhausted. */
 	bool bHasExhausted;
 
@@ -189,6 +217,16 @@ private:
 
 	/** Handle to be used when the projectile hits. */
 	FGameplayEffectSpecHandle ImpactEffectHandle;
+
+	/** Targeting request waiting for its results. Results from any other request are ignored. */
+	FTargetingRequestHandle PendingTargetingHandle;
+
+	/** Set when this projectile was spawned by the Projectile Pool, and returns to it when exhausted. */
+	bool bPooled;
+
+	/** Cleared while the projectile waits in the Projectile Pool, so clients can deactivate it as well. */
+	UPROPERTY(ReplicatedUsing = OnRep_ProjectileActive)
+	bool bProjectileActive;
 	
 	/** Sphere component used as root for the projectile. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess))
@@ -207,6 +245,25 @@ private:
 
 	/** Requests a sync/async targeting. */
 	void ExecuteTargeting();
+
+	/** Cancels the pending targeting request, so its results don't affect a later launch. */
+	void CancelTargeting();
+
+	/** Ignores the instigator, and actors attached to it, while moving. */
+	void RegisterInstigatorIgnores();
+
+	/** Removes all ignored actors, including the instigator. */
+	void UnregisterInstigatorIgnores();
+
+	/** Returns the projectile to the Projectile Pool, optionally playing the destruction cosmetics. */
+	void DeactivatePooledProjectile(bool bPlayCosmetics);
+
+	/** Takes the projectile back from the Projectile Pool. */
+	void ActivatePooledProjectile();
+
+	/** Mirrors the pooled state on clients. */
+	UFUNCTION()
+	void OnRep_ProjectileActive();
 	
 	/** Hidden handler to ensure internal logic is correct. */
 	UFUNCTION()
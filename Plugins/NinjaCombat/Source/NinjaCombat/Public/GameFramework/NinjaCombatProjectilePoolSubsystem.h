@@ -0,0 +1,151 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Types/FProjectilePoolStats.h"
+#include "NinjaCombatProjectilePoolSubsystem.generated.h"
+
+class ANinjaCombatProjectileActor;
+class UNinjaCombatProjectilePoolData;
+struct FStreamableHandle;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogNinjaCombatProjectilePool, Log, All);
+
+/**
+ * Projectiles of a single class, kept by the Projectile Pool.
+ */
+USTRUCT()
+struct FNinjaCombatProjectilePool
+{
+
+	GENERATED_BODY()
+
+	/** Projectiles waiting to be acquired. */
+	UPROPERTY()
+	TArray<TObjectPtr<ANinjaCombatProjectileActor>> Available;
+
+	/** Maximum projectiles kept available. Zero means no limit. */
+	int32 MaxPoolSize = 0;
+
+	/** Usage statistics for this pool. */
+	FProjectilePoolStats Stats;
+
+	/** Keeps the cosmetic assets of this class loaded, so launches don't have to request them again. */
+	TSharedPtr<FStreamableHandle> CosmeticsHandle;
+
+};
+
+/**
+ * Keeps exhausted projectiles around, per class, so they can be launched again instead of spawning
+ * and destroying an actor for every shot.
+ *
+ * Only projectiles extending the base Projectile Actor are pooled. They are reset when they return to
+ * the pool and reactivated when they are acquired again, using their lifecycle hooks.
+ */
+UCLASS()
+class NINJACOMBAT_API UNinjaCombatProjectilePoolSubsystem : public UWorldSubsystem
+{
+
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Provides the Projectile Pool for a given world, if pooling is supported in it.
+	 */
+	static UNinjaCombatProjectilePoolSubsystem* Get(const UWorld* World);
+
+	// -- Begin World Subsystem implementation
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	// -- End World Subsystem implementation
+
+	/**
+	 * Spawns projectiles ahead of time, for every class configured in the Pool Data.
+	 *
+	 * @param PoolData		Data Asset with the pooled projectile classes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ninja Combat|Projectile Pool")
+	void PrewarmPools(const UNinjaCombatProjectilePoolData* PoolData);
+
+	/**
+	 * Spawns projectiles ahead of time, until the pool has a given amount available.
+	 *
+	 * @param ProjectileClass	Projectile class that will be pooled.
+	 * @param Count				Projectiles that should be available in the pool.
+	 * @param MaxPoolSize		Maximum projectiles kept in the pool. Zero means no limit.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ninja Combat|Projectile Pool")
+	void PrewarmPool(TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass, int32 Count, int32 MaxPoolSize = 0);
+
+	/**
+	 * Provides a projectile from the pool, or spawns a new one if the pool is empty.
+	 *
+	 * The projectile is not active yet, so it can be modified before "Finish Acquire Projectile" is called,
+	 * in the same way as a deferred spawn. Returns null for classes that cannot be pooled.
+	 *
+	 * @param ProjectileClass	Class representing the projectile.
+	 * @param Transform			Transform used to launch the projectile.
+	 * @param Owner				Owner for the projectile.
+	 * @param Instigator		Instigator for the projectile.
+	 * @return					The projectile, or null if the class cannot be pooled.
+	 */
+	AActor* AcquireProjectile(TSubclassOf<AActor> ProjectileClass, const FTransform& Transform, AActor* Owner, APawn* Instigator);
+
+	/**
+	 * Activates a projectile provided by "Acquire Projectile".
+	 * New projectiles finish spawning, while pooled ones are reactivated.
+	 */
+	void FinishAcquireProjectile(AActor* Projectile, const FTransform& Transform);
+
+	/**
+	 * Returns an exhausted projectile to its pool.
+	 *
+	 * @param Projectile		Projectile that has been exhausted.
+	 * @return					True if the projectile was pooled. Otherwise, it should be destroyed.
+	 */
+	bool ReleaseProjectile(ANinjaCombatProjectileActor* Projectile);
+
+	/**
+	 * Provides the usage statistics for the pool of a given class.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ninja Combat|Projectile Pool")
+	FProjectilePoolStats GetPoolStats(TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass) const;
+
+	/**
+	 * Logs the usage statistics of every pool.
+	 */
+	void DumpPoolStats() const;
+
+protected:
+
+	/** Checks if projectiles from a given class can be pooled. */
+	static bool CanPoolClass(const UClass* ProjectileClass);
+
+	/** Checks if pooling is enabled in the project settings. */
+	static bool IsPoolingEnabled();
+
+private:
+
+	friend class ANinjaCombatProjectileActor;
+
+	/** Pools for each projectile class. */
+	UPROPERTY()
+	TMap<TSubclassOf<ANinjaCombatProjectileActor>, FNinjaCombatProjectilePool> Pools;
+
+	/** Provides the pool for a class, creating it and loading its cosmetics on first use. */
+	FNinjaCombatProjectilePool& FindOrAddPool(TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass);
+
+	/** Spawns a deferred projectile that belongs to the pool. */
+	ANinjaCombatProjectileActor* SpawnPooledProjectile(TSubclassOf<ANinjaCombatProjectileActor> ProjectileClass,
+		const FTransform& Transform, AActor* Owner, APawn* Instigator) const;
+
+	/** Forgets a pooled projectile that has been removed from the world. */
+	void HandlePooledProjectileEndPlay(ANinjaCombatProjectileActor* Projectile);
+
+	/** Loads the cosmetics for the class of a projectile replicated to a client, which has no pools of its own. */
+	void HandleReplicatedProjectileBeginPlay(const ANinjaCombatProjectileActor* Projectile);
+
+};
@@ -7,6 +7,7 @@
 #include "Engine/DeveloperSettings.h"
 #include "NinjaCombatSettings.generated.h"
 
+class UNinjaCombatProjectilePoolData;
 class UNinjaCombatProjectileRequest;
 class UActorComponent;
 class UNinjaCombatMeleeScan;
@@ -62,6 +63,28 @@ public:
 	 */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Melee Combat")
 	float MeleeScanDebugDuration;
+
+	/**
+	 * If set to true, melee scans are sub-stepped between ticks, so fast swings follow the arc of
+	 * the animation instead of the straight line between the last and current socket positions.
+	 *
+	 * Intermediate poses are rebuilt by blending the bone chain of the scanning mesh (or the mesh it is
+	 * attached to) between the last and current pose, which keeps hits reliable at low server frame rates.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Melee Combat")
+	bool bEnableMeleeScanSubStepping;
+
+	/**
+	 * Interval, in seconds, between the poses sampled by a sub-stepped melee scan.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Melee Combat", meta = (EditCondition = "bEnableMeleeScanSubStepping", ClampMin = "0.001", UIMin = "0.001"))
+	float MeleeScanSubStepInterval;
+
+	/**
+	 * Maximum number of sub-steps a melee scan may take on a single tick.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Melee Combat", meta = (EditCondition = "bEnableMeleeScanSubStepping", ClampMin = "1", UIMin = "1"))
+	int32 MeleeScanMaxSubSteps;
 	
 	/**
 	 * Default socket name for projectiles.
@@ -81,6 +104,19 @@ public:
 	 */
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Ranged Combat")
 	TSubclassOf<UNinjaCombatProjectileRequest> ProjectileRequestClass;
+
+	/**
+	 * If set to true, exhausted projectiles return to a pool for their class and are launched again,
+	 * instead of being spawned and destroyed for every shot.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Ranged Combat")
+	bool bEnableProjectilePooling;
+
+	/**
+	 * Projectile classes pooled ahead of time, when a game world begins play.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Ranged Combat", meta = (EditCondition = "bEnableProjectilePooling"))
+	TSoftObjectPtr<UNinjaCombatProjectilePoolData> ProjectilePoolData;
 	
 	/**
 	 * How many inflicted damage entries can be stored per character.
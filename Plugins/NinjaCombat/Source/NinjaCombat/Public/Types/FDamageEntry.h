@@ -35,6 +35,13 @@ struct NINJACOMBAT_API FDamageEntry : public FFastArraySerializerItem
     UPROPERTY()
     FGameplayTagContainer CapturedTargetTags;
 
+    /**
+     * Position of this entry in the damage history of its list.
+     * It never changes, even after older entries are evicted.
+     */
+    UPROPERTY()
+    int32 Sequence;
+
 	/** Marks the entity as handled by the current client. */
     UPROPERTY(NotReplicated)
     bool bHandled;
@@ -42,7 +49,7 @@ struct NINJACOMBAT_API FDamageEntry : public FFastArraySerializerItem
     /**
      * Constructs a new damage info with empty data.
      */
-    FDamageEntry() : Timestamp(TIMESTAMP_NONE), bHandled(false)
+    FDamageEntry() : Timestamp(TIMESTAMP_NONE), Sequence(INDEX_NONE), bHandled(false)
     {
         CapturedSourceTags = FGameplayTagContainer::EmptyContainer;
         CapturedTargetTags = FGameplayTagContainer::EmptyContainer;
@@ -55,7 +62,7 @@ struct NINJACOMBAT_API FDamageEntry : public FFastArraySerializerItem
      * @param EffectSpec        Details about the effect responsible for causing this damage.
      */
     explicit FDamageEntry(const float Timestamp, const FGameplayEffectSpec& EffectSpec)
-        : Timestamp(Timestamp), EffectContext(EffectSpec.GetContext()), bHandled(false)
+        : Timestamp(Timestamp), EffectContext(EffectSpec.GetContext()), Sequence(INDEX_NONE), bHandled(false)
     {
         Initialize(Timestamp, EffectSpec);
     }
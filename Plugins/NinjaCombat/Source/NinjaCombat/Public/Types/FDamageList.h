@@ -8,8 +8,61 @@
 
 class UNinjaCombatDamageManagerComponent;
 
+/**
+ * Read-only view of the entries stored in a Damage List, from the oldest to the newest.
+ *
+ * It references the list storage, so it should not be kept around after the list changes.
+ */
+struct NINJACOMBAT_API FDamageListView
+{
+    struct FIterator
+    {
+        FIterator(const FDamageListView& InView, const int32 InIndex) : View(InView), Index(InIndex) { }
+
+        const FDamageEntry& operator*() const { return View[Index]; }
+        const FDamageEntry* operator->() const { return &View[Index]; }
+        FIterator& operator++() { ++Index; return *this; }
+        bool operator!=(const FIterator& Other) const { return Index != Other.Index; }
+
+    private:
+
+        const FDamageListView& View;
+        int32 Index;
+    };
+
+    FDamageListView(const TConstArrayView<FDamageEntry> InEntries, const int32 InHeadIndex)
+        : Entries(InEntries), HeadIndex(InHeadIndex) { }
+
+    /** Amount of entries in the view. */
+    int32 Num() const { return Entries.Num(); }
+
+    /** Informs if there are no entries in the view. */
+    bool IsEmpty() const { return Entries.IsEmpty(); }
+
+    /** Provides an entry by its age, where zero is the oldest one. */
+    const FDamageEntry& operator[](const int32 Index) const
+    {
+        check(Entries.IsValidIndex(Index));
+        return Entries[(HeadIndex + Index) % Entries.Num()];
+    }
+
+    FIterator begin() const { return FIterator(*this, 0); }
+    FIterator end() const { return FIterator(*this, Num()); }
+
+private:
+
+    /** Storage of the list, in ring buffer order. */
+    TConstArrayView<FDamageEntry> Entries;
+
+    /** Storage index of the oldest entry. */
+    int32 HeadIndex;
+};
+
 /**
  * A list of replicated damage entries.
+ *
+ * Entries are kept in a fixed-capacity ring buffer. Once the list is full, a new entry replaces the
+ * oldest one in place, so only that item is replicated again and the others keep their positions.
  */
 USTRUCT(BlueprintType)
 struct FDamageList : public FFastArraySerializer
@@ -41,25 +94,56 @@ struct FDamageList : public FFastArraySerializer
     void RegisterDamageTaken(const FGameplayEffectSpec& EffectSpec);
 
     /**
-     * Provides all entries currently stored.
+     * Provides all entries currently stored, without copying them.
      *
      * @return
-     *      Array containing all entries stored.
+     *      A read-only view of the stored entries, from the oldest to the newest.
      */
-    TArray<FDamageEntry> GetEntries() const;
+    FDamageListView GetEntries() const;
+
+    /**
+     * Provides an entry by its sequence, which never changes while the entry is stored.
+     *
+     * @param Sequence
+     *      The sequence of the entry in the damage history of this list.
+     *
+     * @return
+     *      The entry, or null if it has not been registered or has already been evicted.
+     */
+    const FDamageEntry* FindEntry(int32 Sequence) const;
+
+    /** Amount of entries currently stored. */
+    int32 Num() const { return Entries.Num(); }
+
+    /** Maximum amount of entries stored, configured in the project settings. */
+    int32 GetCapacity() const { return Capacity; }
     
     // -- Begin FFastArraySerializer implementation
     void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
     void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
+    void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
     bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams);
     // -- End FFastArraySerializer implementation
 
 protected:
 
     /**
-     * Checks the array limit and remove the oldest element, if necessary.
+     * Finds the oldest entry received by a client, so the view starts from it.
      */
-    void CheckArrayLimits();
+    void UpdateHeadIndex();
+
+    /**
+     * Sorts entries received by a client out of order, so the view goes from the oldest to the newest.
+     */
+    void RestoreSequenceOrder();
+
+    /**
+     * Broadcasts replicated entries in the same order they were registered.
+     *
+     * @param Indices
+     *      Indices of the entries that were received.
+     */
+    void BroadcastReplicatedEntries(const TArrayView<int32>& Indices);
     
     /**
      * Broadcasts a Damage Taken, back to the owning component.
@@ -71,8 +155,14 @@ protected:
 
 private:
 
-	/** The default array size, configured in the project settings. */
-	int32 DefaultArraySize;
+	/** Maximum amount of entries, configured in the project settings. */
+	int32 Capacity;
+
+    /** Storage index of the oldest entry. */
+    int32 HeadIndex;
+
+    /** Sequence assigned to the next entry registered by the server. */
+    int32 NextSequence;
 	
     /** Combat component that owns this list. */
     UPROPERTY()
@@ -0,0 +1,40 @@
+﻿// Ninja Bear Studio Inc., all rights reserved.
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FProjectilePoolStats.generated.h"
+
+/**
+ * Usage statistics for the pool of a single projectile class.
+ */
+USTRUCT(BlueprintType)
+struct NINJACOMBAT_API FProjectilePoolStats
+{
+
+	GENERATED_BODY()
+
+	/** Projectiles that were acquired from the pool, without spawning a new actor. */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 Hits;
+
+	/** Projectiles that had to be spawned, because the pool was empty. */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 Misses;
+
+	/** Projectiles from the pool that are currently launched. */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 NumActive;
+
+	/** Projectiles waiting in the pool to be acquired. */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 NumAvailable;
+
+	/** Highest amount of projectiles from the pool launched at the same time. */
+	UPROPERTY(BlueprintReadOnly, Category = "Projectile Pool")
+	int32 HighWater;
+
+	FProjectilePoolStats() : Hits(0), Misses(0), NumActive(0), NumAvailable(0), HighWater(0)
+	{
+	}
+
+};
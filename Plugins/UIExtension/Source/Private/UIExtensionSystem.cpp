@@ -4,12 +4,19 @@
 
 #include "Blueprint/UserWidget.h"  // 引入用户控件类
 #include "LogUIExtension.h"  // UI扩展系统日志
+#include "ProfilingDebugging/CsvProfiler.h"  // CSV性能统计
+#include "Stats/Stats.h"  // 统计计数器
 #include "UObject/Stack.h"  // 对象栈支持
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UIExtensionSystem)  // 自动生成的C++代码
 
 class FSubsystemCollectionBase;  // 前置声明子系统集合基类
 
+// 每帧扩展通知次数（stat UIExtension / CSV）
+DECLARE_STATS_GROUP(TEXT("UIExtension"), STATGROUP_UIExtension, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Extension Notifications"), STAT_UIExtensionNotifications, STATGROUP_UIExtension);
+CSV_DEFINE_CATEGORY(UIExtension, /*bIsEnabledByDefault=*/false);
+
 //=========================================================
 // FUIExtensionPointHandle 扩展点句柄实现
 //=========================================================
@@ -110,6 +117,95 @@ void UUIExtensionSubsystem::Deinitialize()
     Super::Deinitialize();  // 调用父类反初始化
 }
 
+void UUIExtensionSubsystem::BeginRegistrationBatch()
+{
+    ++RegistrationBatchDepth;
+}
+
+void UUIExtensionSubsystem::EndRegistrationBatch()
+{
+    check(RegistrationBatchDepth > 0);
+    if (--RegistrationBatchDepth > 0)
+    {
+        return;  // 仍在外层批处理中
+    }
+
+    TArray<TSharedPtr<FUIExtension>> BatchedExtensions = MoveTemp(PendingBatchExtensions);
+    TArray<TSharedPtr<FUIExtensionPoint>> BatchedExtensionPoints = MoveTemp(PendingBatchExtensionPoints);
+
+    EnterNotification();
+
+    // 按扩展点收集批处理中注册的扩展（保持首次出现顺序和注册顺序）
+    TMap<FUIExtensionPoint*, TArray<int32, TInlineAllocator<8>>> ExtensionsPerPoint;
+    for (int32 ExtensionIndex = 0; ExtensionIndex < BatchedExtensions.Num(); ++ExtensionIndex)
+    {
+        FUIExtension* Extension = BatchedExtensions[ExtensionIndex].Get();
+        if (!Extension->bPendingBatchNotify)
+        {
+            continue;  // 批处理期间已被注销
+        }
+        Extension->bPendingBatchNotify = false;
+
+        // 此处不会触发回调，可直接引用缓存的父级链
+        bool bOnInitialTag = true;
+        for (const FGameplayTag& Tag : GetTagParentChain(Extension->ExtensionPointTag))
+        {
+            if (const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Tag))
+            {
+                for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : *ListPtr)
+                {
+                    // 新注册的扩展点稍后会一次性得知所有扩展
+                    if (ExtensionPoint->bUnregistered || ExtensionPoint->bPendingBatchNotify)
+                    {
+                        continue;
+                    }
+
+                    const bool bShouldNotify =
+                        bOnInitialTag ||
+                        (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::PartialMatch);
+
+                    if (bShouldNotify && ExtensionPoint->DoesExtensionPassContract(Extension))
+                    {
+                        ExtensionsPerPoint.FindOrAdd(ExtensionPoint.Get()).Add(ExtensionIndex);
+                    }
+                }
+            }
+
+            bOnInitialTag = false;
+        }
+    }
+
+    // 逐个扩展点连续派发
+    for (const TPair<FUIExtensionPoint*, TArray<int32, TInlineAllocator<8>>>& Pair : ExtensionsPerPoint)
+    {
+        FUIExtensionPoint* ExtensionPoint = Pair.Key;
+        for (const int32 ExtensionIndex : Pair.Value)
+        {
+            // 回调可能注销扩展点或扩展
+            const TSharedPtr<FUIExtension>& Extension = BatchedExtensions[ExtensionIndex];
+            if (!ExtensionPoint->bUnregistered && !Extension->bUnregistered)
+            {
+                ExecuteExtensionPointCallback(*ExtensionPoint, EUIExtensionAction::Added, CreateExtensionRequest(Extension));
+            }
+        }
+    }
+
+    // 通知批处理中注册的扩展点所有现有扩展
+    for (TSharedPtr<FUIExtensionPoint>& ExtensionPoint : BatchedExtensionPoints)
+    {
+        if (ExtensionPoint->bPendingBatchNotify)
+        {
+            ExtensionPoint->bPendingBatchNotify = false;
+            if (!ExtensionPoint->bUnregistered)
+            {
+                NotifyExtensionPointOfExtensions(ExtensionPoint);
+            }
+        }
+    }
+
+    LeaveNotification();
+}
+
 FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPoint(
     const FGameplayTag& ExtensionPointTag,
     EUIExtensionPointMatch ExtensionPointTagMatchType,
@@ -161,8 +257,16 @@ FUIExtensionPointHandle UUIExtensionSubsystem::RegisterExtensionPointForContext(
 
     UE_LOG(LogUIExtension, Verbose, TEXT("Extension Point [%s] Registered"), *ExtensionPointTag.ToString());
 
-    // 通知新扩展点现有扩展
-    NotifyExtensionPointOfExtensions(Entry);
+    // 通知新扩展点现有扩展（批处理中则延后）
+    if (RegistrationBatchDepth > 0)
+    {
+        Entry->bPendingBatchNotify = true;
+        PendingBatchExtensionPoints.Add(Entry);
+    }
+    else
+    {
+        NotifyExtensionPointOfExtensions(Entry);
+    }
 
     // 返回有效句柄
     return FUIExtensionPointHandle(this, Entry);
@@ -227,33 +331,116 @@ FUIExtensionHandle UUIExtensionSubsystem::RegisterExtensionAsData(
         UE_LOG(LogUIExtension, Verbose, TEXT("Extension [%s] for [%s] @ [%s] Registered"), *GetNameSafe(Data), *GetNameSafe(ContextObject), *ExtensionPointTag.ToString());
     }
 
-    // 通知所有相关扩展点
-    NotifyExtensionPointsOfExtension(EUIExtensionAction::Added, Entry);
+    // 通知所有相关扩展点（批处理中则延后）
+    if (RegistrationBatchDepth > 0)
+    {
+        Entry->bPendingBatchNotify = true;
+        PendingBatchExtensions.Add(Entry);
+    }
+    else
+    {
+        NotifyExtensionPointsOfExtension(EUIExtensionAction::Added, Entry);
+    }
 
     // 返回有效句柄
     return FUIExtensionHandle(this, Entry);
 }
 
+const TArray<FGameplayTag>& UUIExtensionSubsystem::GetTagParentChain(const FGameplayTag& Tag)
+{
+    if (const TArray<FGameplayTag>* ParentChainPtr = TagParentChains.Find(Tag))
+    {
+        return *ParentChainPtr;
+    }
+
+    // 首次遇到该标签时遍历一次层级
+    TArray<FGameplayTag>& ParentChain = TagParentChains.Add(Tag);
+    for (FGameplayTag ParentTag = Tag; ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+    {
+        ParentChain.Add(ParentTag);
+    }
+    return ParentChain;
+}
+
+void UUIExtensionSubsystem::ExecuteExtensionPointCallback(FUIExtensionPoint& ExtensionPoint, EUIExtensionAction Action, const FUIExtensionRequest& Request)
+{
+    INC_DWORD_STAT(STAT_UIExtensionNotifications);
+    CSV_CUSTOM_STAT(UIExtension, ExtensionNotifications, 1, ECsvCustomStatOp::Accumulate);
+
+    ExtensionPoint.Callback.ExecuteIfBound(Action, Request);
+}
+
+void UUIExtensionSubsystem::EnterNotification()
+{
+    ++NotificationDepth;
+}
+
+void UUIExtensionSubsystem::LeaveNotification()
+{
+    check(NotificationDepth > 0);
+    if ((--NotificationDepth == 0) && bHasUnregisteredEntries)
+    {
+        RemoveUnregisteredEntries();
+    }
+}
+
+void UUIExtensionSubsystem::RemoveUnregisteredEntries()
+{
+    bHasUnregisteredEntries = false;
+
+    // 清理通知期间注销的扩展点
+    for (auto MapIt = ExtensionPointMap.CreateIterator(); MapIt; ++MapIt)
+    {
+        MapIt.Value().RemoveAllSwap([](const TSharedPtr<FUIExtensionPoint>& ExtensionPoint) { return ExtensionPoint->bUnregistered; });
+        if (MapIt.Value().Num() == 0)
+        {
+            MapIt.RemoveCurrent();
+        }
+    }
+
+    // 清理通知期间注销的扩展
+    for (auto MapIt = ExtensionMap.CreateIterator(); MapIt; ++MapIt)
+    {
+        MapIt.Value().RemoveAllSwap([](const TSharedPtr<FUIExtension>& Extension) { return Extension->bUnregistered; });
+        if (MapIt.Value().Num() == 0)
+        {
+            MapIt.RemoveCurrent();
+        }
+    }
+}
+
 void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExtensionPoint>& ExtensionPoint)
 {
+    EnterNotification();
+
+    // 回调可能新增标签缓存，因此复制父级链（仅标签，无引用计数开销）
+    const TArray<FGameplayTag, TInlineAllocator<8>> ParentChain(GetTagParentChain(ExtensionPoint->ExtensionPointTag));
+
     // 遍历扩展点标签层级
-    for (FGameplayTag Tag = ExtensionPoint->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+    for (const FGameplayTag& Tag : ParentChain)
     {
-        // 查找匹配的扩展列表
-        if (const FExtensionList* ListPtr = ExtensionMap.Find(Tag))
+        // 通知期间注销只做标记，列表不会缩短；回调中新增的扩展不在本次通知范围内
+        const FExtensionList* ListPtr = ExtensionMap.Find(Tag);
+        const int32 NumExtensions = ListPtr ? ListPtr->Num() : 0;
+
+        for (int32 ExtensionIndex = 0; ExtensionIndex < NumExtensions; ++ExtensionIndex)
         {
-            // 复制扩展列表防止回调期间修改
-            FExtensionList ExtensionArray(*ListPtr);
+            // 回调可能导致映射重新分配，每次重新查找列表
+            const TSharedPtr<FUIExtension>& Extension = ExtensionMap.FindChecked(Tag)[ExtensionIndex];
 
             // 检查每个扩展是否符合契约
-            for (const TSharedPtr<FUIExtension>& Extension : ExtensionArray)
+            if (!Extension->bUnregistered && ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
             {
-                if (ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
-                {
-                    // 创建扩展请求并触发回调
-                    FUIExtensionRequest Request = CreateExtensionRequest(Extension);
-                    ExtensionPoint->Callback.ExecuteIfBound(EUIExtensionAction::Added, Request);
-                }
+                // 创建扩展请求并触发回调
+                const FUIExtensionRequest Request = CreateExtensionRequest(Extension);
+                ExecuteExtensionPointCallback(*ExtensionPoint, EUIExtensionAction::Added, Request);
+            }
+
+            // 回调中可能注销了该扩展点
+            if (ExtensionPoint->bUnregistered)
+            {
+                LeaveNotification();
+                return;
             }
         }
 
@@ -263,40 +450,54 @@ void UUIExtensionSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExten
             break;
         }
     }
+
+    LeaveNotification();
 }
 
 void UUIExtensionSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAction Action,TSharedPtr<FUIExtension>& Extension)
 {
+    EnterNotification();
+
+    // 回调可能新增标签缓存，因此复制父级链（仅标签，无引用计数开销）
+    const TArray<FGameplayTag, TInlineAllocator<8>> ParentChain(GetTagParentChain(Extension->ExtensionPointTag));
+
     bool bOnInitialTag = true;  // 标记初始标签层级
     
     // 遍历扩展标签层级
-    for (FGameplayTag Tag = Extension->ExtensionPointTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+    for (const FGameplayTag& Tag : ParentChain)
     {
-        // 查找匹配的扩展点列表
-        if (const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Tag))
+        // 通知期间注销只做标记，列表不会缩短；回调中新增的扩展点不在本次通知范围内
+        const FExtensionPointList* ListPtr = ExtensionPointMap.Find(Tag);
+        const int32 NumExtensionPoints = ListPtr ? ListPtr->Num() : 0;
+
+        for (int32 ExtensionPointIndex = 0; ExtensionPointIndex < NumExtensionPoints; ++ExtensionPointIndex)
         {
-            // 复制扩展点列表防止回调期间修改
-            FExtensionPointList ExtensionPointArray(*ListPtr);
+            // 回调可能导致映射重新分配，每次重新查找列表
+            FUIExtensionPoint* ExtensionPoint = ExtensionPointMap.FindChecked(Tag)[ExtensionPointIndex].Get();
 
-            // 检查每个扩展点
-            for (const TSharedPtr<FUIExtensionPoint>& ExtensionPoint : ExtensionPointArray)
+            // 跳过已注销的扩展点，以及批处理中稍后会一次性得知所有扩展的扩展点
+            if (ExtensionPoint->bUnregistered || ExtensionPoint->bPendingBatchNotify)
             {
-                // 检查匹配条件
-                const bool bShouldNotify = 
-                    bOnInitialTag || 
-                    (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::PartialMatch);
-                
-                if (bShouldNotify && ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
-                {
-                    // 创建扩展请求并触发回调
-                    FUIExtensionRequest Request = CreateExtensionRequest(Extension);
-                    ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
-                }
+                continue;
+            }
+
+            // 检查匹配条件
+            const bool bShouldNotify = 
+                bOnInitialTag || 
+                (ExtensionPoint->ExtensionPointTagMatchType == EUIExtensionPointMatch::PartialMatch);
+            
+            if (bShouldNotify && ExtensionPoint->DoesExtensionPassContract(Extension.Get()))
+            {
+                // 创建扩展请求并触发回调
+                const FUIExtensionRequest Request = CreateExtensionRequest(Extension);
+                ExecuteExtensionPointCallback(*ExtensionPoint, Action, Request);
             }
         }
         
         bOnInitialTag = false;  // 离开初始标签层级
     }
+
+    LeaveNotification();
 }
 
 void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& ExtensionHandle)
@@ -308,6 +509,12 @@ void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& Extens
         checkf(ExtensionHandle.ExtensionSource == this, TEXT("Trying to unregister an extension that's not from this extension subsystem."));
 
         TSharedPtr<FUIExtension> Extension = ExtensionHandle.DataPtr;
+
+        // 已注销的扩展不再重复通知
+        if (Extension->bUnregistered)
+        {
+            return;
+        }
         
         // 查找扩展列表
         if (FExtensionList* ListPtr = ExtensionMap.Find(Extension->ExtensionPointTag))
@@ -322,16 +529,36 @@ void UUIExtensionSubsystem::UnregisterExtension(const FUIExtensionHandle& Extens
                 UE_LOG(LogUIExtension, Verbose, TEXT("Extension [%s] for [%s] @ [%s] Unregistered"), *GetNameSafe(Extension->Data), *GetNameSafe(Extension->ContextObject.Get()), *Extension->ExtensionPointTag.ToString());
             }
 
-            // 通知扩展点移除操作
-            NotifyExtensionPointsOfExtension(EUIExtensionAction::Removed, Extension);
+            // 通知扩展点移除操作（批处理中尚未广播的扩展无需通知）
+            if (Extension->bPendingBatchNotify)
+            {
+                Extension->bPendingBatchNotify = false;
+            }
+            else
+            {
+                NotifyExtensionPointsOfExtension(EUIExtensionAction::Removed, Extension);
+            }
 
-            // 从列表中移除扩展
-            ListPtr->RemoveSwap(Extension);
-            
-            // 清理空列表
-            if (ListPtr->Num() == 0)
+            Extension->bUnregistered = true;
+
+            // 通知进行中时延后移除，避免遍历中的列表发生变化
+            if (NotificationDepth > 0)
+            {
+                bHasUnregisteredEntries = true;
+                return;
+            }
+
+            // 从列表中移除扩展（通知回调可能导致映射重新分配，重新查找）
+            ListPtr = ExtensionMap.Find(Extension->ExtensionPointTag);
+            if (ListPtr)
             {
-                ExtensionMap.Remove(Extension->ExtensionPointTag);
+                ListPtr->RemoveSwap(Extension);
+
+                // 清理空列表
+                if (ListPtr->Num() == 0)
+                {
+                    ExtensionMap.Remove(Extension->ExtensionPointTag);
+                }
             }
         }
     }
@@ -350,12 +577,27 @@ void UUIExtensionSubsystem::UnregisterExtensionPoint(const FUIExtensionPointHand
         check(ExtensionPointHandle.ExtensionSource == this);
 
         const TSharedPtr<FUIExtensionPoint> ExtensionPoint = ExtensionPointHandle.DataPtr;
+
+        // 已注销的扩展点直接返回
+        if (ExtensionPoint->bUnregistered)
+        {
+            return;
+        }
         
         // 查找扩展点列表
         if (FExtensionPointList* ListPtr = ExtensionPointMap.Find(ExtensionPoint->ExtensionPointTag))
         {
             UE_LOG(LogUIExtension, Verbose, TEXT("Extension Point [%s] Unregistered"), *ExtensionPoint->ExtensionPointTag.ToString());
 
+            ExtensionPoint->bUnregistered = true;
+
+            // 通知进行中时延后移除，避免遍历中的列表发生变化
+            if (NotificationDepth > 0)
+            {
+                bHasUnregisteredEntries = true;
+                return;
+            }
+
             // 从列表中移除扩展点
             ListPtr->RemoveSwap(ExtensionPoint);
             
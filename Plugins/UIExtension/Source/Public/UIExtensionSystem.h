@@ -53,6 +53,12 @@ public:
 	TWeakObjectPtr<UObject> ContextObject;
 	//Kept alive by UUIExtensionSubsystem::AddReferencedObjects
 	TObjectPtr<UObject> Data = nullptr;
+
+	// Set when unregistered, the entry stays in the subsystem's lists until no notification is in progress
+	bool bUnregistered = false;
+
+	// Registered during a registration batch and not broadcast to extension points yet
+	bool bPendingBatchNotify = false;
 };
 
 /**
@@ -67,6 +73,12 @@ public:
 	TArray<TObjectPtr<UClass>> AllowedDataClasses;
 	FExtendExtensionPointDelegate Callback;
 
+	// Set when unregistered, the entry stays in the subsystem's lists until no notification is in progress
+	bool bUnregistered = false;
+
+	// Registered during a registration batch and not told about existing extensions yet
+	bool bPendingBatchNotify = false;
+
 	// Tests if the extension and the extension point match up, if they do then this extension point should learn
 	// about this extension.
 	bool DoesExtensionPassContract(const FUIExtension* Extension) const;
@@ -209,6 +221,13 @@ public:
 
 	static UE_API void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
+	/**
+	 * Starts a registration batch. Notifications for the extensions and extension points registered until the matching
+	 * EndRegistrationBatch are held back, then delivered grouped by extension point. Batches can be nested.
+	 */
+	UE_API void BeginRegistrationBatch();
+	UE_API void EndRegistrationBatch();
+
 protected:
 	UE_API virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	UE_API virtual void Deinitialize() override;
@@ -249,6 +268,51 @@ private:
 
 	typedef TArray<TSharedPtr<FUIExtension>> FExtensionList;
 	TMap<FGameplayTag, FExtensionList> ExtensionMap;
+
+	// Returns the tag followed by each of its parents, built the first time a tag is seen
+	const TArray<FGameplayTag>& GetTagParentChain(const FGameplayTag& Tag);
+
+	void ExecuteExtensionPointCallback(FUIExtensionPoint& ExtensionPoint, EUIExtensionAction Action, const FUIExtensionRequest& Request);
+
+	// While a notification is in progress unregistered entries are only flagged, so the lists can be iterated without copying them
+	void EnterNotification();
+	void LeaveNotification();
+	void RemoveUnregisteredEntries();
+
+	TMap<FGameplayTag, TArray<FGameplayTag>> TagParentChains;
+
+	int32 NotificationDepth = 0;
+	bool bHasUnregisteredEntries = false;
+
+	int32 RegistrationBatchDepth = 0;
+	TArray<TSharedPtr<FUIExtension>> PendingBatchExtensions;
+	TArray<TSharedPtr<FUIExtensionPoint>> PendingBatchExtensionPoints;
+};
+
+/** Keeps a registration batch open on the extension subsystem for the lifetime of the scope */
+struct FUIExtensionRegistrationBatchScope
+{
+	explicit FUIExtensionRegistrationBatchScope(UUIExtensionSubsystem* InExtensionSubsystem)
+		: ExtensionSubsystem(InExtensionSubsystem)
+	{
+		if (ExtensionSubsystem)
+		{
+			ExtensionSubsystem->BeginRegistrationBatch();
+		}
+	}
+
+	~FUIExtensionRegistrationBatchScope()
+	{
+		if (ExtensionSubsystem)
+		{
+			ExtensionSubsystem->EndRegistrationBatch();
+		}
+	}
+
+	UE_NONCOPYABLE(FUIExtensionRegistrationBatchScope);
+
+private:
+	UUIExtensionSubsystem* ExtensionSubsystem;
 };
 
 
@@ -14,6 +14,7 @@
 #include "LyraAbilitySimpleFailureMessage.h"
 #include "GameFramework/GameplayMessageSubsystem.h"
 #include "AbilitySystem/LyraAbilitySourceInterface.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
 #include "AbilitySystem/LyraGameplayEffectContext.h"
 #include "Physics/PhysicalMaterialWithTags.h"
 #include "GameFramework/PlayerState.h"
@@ -543,3 +544,25 @@ void ULyraGameplayAbility::ClearCameraMode()
 	}
 }
 
+void ULyraGameplayAbility::ExecuteGameplayCueBatched(FGameplayTag GameplayCueTag, const FGameplayCueParameters& GameplayCueParameters)
+{
+	ENSURE_ABILITY_IS_INSTANTIATED_OR_RETURN(ExecuteGameplayCueBatched, );
+
+	ULyraAbilitySystemComponent* LyraASC = GetLyraAbilitySystemComponentFromActorInfo();
+	ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get();
+	if ((LyraASC == nullptr) || (GCM == nullptr))
+	{
+		return;
+	}
+
+	FGameplayCueParameters Parameters = GameplayCueParameters;
+	if (!Parameters.EffectContext.IsValid())
+	{
+		Parameters.EffectContext = MakeEffectContext(CurrentSpecHandle, CurrentActorInfo);
+	}
+
+	// Locally predicted abilities play the batch on the predicting client right away, the server's multicast skips that client
+	const bool bPredicted = (GetNetExecutionPolicy() == EGameplayAbilityNetExecutionPolicy::LocalPredicted);
+	GCM->AddBatchedGameplayCue(LyraASC, GameplayCueTag, Parameters, bPredicted);
+}
+
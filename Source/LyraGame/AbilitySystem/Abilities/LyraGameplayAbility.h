@@ -143,6 +143,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lyra|Ability")
 	UE_API void ClearCameraMode();
 
+	// Executes a gameplay cue merged with any other executes of the same cue by this ability system component this frame (e.g., one per pellet or per melee target)
+	// The impacts are sent to clients with a single RPC and can be spawned in one pass by the notify, see ULyraGameplayCueManager::GetBatchedImpacts
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Ability", Meta = (GameplayTagFilter = "GameplayCue"))
+	UE_API void ExecuteGameplayCueBatched(FGameplayTag GameplayCueTag, const FGameplayCueParameters& GameplayCueParameters);
+
 	void OnAbilityFailedToActivate(const FGameplayTagContainer& FailedReason) const
 	{
 		NativeOnAbilityFailedToActivate(FailedReason);
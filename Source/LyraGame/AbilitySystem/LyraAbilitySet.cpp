@@ -4,6 +4,7 @@
 
 #include "AbilitySystem/Abilities/LyraGameplayAbility.h"
 #include "LyraAbilitySystemComponent.h"
+#include "LyraGameplayCueManager.h"
 #include "LyraLogChannels.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilitySet)
@@ -79,6 +80,12 @@ void ULyraAbilitySet::GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC,
 		// Must be authoritative to give or take ability sets.
 		return;
 	}
+
+	// Start streaming the cues this set can trigger before they are first needed
+	if (ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get())
+	{
+		GCM->PreloadCuesForAbilitySet(this, SourceObject ? SourceObject : LyraASC->GetOwner());
+	}
 	
 	// Grant the attribute sets.
 	for (int32 SetIndex = 0; SetIndex < GrantedAttributes.Num(); ++SetIndex)
@@ -146,3 +153,21 @@ void ULyraAbilitySet::GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC,
 	}
 }
 
+void ULyraAbilitySet::GetGrantedAbilityAndEffectClasses(TArray<const UClass*>& OutClasses) const
+{
+	for (const FLyraAbilitySet_GameplayAbility& AbilityToGrant : GrantedGameplayAbilities)
+	{
+		if (IsValid(AbilityToGrant.Ability))
+		{
+			OutClasses.AddUnique(AbilityToGrant.Ability);
+		}
+	}
+
+	for (const FLyraAbilitySet_GameplayEffect& EffectToGrant : GrantedGameplayEffects)
+	{
+		if (IsValid(EffectToGrant.GameplayEffect))
+		{
+			OutClasses.AddUnique(EffectToGrant.GameplayEffect);
+		}
+	}
+}
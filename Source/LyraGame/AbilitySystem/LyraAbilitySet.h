@@ -133,6 +133,9 @@ public:
 	// The returned handles can be used later to take away anything that was granted.
 	void GiveToAbilitySystem(ULyraAbilitySystemComponent* LyraASC, FLyraAbilitySet_GrantedHandles* OutGrantedHandles, UObject* SourceObject = nullptr) const;
 
+	// Gathers the ability and gameplay effect classes granted by this set.
+	void GetGrantedAbilityAndEffectClasses(TArray<const UClass*>& OutClasses) const;
+
 protected:
 
 	// Gameplay abilities to grant when this ability set is granted.
@@ -4,6 +4,7 @@
 
 #include "AbilitySystem/Abilities/LyraGameplayAbility.h"
 #include "AbilitySystem/LyraAbilityTagRelationshipMapping.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
 #include "Animation/LyraAnimInstance.h"
 #include "Engine/World.h"
 #include "GameFramework/Pawn.h"
@@ -16,6 +17,16 @@
 
 UE_DEFINE_GAMEPLAY_TAG(TAG_Gameplay_AbilityInputBlocked, "Gameplay.AbilityInputBlocked");
 
+namespace LyraAbilitySystemComponentCVars
+{
+	static bool bBatchAbilityRPCs = true;
+	static FAutoConsoleVariableRef CVarBatchAbilityRPCs(
+		TEXT("Lyra.AbilitySystem.BatchAbilityRPCs"),
+		bBatchAbilityRPCs,
+		TEXT("If true, the activation, target data and end of an ability activated from input in the same frame are sent to the server as a single RPC"),
+		ECVF_Default);
+}
+
 ULyraAbilitySystemComponent::ULyraAbilitySystemComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -183,16 +194,128 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 	}
 }
 
+void ULyraAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	for (const FGameplayTag& Tag : AbilitySpec.GetDynamicSpecSourceTags())
+	{
+		InputTagToSpecHandles.FindOrAdd(Tag).AddUnique(AbilitySpec.Handle);
+	}
+
+	bSpecIndicesDirty = true;
+}
+
+void ULyraAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	for (const FGameplayTag& Tag : AbilitySpec.GetDynamicSpecSourceTags())
+	{
+		if (TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>* SpecHandles = InputTagToSpecHandles.Find(Tag))
+		{
+			SpecHandles->Remove(AbilitySpec.Handle);
+			if (SpecHandles->Num() == 0)
+			{
+				InputTagToSpecHandles.Remove(Tag);
+			}
+		}
+	}
+
+	bSpecIndicesDirty = true;
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+bool ULyraAbilitySystemComponent::ShouldDoServerAbilityRPCBatch() const
+{
+	return LyraAbilitySystemComponentCVars::bBatchAbilityRPCs && !IsOwnerActorAuthoritative();
+}
+
+FGameplayAbilitySpec* ULyraAbilitySystemComponent::FindInputAbilitySpec(FGameplayAbilitySpecHandle SpecHandle, int32& OutSpecIndex)
+{
+	if (bSpecIndicesDirty)
+	{
+		RebuildSpecIndices();
+	}
+
+	for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+	{
+		if (const int32* SpecIndexPtr = SpecHandleToIndex.Find(SpecHandle))
+		{
+			if (ActivatableAbilities.Items.IsValidIndex(*SpecIndexPtr) && (ActivatableAbilities.Items[*SpecIndexPtr].Handle == SpecHandle))
+			{
+				OutSpecIndex = *SpecIndexPtr;
+				return &ActivatableAbilities.Items[OutSpecIndex];
+			}
+
+			// The list was reordered without a grant or removal we heard about (e.g., by replication), so the indices are stale
+			RebuildSpecIndices();
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	OutSpecIndex = INDEX_NONE;
+	return nullptr;
+}
+
+void ULyraAbilitySystemComponent::RebuildSpecIndices()
+{
+	const int32 NumSpecs = ActivatableAbilities.Items.Num();
+
+	SpecHandleToIndex.Reset();
+	for (int32 SpecIndex = 0; SpecIndex < NumSpecs; ++SpecIndex)
+	{
+		SpecHandleToIndex.Add(ActivatableAbilities.Items[SpecIndex].Handle, SpecIndex);
+	}
+
+	bSpecIndicesDirty = false;
+
+	// The dedup bits are keyed by spec index, so rebuild them from the handle lists
+	// Handles of removed abilities are left in the lists (this can happen while they are being iterated), they just no longer resolve to a spec
+	auto RebuildSpecBits = [this, NumSpecs](TBitArray<>& SpecBits, const TArray<FGameplayAbilitySpecHandle>& SpecHandles)
+	{
+		SpecBits.Init(false, NumSpecs);
+		for (const FGameplayAbilitySpecHandle& SpecHandle : SpecHandles)
+		{
+			if (const int32* SpecIndexPtr = SpecHandleToIndex.Find(SpecHandle))
+			{
+				SpecBits[*SpecIndexPtr] = true;
+			}
+		}
+	};
+
+	RebuildSpecBits(InputPressedSpecBits, InputPressedSpecHandles);
+	RebuildSpecBits(InputReleasedSpecBits, InputReleasedSpecHandles);
+	RebuildSpecBits(InputHeldSpecBits, InputHeldSpecHandles);
+	RebuildSpecBits(InputActivateSpecBits, InputAbilitiesToActivate);
+}
+
+void ULyraAbilitySystemComponent::AddUniqueInputSpecHandle(TArray<FGameplayAbilitySpecHandle>& SpecHandles, TBitArray<>& SpecBits, FGameplayAbilitySpecHandle SpecHandle, int32 SpecIndex)
+{
+	if (!SpecBits[SpecIndex])
+	{
+		SpecBits[SpecIndex] = true;
+		SpecHandles.Add(SpecHandle);
+	}
+}
+
 void ULyraAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
 {
 	if (InputTag.IsValid())
 	{
-		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+		if (const TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>* SpecHandles = InputTagToSpecHandles.Find(InputTag))
 		{
-			if (AbilitySpec.Ability && (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag)))
+			for (const FGameplayAbilitySpecHandle& SpecHandle : *SpecHandles)
 			{
-				InputPressedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.AddUnique(AbilitySpec.Handle);
+				int32 SpecIndex = INDEX_NONE;
+				const FGameplayAbilitySpec* AbilitySpec = FindInputAbilitySpec(SpecHandle, /*out*/ SpecIndex);
+				if (AbilitySpec && AbilitySpec->Ability && (AbilitySpec->GetDynamicSpecSourceTags().HasTagExact(InputTag)))
+				{
+					AddUniqueInputSpecHandle(InputPressedSpecHandles, InputPressedSpecBits, SpecHandle, SpecIndex);
+					AddUniqueInputSpecHandle(InputHeldSpecHandles, InputHeldSpecBits, SpecHandle, SpecIndex);
+				}
 			}
 		}
 	}
@@ -202,12 +325,22 @@ void ULyraAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag& In
 {
 	if (InputTag.IsValid())
 	{
-		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities.Items)
+		if (const TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>* SpecHandles = InputTagToSpecHandles.Find(InputTag))
 		{
-			if (AbilitySpec.Ability && (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag)))
+			for (const FGameplayAbilitySpecHandle& SpecHandle : *SpecHandles)
 			{
-				InputReleasedSpecHandles.AddUnique(AbilitySpec.Handle);
-				InputHeldSpecHandles.Remove(AbilitySpec.Handle);
+				int32 SpecIndex = INDEX_NONE;
+				const FGameplayAbilitySpec* AbilitySpec = FindInputAbilitySpec(SpecHandle, /*out*/ SpecIndex);
+				if (AbilitySpec && AbilitySpec->Ability && (AbilitySpec->GetDynamicSpecSourceTags().HasTagExact(InputTag)))
+				{
+					AddUniqueInputSpecHandle(InputReleasedSpecHandles, InputReleasedSpecBits, SpecHandle, SpecIndex);
+
+					if (InputHeldSpecBits[SpecIndex])
+					{
+						InputHeldSpecBits[SpecIndex] = false;
+						InputHeldSpecHandles.RemoveSingle(SpecHandle);
+					}
+				}
 			}
 		}
 	}
@@ -221,24 +354,27 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 		return;
 	}
 
-	static TArray<FGameplayAbilitySpecHandle> AbilitiesToActivate;
-	AbilitiesToActivate.Reset();
+	if ((InputHeldSpecHandles.Num() == 0) && (InputPressedSpecHandles.Num() == 0) && (InputReleasedSpecHandles.Num() == 0))
+	{
+		return;
+	}
 
-	//@TODO: See if we can use FScopedServerAbilityRPCBatcher ScopedRPCBatcher in some of these loops
+	InputAbilitiesToActivate.Reset();
 
 	//
 	// Process all abilities that activate when the input is held.
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputHeldSpecHandles)
 	{
-		if (const FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		int32 SpecIndex = INDEX_NONE;
+		if (const FGameplayAbilitySpec* AbilitySpec = FindInputAbilitySpec(SpecHandle, /*out*/ SpecIndex))
 		{
 			if (AbilitySpec->Ability && !AbilitySpec->IsActive())
 			{
 				const ULyraGameplayAbility* LyraAbilityCDO = Cast<ULyraGameplayAbility>(AbilitySpec->Ability);
 				if (LyraAbilityCDO && LyraAbilityCDO->GetActivationPolicy() == ELyraAbilityActivationPolicy::WhileInputActive)
 				{
-					AbilitiesToActivate.AddUnique(AbilitySpec->Handle);
+					AddUniqueInputSpecHandle(InputAbilitiesToActivate, InputActivateSpecBits, SpecHandle, SpecIndex);
 				}
 			}
 		}
@@ -249,7 +385,8 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputPressedSpecHandles)
 	{
-		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		int32 SpecIndex = INDEX_NONE;
+		if (FGameplayAbilitySpec* AbilitySpec = FindInputAbilitySpec(SpecHandle, /*out*/ SpecIndex))
 		{
 			if (AbilitySpec->Ability)
 			{
@@ -266,7 +403,7 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 
 					if (LyraAbilityCDO && LyraAbilityCDO->GetActivationPolicy() == ELyraAbilityActivationPolicy::OnInputTriggered)
 					{
-						AbilitiesToActivate.AddUnique(AbilitySpec->Handle);
+						AddUniqueInputSpecHandle(InputAbilitiesToActivate, InputActivateSpecBits, SpecHandle, SpecIndex);
 					}
 				}
 			}
@@ -277,18 +414,26 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	// Try to activate all the abilities that are from presses and holds.
 	// We do it all at once so that held inputs don't activate the ability
 	// and then also send a input event to the ability because of the press.
+	// On clients, everything an ability sends to the server while activating (activation, target data and end) goes out as one RPC.
 	//
-	for (const FGameplayAbilitySpecHandle& AbilitySpecHandle : AbilitiesToActivate)
+	for (int32 ActivateIndex = 0; ActivateIndex < InputAbilitiesToActivate.Num(); ++ActivateIndex)
 	{
+		const FGameplayAbilitySpecHandle AbilitySpecHandle = InputAbilitiesToActivate[ActivateIndex];
+
+		FScopedServerAbilityRPCBatcher ScopedRPCBatcher(this, AbilitySpecHandle);
 		TryActivateAbility(AbilitySpecHandle);
 	}
 
+	InputAbilitiesToActivate.Reset();
+	InputActivateSpecBits.SetRange(0, InputActivateSpecBits.Num(), false);
+
 	//
 	// Process all abilities that had their input released this frame.
 	//
 	for (const FGameplayAbilitySpecHandle& SpecHandle : InputReleasedSpecHandles)
 	{
-		if (FGameplayAbilitySpec* AbilitySpec = FindAbilitySpecFromHandle(SpecHandle))
+		int32 SpecIndex = INDEX_NONE;
+		if (FGameplayAbilitySpec* AbilitySpec = FindInputAbilitySpec(SpecHandle, /*out*/ SpecIndex))
 		{
 			if (AbilitySpec->Ability)
 			{
@@ -308,6 +453,8 @@ void ULyraAbilitySystemComponent::ProcessAbilityInput(float DeltaTime, bool bGam
 	//
 	InputPressedSpecHandles.Reset();
 	InputReleasedSpecHandles.Reset();
+	InputPressedSpecBits.SetRange(0, InputPressedSpecBits.Num(), false);
+	InputReleasedSpecBits.SetRange(0, InputReleasedSpecBits.Num(), false);
 }
 
 void ULyraAbilitySystemComponent::ClearAbilityInput()
@@ -315,6 +462,9 @@ void ULyraAbilitySystemComponent::ClearAbilityInput()
 	InputPressedSpecHandles.Reset();
 	InputReleasedSpecHandles.Reset();
 	InputHeldSpecHandles.Reset();
+	InputPressedSpecBits.SetRange(0, InputPressedSpecBits.Num(), false);
+	InputReleasedSpecBits.SetRange(0, InputReleasedSpecBits.Num(), false);
+	InputHeldSpecBits.SetRange(0, InputHeldSpecBits.Num(), false);
 }
 
 void ULyraAbilitySystemComponent::NotifyAbilityActivated(const FGameplayAbilitySpecHandle Handle, UGameplayAbility* Ability)
@@ -394,6 +544,25 @@ void ULyraAbilitySystemComponent::ClientNotifyAbilityFailed_Implementation(const
 	HandleAbilityFailed(Ability, FailureReason);
 }
 
+void ULyraAbilitySystemComponent::MulticastGameplayCueBatch_Implementation(const FLyraGameplayCueBatch& Batch)
+{
+	if (IsRunningDedicatedServer())
+	{
+		return;
+	}
+
+	// The instigator's client already played the batch when it was predicted
+	if (Batch.bPredictedByInstigator && !IsOwnerActorAuthoritative() && AbilityActorInfo.IsValid() && AbilityActorInfo->IsLocallyControlled())
+	{
+		return;
+	}
+
+	if (ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get())
+	{
+		GCM->ExecuteGameplayCueBatch(this, Batch);
+	}
+}
+
 void ULyraAbilitySystemComponent::HandleAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason)
 {
 	//UE_LOG(LogLyraAbilitySystem, Warning, TEXT("Ability %s failed to activate (tags: %s)"), *GetPathNameSafe(Ability), *FailureReason.ToString());
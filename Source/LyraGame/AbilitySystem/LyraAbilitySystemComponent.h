@@ -4,6 +4,7 @@
 
 #include "Abilities/LyraGameplayAbility.h"
 #include "AbilitySystemComponent.h"
+#include "AbilitySystem/LyraGameplayCueBatch.h"
 #include "NativeGameplayTags.h"
 
 #include "LyraAbilitySystemComponent.generated.h"
@@ -72,8 +73,18 @@ public:
 
 	UE_API void TryActivateAbilitiesOnSpawn();
 
+	/** Plays a batch of same-frame gameplay cue executes on all clients, see ULyraGameplayCueManager::AddBatchedGameplayCue */
+	UFUNCTION(NetMulticast, Unreliable)
+	UE_API void MulticastGameplayCueBatch(const FLyraGameplayCueBatch& Batch);
+
 protected:
 
+	//~UAbilitySystemComponent interface
+	UE_API virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	UE_API virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	UE_API virtual bool ShouldDoServerAbilityRPCBatch() const override;
+	//~End of UAbilitySystemComponent interface
+
 	UE_API virtual void AbilitySpecInputPressed(FGameplayAbilitySpec& Spec) override;
 	UE_API virtual void AbilitySpecInputReleased(FGameplayAbilitySpec& Spec) override;
 
@@ -88,6 +99,15 @@ protected:
 	UE_API void ClientNotifyAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
 
 	UE_API void HandleAbilityFailed(const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason);
+
+	// Returns the activatable ability spec for a handle and its index in ActivatableAbilities.Items, using the cached spec indices
+	UE_API FGameplayAbilitySpec* FindInputAbilitySpec(FGameplayAbilitySpecHandle SpecHandle, int32& OutSpecIndex);
+
+	// Rebuilds the cached spec indices (and the input dedup bits that are keyed by them) after abilities were granted, removed, or reordered
+	UE_API void RebuildSpecIndices();
+
+	// Adds a handle to one of the input handle lists unless it is already in it
+	static void AddUniqueInputSpecHandle(TArray<FGameplayAbilitySpecHandle>& SpecHandles, TBitArray<>& SpecBits, FGameplayAbilitySpecHandle SpecHandle, int32 SpecIndex);
 protected:
 
 	// If set, this table is used to look up tag relationships for activate and cancel
@@ -103,6 +123,22 @@ protected:
 	// Handles to abilities that have their input held.
 	TArray<FGameplayAbilitySpecHandle> InputHeldSpecHandles;
 
+	// Handles to abilities to try to activate from input this frame, kept around to avoid reallocating it every frame.
+	TArray<FGameplayAbilitySpecHandle> InputAbilitiesToActivate;
+
+	// Which abilities (by spec index) are in each of the input handle lists, so adding to them doesn't need a search.
+	TBitArray<> InputPressedSpecBits;
+	TBitArray<> InputReleasedSpecBits;
+	TBitArray<> InputHeldSpecBits;
+	TBitArray<> InputActivateSpecBits;
+
+	// Handles of the granted abilities with each dynamic source tag (input tags are granted this way), maintained as abilities are granted and removed.
+	TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>> InputTagToSpecHandles;
+
+	// Index of each granted ability in ActivatableAbilities.Items, rebuilt lazily when bSpecIndicesDirty is set.
+	TMap<FGameplayAbilitySpecHandle, int32> SpecHandleToIndex;
+	bool bSpecIndicesDirty = true;
+
 	// Number of abilities running in each activation group.
 	int32 ActivationGroupCounts[(uint8)ELyraAbilityActivationGroup::MAX];
 };
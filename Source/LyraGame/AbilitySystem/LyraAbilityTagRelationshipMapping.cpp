@@ -5,21 +5,91 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAbilityTagRelationshipMapping)
 
+void ULyraAbilityTagRelationshipMapping::PostLoad()
+{
+	Super::PostLoad();
+
+	CompileRelationships();
+}
+
+#if WITH_EDITOR
+void ULyraAbilityTagRelationshipMapping::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompileRelationships();
+}
+#endif
+
+void ULyraAbilityTagRelationshipMapping::CompileRelationships() const
+{
+	CompiledRelationships.Reset();
+	ResolvedRelationships.Reset();
+
+	for (const FLyraAbilityTagRelationship& Tags : AbilityTagRelationships)
+	{
+		if (!Tags.AbilityTag.IsValid())
+		{
+			continue;
+		}
+
+		FCompiledRelationship& Compiled = CompiledRelationships.FindOrAdd(Tags.AbilityTag);
+		Compiled.AbilityTagsToBlock.AppendTags(Tags.AbilityTagsToBlock);
+		Compiled.AbilityTagsToCancel.AppendTags(Tags.AbilityTagsToCancel);
+		Compiled.ActivationRequiredTags.AppendTags(Tags.ActivationRequiredTags);
+		Compiled.ActivationBlockedTags.AppendTags(Tags.ActivationBlockedTags);
+	}
+
+	bRelationshipsCompiled = true;
+}
+
+const ULyraAbilityTagRelationshipMapping::FCompiledRelationship* ULyraAbilityTagRelationshipMapping::ResolveRelationships(const FGameplayTag& AbilityTag) const
+{
+	if (!bRelationshipsCompiled)
+	{
+		CompileRelationships();
+	}
+
+	if (const TSharedPtr<const FCompiledRelationship>* ResolvedPtr = ResolvedRelationships.Find(AbilityTag))
+	{
+		return ResolvedPtr->Get();
+	}
+
+	// A relationship applies to an ability tag if it was authored for the tag itself or any of its parents (matching FGameplayTagContainer::HasTag)
+	TSharedPtr<FCompiledRelationship> Resolved;
+	for (FGameplayTag Tag = AbilityTag; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	{
+		if (const FCompiledRelationship* Compiled = CompiledRelationships.Find(Tag))
+		{
+			if (!Resolved.IsValid())
+			{
+				Resolved = MakeShared<FCompiledRelationship>();
+			}
+
+			Resolved->AbilityTagsToBlock.AppendTags(Compiled->AbilityTagsToBlock);
+			Resolved->AbilityTagsToCancel.AppendTags(Compiled->AbilityTagsToCancel);
+			Resolved->ActivationRequiredTags.AppendTags(Compiled->ActivationRequiredTags);
+			Resolved->ActivationBlockedTags.AppendTags(Compiled->ActivationBlockedTags);
+		}
+	}
+
+	ResolvedRelationships.Add(AbilityTag, Resolved);
+	return Resolved.Get();
+}
+
 void ULyraAbilityTagRelationshipMapping::GetAbilityTagsToBlockAndCancel(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutTagsToBlock, FGameplayTagContainer* OutTagsToCancel) const
 {
-	// Simple iteration for now
-	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
+	for (const FGameplayTag& AbilityTag : AbilityTags)
 	{
-		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
-		if (AbilityTags.HasTag(Tags.AbilityTag))
+		if (const FCompiledRelationship* Relationship = ResolveRelationships(AbilityTag))
 		{
 			if (OutTagsToBlock)
 			{
-				OutTagsToBlock->AppendTags(Tags.AbilityTagsToBlock);
+				OutTagsToBlock->AppendTags(Relationship->AbilityTagsToBlock);
 			}
 			if (OutTagsToCancel)
 			{
-				OutTagsToCancel->AppendTags(Tags.AbilityTagsToCancel);
+				OutTagsToCancel->AppendTags(Relationship->AbilityTagsToCancel);
 			}
 		}
 	}
@@ -27,19 +97,17 @@ void ULyraAbilityTagRelationshipMapping::GetAbilityTagsToBlockAndCancel(const FG
 
 void ULyraAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutActivationRequired, FGameplayTagContainer* OutActivationBlocked) const
 {
-	// Simple iteration for now
-	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
+	for (const FGameplayTag& AbilityTag : AbilityTags)
 	{
-		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
-		if (AbilityTags.HasTag(Tags.AbilityTag))
+		if (const FCompiledRelationship* Relationship = ResolveRelationships(AbilityTag))
 		{
 			if (OutActivationRequired)
 			{
-				OutActivationRequired->AppendTags(Tags.ActivationRequiredTags);
+				OutActivationRequired->AppendTags(Relationship->ActivationRequiredTags);
 			}
 			if (OutActivationBlocked)
 			{
-				OutActivationBlocked->AppendTags(Tags.ActivationBlockedTags);
+				OutActivationBlocked->AppendTags(Relationship->ActivationBlockedTags);
 			}
 		}
 	}
@@ -47,17 +115,16 @@ void ULyraAbilityTagRelationshipMapping::GetRequiredAndBlockedActivationTags(con
 
 bool ULyraAbilityTagRelationshipMapping::IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const
 {
-	// Simple iteration for now
-	for (int32 i = 0; i < AbilityTagRelationships.Num(); i++)
+	if (!bRelationshipsCompiled)
 	{
-		const FLyraAbilityTagRelationship& Tags = AbilityTagRelationships[i];
+		CompileRelationships();
+	}
 
-		if (Tags.AbilityTag == ActionTag && Tags.AbilityTagsToCancel.HasAny(AbilityTags))
-		{
-			return true;
-		}
+	// Only relationships authored for exactly this action tag apply here
+	if (const FCompiledRelationship* Compiled = CompiledRelationships.Find(ActionTag))
+	{
+		return Compiled->AbilityTagsToCancel.HasAny(AbilityTags);
 	}
 
 	return false;
 }
-
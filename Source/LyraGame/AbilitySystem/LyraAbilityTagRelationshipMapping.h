@@ -48,7 +48,37 @@ private:
 	UPROPERTY(EditAnywhere, Category = Ability, meta=(TitleProperty="AbilityTag"))
 	TArray<FLyraAbilityTagRelationship> AbilityTagRelationships;
 
+	/** All the relationships of a single tag merged together */
+	struct FCompiledRelationship
+	{
+		FGameplayTagContainer AbilityTagsToBlock;
+		FGameplayTagContainer AbilityTagsToCancel;
+		FGameplayTagContainer ActivationRequiredTags;
+		FGameplayTagContainer ActivationBlockedTags;
+	};
+
+	/** Relationships by the exact AbilityTag they were authored for, compiled from AbilityTagRelationships */
+	mutable TMap<FGameplayTag, FCompiledRelationship> CompiledRelationships;
+
+	/** Relationships that apply to an ability tag (those of the tag and all of its parents), resolved the first time the tag is looked up. Null when none apply */
+	mutable TMap<FGameplayTag, TSharedPtr<const FCompiledRelationship>> ResolvedRelationships;
+
+	mutable bool bRelationshipsCompiled = false;
+
+	/** Compiles AbilityTagRelationships into CompiledRelationships and clears the resolved tags */
+	void CompileRelationships() const;
+
+	/** Returns the merged relationships that apply to an ability tag, or null if there are none */
+	const FCompiledRelationship* ResolveRelationships(const FGameplayTag& AbilityTag) const;
+
 public:
+	//~UObject interface
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~End of UObject interface
+
 	/** Given a set of ability tags, parse the tag relationship and fill out tags to block and cancel */
 	void GetAbilityTagsToBlockAndCancel(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer* OutTagsToBlock, FGameplayTagContainer* OutTagsToCancel) const;
 
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/NetSerialization.h"
+#include "GameplayTagContainer.h"
+
+#include "LyraGameplayCueBatch.generated.h"
+
+class AActor;
+class UObject;
+class UPhysicalMaterial;
+
+/**
+ * FLyraGameplayCueBatch
+ *
+ * Every execute of one gameplay cue from one instigator in a single frame (e.g., the pellets of a shotgun
+ * blast or the targets of a melee sweep), merged into a single multi-hit payload.
+ * The per-impact data is kept as compact parallel arrays, so a batch is sent with one RPC and its impact
+ * effects can be spawned in one pass by the cue notify (see ULyraGameplayCueManager::GetBatchedImpacts).
+ */
+USTRUCT()
+struct FLyraGameplayCueBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag CueTag;
+
+	UPROPERTY()
+	TObjectPtr<AActor> Instigator = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<AActor> EffectCauser = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<const UObject> SourceObject = nullptr;
+
+	// Impact locations and normals, one entry per merged execute
+	UPROPERTY()
+	TArray<FVector_NetQuantize> ImpactPoints;
+
+	UPROPERTY()
+	TArray<FVector_NetQuantizeNormal> ImpactNormals;
+
+	// Physical material of each impact, empty if none of the impacts had one
+	UPROPERTY()
+	TArray<TObjectPtr<const UPhysicalMaterial>> PhysicalMaterials;
+
+	// Set when the instigator's client already played the batch locally, so it skips the replicated one
+	UPROPERTY()
+	bool bPredictedByInstigator = false;
+
+	int32 Num() const { return ImpactPoints.Num(); }
+};
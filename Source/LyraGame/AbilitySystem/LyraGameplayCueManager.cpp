@@ -7,7 +7,14 @@
 #include "AbilitySystemGlobals.h"
 #include "GameplayTagsManager.h"
 #include "UObject/UObjectThreadContext.h"
+#include "UObject/PropertyIterator.h"
 #include "Async/Async.h"
+#include "GameplayEffect.h"
+#include "LyraAbilitySet.h"
+#include "LyraAbilitySystemComponent.h"
+#include "LyraGameplayEffectContext.h"
+#include "Engine/World.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayCueManager)
 
@@ -35,6 +42,23 @@ namespace LyraGameplayCueManagerCvars
 		FConsoleCommandWithArgsDelegate::CreateStatic(ULyraGameplayCueManager::DumpGameplayCues));
 
 	static ELyraEditorLoadMode LoadMode = ELyraEditorLoadMode::LoadUpfront;
+
+	static int32 MaxPredictedCues = 64;
+	static FAutoConsoleVariableRef CVarMaxPredictedCues(
+		TEXT("Lyra.GameplayCues.MaxPredictedCues"),
+		MaxPredictedCues,
+		TEXT("Number of predictively preloaded cues to keep in memory, beyond this the least recently referenced cues without a live owner are evicted"),
+		ECVF_Default);
+
+	static int32 MaxImpactsPerCueBatch = 32;
+	static FAutoConsoleVariableRef CVarMaxImpactsPerCueBatch(
+		TEXT("Lyra.GameplayCues.MaxImpactsPerBatch"),
+		MaxImpactsPerCueBatch,
+		TEXT("Maximum number of impacts merged into a batched cue execute, further executes of the cue in the same frame start another batch"),
+		ECVF_Default);
+
+	// Below the priority of experience loads and cues that are missing when invoked
+	static const TAsyncLoadPriority PredictedCueLoadPriority = FStreamableManager::DefaultAsyncLoadPriority - 1;
 }
 
 const bool bPreloadEvenInEditor = true;
@@ -66,6 +90,8 @@ void ULyraGameplayCueManager::OnCreated()
 	Super::OnCreated();
 
 	UpdateDelayLoadDelegateListeners();
+
+	FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::FlushBatchedGameplayCues);
 }
 
 void ULyraGameplayCueManager::LoadAlwaysLoadedCues()
@@ -156,13 +182,19 @@ void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 		}
 	}
 
+	UE_LOG(LogLyra, Log, TEXT("=========== Dumping Predicted Gameplay Cue Notifies ==========="));
+	for (const TPair<FSoftObjectPath, FPredictedCue>& Pair : GCM->PredictedCues)
+	{
+		UE_LOG(LogLyra, Log, TEXT("  %s (%d owners%s)"), *Pair.Key.ToString(), Pair.Value.Owners.Num(), Pair.Value.bLoading ? TEXT(", loading") : TEXT(""));
+	}
+
 	UE_LOG(LogLyra, Log, TEXT("=========== Dumping Gameplay Cue Notifies loaded on demand ==========="));
 	int32 NumMissingCuesLoaded = 0;
 	if (GCM->RuntimeGameplayCueObjectLibrary.CueSet)
 	{
 		for (const FGameplayCueNotifyData& CueData : GCM->RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData)
 		{
-			if (CueData.LoadedGameplayCueClass && !GCM->AlwaysLoadedCues.Contains(CueData.LoadedGameplayCueClass) && !GCM->PreloadedCues.Contains(CueData.LoadedGameplayCueClass))
+			if (CueData.LoadedGameplayCueClass && !GCM->AlwaysLoadedCues.Contains(CueData.LoadedGameplayCueClass) && !GCM->PreloadedCues.Contains(CueData.LoadedGameplayCueClass) && !GCM->PredictedCueClasses.Contains(CueData.LoadedGameplayCueClass))
 			{
 				NumMissingCuesLoaded++;
 				UE_LOG(LogLyra, Log, TEXT("  %s"), *CueData.LoadedGameplayCueClass->GetPathName());
@@ -173,8 +205,9 @@ void ULyraGameplayCueManager::DumpGameplayCues(const TArray<FString>& Args)
 	UE_LOG(LogLyra, Log, TEXT("=========== Gameplay Cue Notify summary ==========="));
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in always loaded list"), GCM->AlwaysLoadedCues.Num());
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in preloaded list"), GCM->PreloadedCues.Num());
+	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in predicted list"), GCM->PredictedCueClasses.Num());
 	UE_LOG(LogLyra, Log, TEXT("  ... %d cues loaded on demand"), NumMissingCuesLoaded);
-	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in total"), GCM->AlwaysLoadedCues.Num() + GCM->PreloadedCues.Num() + NumMissingCuesLoaded);
+	UE_LOG(LogLyra, Log, TEXT("  ... %d cues in total"), GCM->AlwaysLoadedCues.Num() + GCM->PreloadedCues.Num() + GCM->PredictedCueClasses.Num() + NumMissingCuesLoaded);
 }
 
 void ULyraGameplayCueManager::OnGameplayTagLoaded(const FGameplayTag& Tag)
@@ -331,8 +364,16 @@ void ULyraGameplayCueManager::HandlePostLoadMap(UWorld* NewWorld)
 		{
 			RuntimeGameplayCueObjectLibrary.CueSet->RemoveLoadedClass(CueClass);
 		}
+
+		for (UClass* CueClass : PredictedCueClasses)
+		{
+			RuntimeGameplayCueObjectLibrary.CueSet->RemoveLoadedClass(CueClass);
+		}
 	}
 
+	// Owners from the previous map are gone, let go of everything they predicted
+	EvictPredictedCues(/*bEvictAllUnreferenced=*/ true);
+
 	for (auto CueIt = PreloadedCues.CreateIterator(); CueIt; ++CueIt)
 	{
 		TSet<FObjectKey>& ReferencerSet = PreloadedCueReferencers.FindChecked(*CueIt);
@@ -384,10 +425,402 @@ bool ULyraGameplayCueManager::ShouldDelayLoadGameplayCues() const
 	return !IsRunningDedicatedServer() && bClientDelayLoadGameplayCues;
 }
 
+bool ULyraGameplayCueManager::ShouldPreloadReferencedCues() const
+{
+	switch (LyraGameplayCueManagerCvars::LoadMode)
+	{
+	case ELyraEditorLoadMode::LoadUpfront:
+		return false;
+	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced_GameOnly:
+#if WITH_EDITOR
+		if (GIsEditor)
+		{
+			return false;
+		}
+#endif
+		break;
+	case ELyraEditorLoadMode::PreloadAsCuesAreReferenced:
+		break;
+	}
+
+	return ShouldDelayLoadGameplayCues() && (RuntimeGameplayCueObjectLibrary.CueSet != nullptr);
+}
+
+void ULyraGameplayCueManager::PreloadCuesForAbilitySet(const ULyraAbilitySet* AbilitySet, const UObject* Owner)
+{
+	if ((AbilitySet == nullptr) || (Owner == nullptr) || !ShouldPreloadReferencedCues())
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULyraGameplayCueManager_PreloadCuesForAbilitySet);
+
+	TArray<const UClass*> GrantedClasses;
+	AbilitySet->GetGrantedAbilityAndEffectClasses(/*out*/ GrantedClasses);
+
+	FGameplayTagContainer CueTags;
+	for (const UClass* GrantedClass : GrantedClasses)
+	{
+		CueTags.AppendTags(GetReferencedCueTags(GrantedClass));
+	}
+
+	for (const FGameplayTag& CueTag : CueTags)
+	{
+		PreloadPredictedCue(CueTag, Owner);
+	}
+
+	EvictPredictedCues(/*bEvictAllUnreferenced=*/ false);
+}
+
+const FGameplayTagContainer& ULyraGameplayCueManager::GetReferencedCueTags(const UClass* Class)
+{
+	if (const FGameplayTagContainer* CachedTags = ReferencedCueTagsByClass.Find(Class))
+	{
+		return *CachedTags;
+	}
+
+	// Added before walking so classes that reference each other terminate
+	ReferencedCueTagsByClass.Add(Class);
+
+	FGameplayTagContainer CueTags;
+	const FGameplayTag BaseCueTag = UGameplayCueSet::BaseGameplayCueTag();
+	const UObject* ClassDefaultObject = Class->GetDefaultObject();
+
+	// Finds the cue tags held by the defaults (including the GameplayCues of gameplay effects), and the effect classes they reference (e.g., cost and cooldown)
+	TArray<const UClass*> ReferencedEffectClasses;
+	for (TPropertyValueIterator<FProperty> It(Class, ClassDefaultObject); It; ++It)
+	{
+		const FProperty* Property = It.Key();
+		if (Property->HasAnyPropertyFlags(CPF_Transient))
+		{
+			// e.g., the ParentTags of a tag container
+			It.SkipRecursiveProperty();
+			continue;
+		}
+
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (StructProperty->Struct == FGameplayTag::StaticStruct())
+			{
+				const FGameplayTag& Tag = *static_cast<const FGameplayTag*>(It.Value());
+				if (Tag.MatchesTag(BaseCueTag) && (Tag != BaseCueTag))
+				{
+					CueTags.AddTag(Tag);
+				}
+			}
+		}
+		else if (const FClassProperty* ClassProperty = CastField<FClassProperty>(Property))
+		{
+			const UClass* ReferencedClass = Cast<UClass>(ClassProperty->GetObjectPropertyValue(It.Value()));
+			if (ReferencedClass && (ReferencedClass != Class) && ReferencedClass->IsChildOf<UGameplayEffect>())
+			{
+				ReferencedEffectClasses.AddUnique(ReferencedClass);
+			}
+		}
+	}
+
+	for (const UClass* ReferencedEffectClass : ReferencedEffectClasses)
+	{
+		CueTags.AppendTags(GetReferencedCueTags(ReferencedEffectClass));
+	}
+
+	// Found again as the map may have grown while recursing
+	FGameplayTagContainer& CachedTags = ReferencedCueTagsByClass.FindChecked(Class);
+	CachedTags = MoveTemp(CueTags);
+	return CachedTags;
+}
+
+void ULyraGameplayCueManager::PreloadPredictedCue(const FGameplayTag& Tag, const UObject* Owner)
+{
+	check(RuntimeGameplayCueObjectLibrary.CueSet);
+
+	// Cues are handled by the closest notify up the tag hierarchy
+	const int32* DataIdx = nullptr;
+	for (FGameplayTag SearchTag = Tag; SearchTag.IsValid() && (DataIdx == nullptr); SearchTag = SearchTag.RequestDirectParent())
+	{
+		DataIdx = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueDataMap.Find(SearchTag);
+	}
+
+	if ((DataIdx == nullptr) || !RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData.IsValidIndex(*DataIdx))
+	{
+		return;
+	}
+
+	const FSoftObjectPath CuePath = RuntimeGameplayCueObjectLibrary.CueSet->GameplayCueData[*DataIdx].GameplayCueNotifyObj;
+	if (CuePath.IsNull())
+	{
+		return;
+	}
+
+	FPredictedCue& PredictedCue = PredictedCues.FindOrAdd(CuePath);
+	PredictedCue.Owners.Add(FObjectKey(Owner));
+	PredictedCue.LastReferencedSerial = ++PredictedCueSerial;
+
+	if ((PredictedCue.LoadedClass != nullptr) || PredictedCue.bLoading)
+	{
+		return;
+	}
+
+	if (UClass* LoadedGameplayCueClass = FindObject<UClass>(nullptr, *CuePath.ToString()))
+	{
+		PredictedCue.LoadedClass = LoadedGameplayCueClass;
+		PredictedCueClasses.Add(LoadedGameplayCueClass);
+	}
+	else
+	{
+		PredictedCue.bLoading = true;
+		StreamableManager.RequestAsyncLoad(CuePath, FStreamableDelegate::CreateUObject(this, &ThisClass::OnPredictedCueLoaded, CuePath), LyraGameplayCueManagerCvars::PredictedCueLoadPriority, false, false, TEXT("PredictedGameplayCue"));
+	}
+}
+
+void ULyraGameplayCueManager::OnPredictedCueLoaded(FSoftObjectPath Path)
+{
+	FPredictedCue* PredictedCue = PredictedCues.Find(Path);
+	if (PredictedCue == nullptr)
+	{
+		// Evicted while loading
+		return;
+	}
+
+	PredictedCue->bLoading = false;
+	if (UClass* LoadedGameplayCueClass = Cast<UClass>(Path.ResolveObject()))
+	{
+		PredictedCue->LoadedClass = LoadedGameplayCueClass;
+		PredictedCueClasses.Add(LoadedGameplayCueClass);
+	}
+}
+
+void ULyraGameplayCueManager::EvictPredictedCues(bool bEvictAllUnreferenced)
+{
+	const int32 MaxPredictedCues = bEvictAllUnreferenced ? 0 : FMath::Max(LyraGameplayCueManagerCvars::MaxPredictedCues, 0);
+	if (PredictedCues.Num() <= MaxPredictedCues)
+	{
+		return;
+	}
+
+	// Only cues that no live owner can trigger are candidates, least recently referenced first
+	TArray<TPair<uint64, FSoftObjectPath>> EvictionCandidates;
+	for (TPair<FSoftObjectPath, FPredictedCue>& Pair : PredictedCues)
+	{
+		for (auto OwnerIt = Pair.Value.Owners.CreateIterator(); OwnerIt; ++OwnerIt)
+		{
+			if (!OwnerIt->ResolveObjectPtr())
+			{
+				OwnerIt.RemoveCurrent();
+			}
+		}
+
+		if (Pair.Value.Owners.Num() == 0)
+		{
+			EvictionCandidates.Emplace(Pair.Value.LastReferencedSerial, Pair.Key);
+		}
+	}
+
+	EvictionCandidates.Sort([](const TPair<uint64, FSoftObjectPath>& A, const TPair<uint64, FSoftObjectPath>& B) { return A.Key < B.Key; });
+
+	for (const TPair<uint64, FSoftObjectPath>& Candidate : EvictionCandidates)
+	{
+		if (PredictedCues.Num() <= MaxPredictedCues)
+		{
+			break;
+		}
+
+		EvictPredictedCue(Candidate.Value);
+	}
+}
+
+void ULyraGameplayCueManager::EvictPredictedCue(const FSoftObjectPath& Path)
+{
+	FPredictedCue PredictedCue;
+	if (!PredictedCues.RemoveAndCopyValue(Path, /*out*/ PredictedCue) || (PredictedCue.LoadedClass == nullptr))
+	{
+		return;
+	}
+
+	PredictedCueClasses.Remove(PredictedCue.LoadedClass);
+
+	// Let the class be collected unless it is also held for another reason
+	if (RuntimeGameplayCueObjectLibrary.CueSet && !AlwaysLoadedCues.Contains(PredictedCue.LoadedClass) && !PreloadedCues.Contains(PredictedCue.LoadedClass))
+	{
+		RuntimeGameplayCueObjectLibrary.CueSet->RemoveLoadedClass(PredictedCue.LoadedClass);
+	}
+}
+
 const FPrimaryAssetType UFortAssetManager_GameplayCueRefsType = TEXT("GameplayCueRefs");
 const FName UFortAssetManager_GameplayCueRefsName = TEXT("GameplayCueReferences");
 const FName UFortAssetManager_LoadStateClient = FName(TEXT("Client"));
 
+void ULyraGameplayCueManager::AddBatchedGameplayCue(ULyraAbilitySystemComponent* ASC, const FGameplayTag& CueTag, const FGameplayCueParameters& Parameters, bool bPredicted)
+{
+	check(ASC);
+
+	if (!CueTag.IsValid())
+	{
+		return;
+	}
+
+	// Only the authority sends batches, clients just play the ones they predicted
+	if (!bPredicted && !ASC->IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+
+	// Full batches are left as they are, the impacts past the limit go into another batch sent in the same frame
+	const int32 MaxImpactsPerBatch = FMath::Max(LyraGameplayCueManagerCvars::MaxImpactsPerCueBatch, 1);
+	FPendingCueBatch* PendingBatch = PendingCueBatches.FindByPredicate([ASC, &CueTag, MaxImpactsPerBatch](const FPendingCueBatch& Pending)
+		{
+			return (Pending.ASC.Get() == ASC) && (Pending.Batch.CueTag == CueTag) && (Pending.Batch.Num() < MaxImpactsPerBatch);
+		});
+
+	if (PendingBatch == nullptr)
+	{
+		PendingBatch = &PendingCueBatches.AddDefaulted_GetRef();
+		PendingBatch->ASC = ASC;
+		PendingBatch->Batch.CueTag = CueTag;
+		PendingBatch->Batch.Instigator = Parameters.GetInstigator();
+		PendingBatch->Batch.EffectCauser = Parameters.GetEffectCauser();
+		PendingBatch->Batch.SourceObject = Parameters.GetSourceObject();
+	}
+
+	FLyraGameplayCueBatch& Batch = PendingBatch->Batch;
+	Batch.bPredictedByInstigator |= bPredicted;
+
+	if (const FHitResult* HitResult = Parameters.EffectContext.GetHitResult())
+	{
+		Batch.ImpactPoints.Add(HitResult->ImpactPoint);
+		Batch.ImpactNormals.Add(HitResult->ImpactNormal);
+		Batch.PhysicalMaterials.Add(HitResult->PhysMaterial.Get());
+	}
+	else
+	{
+		Batch.ImpactPoints.Add(Parameters.Location);
+		Batch.ImpactNormals.Add(Parameters.Normal);
+		Batch.PhysicalMaterials.Add(Parameters.PhysicalMaterial.Get());
+	}
+}
+
+void ULyraGameplayCueManager::FlushBatchedGameplayCues(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (PendingCueBatches.Num() == 0)
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULyraGameplayCueManager_FlushBatchedGameplayCues);
+
+	// Pull out this world's batches first, playing them can queue more
+	TArray<FPendingCueBatch> BatchesToFlush;
+	for (auto It = PendingCueBatches.CreateIterator(); It; ++It)
+	{
+		const ULyraAbilitySystemComponent* ASC = It->ASC.Get();
+		if (ASC == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+		else if (ASC->GetWorld() == World)
+		{
+			BatchesToFlush.Add(MoveTemp(*It));
+			It.RemoveCurrent();
+		}
+	}
+
+	for (FPendingCueBatch& PendingBatch : BatchesToFlush)
+	{
+		ULyraAbilitySystemComponent* ASC = PendingBatch.ASC.Get();
+		FLyraGameplayCueBatch& Batch = PendingBatch.Batch;
+
+		// Don't send a null per impact when nothing was hit with a physical material
+		if (!Batch.PhysicalMaterials.ContainsByPredicate([](const UPhysicalMaterial* PhysicalMaterial) { return PhysicalMaterial != nullptr; }))
+		{
+			Batch.PhysicalMaterials.Reset();
+		}
+
+		if (ASC->IsOwnerActorAuthoritative())
+		{
+			ASC->MulticastGameplayCueBatch(Batch);
+		}
+		else
+		{
+			ExecuteGameplayCueBatch(ASC, Batch);
+		}
+	}
+}
+
+void ULyraGameplayCueManager::ExecuteGameplayCueBatch(ULyraAbilitySystemComponent* ASC, const FLyraGameplayCueBatch& Batch)
+{
+	if ((ASC == nullptr) || (Batch.Num() == 0) || (Batch.ImpactNormals.Num() != Batch.Num()))
+	{
+		return;
+	}
+
+	// Cues play on the avatar (e.g., the pawn rather than the player state that owns the component), like regular replicated cue events
+	AActor* AvatarActor = ASC->AbilityActorInfo.IsValid() ? ASC->AbilityActorInfo->AvatarActor.Get() : nullptr;
+	if (AvatarActor == nullptr)
+	{
+		return;
+	}
+
+	FGameplayEffectContextHandle EffectContext(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+	EffectContext.AddInstigator(Batch.Instigator, Batch.EffectCauser);
+	EffectContext.AddSourceObject(Batch.SourceObject);
+	if (FLyraGameplayEffectContext* LyraEffectContext = FLyraGameplayEffectContext::ExtractEffectContext(EffectContext))
+	{
+		LyraEffectContext->SetCueBatch(MakeShared<FLyraGameplayCueBatch>(Batch));
+	}
+
+	// The first impact doubles as the cue location, so notifies that don't know about batches still play once
+	FGameplayCueParameters Parameters;
+	Parameters.EffectContext = EffectContext;
+	Parameters.Instigator = Batch.Instigator;
+	Parameters.EffectCauser = Batch.EffectCauser;
+	Parameters.SourceObject = Batch.SourceObject;
+	Parameters.Location = Batch.ImpactPoints[0];
+	Parameters.Normal = Batch.ImpactNormals[0];
+	Parameters.PhysicalMaterial = Batch.PhysicalMaterials.IsValidIndex(0) ? Batch.PhysicalMaterials[0] : nullptr;
+
+	HandleGameplayCue(AvatarActor, Batch.CueTag, EGameplayCueEvent::Executed, Parameters);
+}
+
+int32 ULyraGameplayCueManager::GetBatchedImpacts(const FGameplayCueParameters& Parameters, TArray<FVector>& OutLocations, TArray<FVector>& OutNormals, TArray<UPhysicalMaterial*>& OutPhysicalMaterials)
+{
+	OutLocations.Reset();
+	OutNormals.Reset();
+	OutPhysicalMaterials.Reset();
+
+	const FLyraGameplayEffectContext* LyraEffectContext = FLyraGameplayEffectContext::ExtractEffectContext(Parameters.EffectContext);
+	if (const FLyraGameplayCueBatch* Batch = LyraEffectContext ? LyraEffectContext->GetCueBatch() : nullptr)
+	{
+		const int32 NumImpacts = Batch->Num();
+		OutLocations.Reserve(NumImpacts);
+		OutNormals.Reserve(NumImpacts);
+		OutPhysicalMaterials.Reserve(NumImpacts);
+
+		for (int32 ImpactIndex = 0; ImpactIndex < NumImpacts; ++ImpactIndex)
+		{
+			OutLocations.Add(Batch->ImpactPoints[ImpactIndex]);
+			OutNormals.Add(Batch->ImpactNormals[ImpactIndex]);
+			OutPhysicalMaterials.Add(Batch->PhysicalMaterials.IsValidIndex(ImpactIndex) ? const_cast<UPhysicalMaterial*>(Batch->PhysicalMaterials[ImpactIndex].Get()) : nullptr);
+		}
+
+		return NumImpacts;
+	}
+
+	if (const FHitResult* HitResult = Parameters.EffectContext.GetHitResult())
+	{
+		OutLocations.Add(HitResult->ImpactPoint);
+		OutNormals.Add(HitResult->ImpactNormal);
+		OutPhysicalMaterials.Add(HitResult->PhysMaterial.Get());
+	}
+	else
+	{
+		OutLocations.Add(Parameters.Location);
+		OutNormals.Add(Parameters.Normal);
+		OutPhysicalMaterials.Add(const_cast<UPhysicalMaterial*>(Parameters.PhysicalMaterial.Get()));
+	}
+
+	return 1;
+}
+
 void ULyraGameplayCueManager::RefreshGameplayCuePrimaryAsset()
 {
 	TArray<FSoftObjectPath> CuePaths;
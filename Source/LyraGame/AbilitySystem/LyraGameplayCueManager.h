@@ -3,10 +3,15 @@
 #pragma once
 
 #include "GameplayCueManager.h"
+#include "AbilitySystem/LyraGameplayCueBatch.h"
+#include "Engine/EngineBaseTypes.h"
 
 #include "LyraGameplayCueManager.generated.h"
 
 class FString;
+class ULyraAbilitySet;
+class ULyraAbilitySystemComponent;
+class UPhysicalMaterial;
 class UClass;
 class UObject;
 class UWorld;
@@ -42,6 +47,20 @@ public:
 	// Updates the bundles for the singular gameplay cue primary asset
 	void RefreshGameplayCuePrimaryAsset();
 
+	// Streams in (at low priority) the cues that the abilities and effects of an ability set reference, kept loaded while Owner is alive
+	void PreloadCuesForAbilitySet(const ULyraAbilitySet* AbilitySet, const UObject* Owner);
+
+	// Queues a cue execute to be merged with the other executes of the same cue on the same ability system component this frame
+	// Batches are sent with a single multicast by the authority, predicted batches are also played right away by the predicting client
+	void AddBatchedGameplayCue(ULyraAbilitySystemComponent* ASC, const FGameplayTag& CueTag, const FGameplayCueParameters& Parameters, bool bPredicted);
+
+	// Plays a batch on the ability system component's avatar as a single execute carrying every impact
+	void ExecuteGameplayCueBatch(ULyraAbilitySystemComponent* ASC, const FLyraGameplayCueBatch& Batch);
+
+	// Returns every impact of a batched cue execute (or the single impact of a regular one), so a notify can spawn them all in one pass
+	UFUNCTION(BlueprintPure, Category = "Lyra|GameplayCue")
+	static int32 GetBatchedImpacts(const FGameplayCueParameters& Parameters, TArray<FVector>& OutLocations, TArray<FVector>& OutNormals, TArray<UPhysicalMaterial*>& OutPhysicalMaterials);
+
 private:
 	void OnGameplayTagLoaded(const FGameplayTag& Tag);
 	void HandlePostGarbageCollect();
@@ -52,6 +71,19 @@ private:
 	void HandlePostLoadMap(UWorld* NewWorld);
 	void UpdateDelayLoadDelegateListeners();
 	bool ShouldDelayLoadGameplayCues() const;
+	bool ShouldPreloadReferencedCues() const;
+
+	// Returns the cue tags referenced by a class (its defaults, and any gameplay effect classes it references), cached per class
+	const FGameplayTagContainer& GetReferencedCueTags(const UClass* Class);
+	void PreloadPredictedCue(const FGameplayTag& Tag, const UObject* Owner);
+	void OnPredictedCueLoaded(FSoftObjectPath Path);
+
+	// Evicts the least recently referenced predicted cues without a live owner until there are no more than Lyra.GameplayCues.MaxPredictedCues
+	void EvictPredictedCues(bool bEvictAllUnreferenced);
+	void EvictPredictedCue(const FSoftObjectPath& Path);
+
+	// Sends or plays the batches of a world once its actors have ticked
+	void FlushBatchedGameplayCues(UWorld* World, ELevelTick TickType, float DeltaSeconds);
 
 private:
 	struct FLoadedGameplayTagToProcessData
@@ -63,6 +95,26 @@ private:
 		FLoadedGameplayTagToProcessData(const FGameplayTag& InTag, const TWeakObjectPtr<UObject>& InWeakOwner) : Tag(InTag), WeakOwner(InWeakOwner) {}
 	};
 
+	struct FPredictedCue
+	{
+		// Objects the cue was predicted for, it can be evicted once none of them are alive
+		TSet<FObjectKey> Owners;
+
+		// The loaded class (also held by PredictedCueClasses), null while loading
+		UClass* LoadedClass = nullptr;
+
+		// PredictedCueSerial when the cue was last referenced
+		uint64 LastReferencedSerial = 0;
+
+		bool bLoading = false;
+	};
+
+	struct FPendingCueBatch
+	{
+		TWeakObjectPtr<ULyraAbilitySystemComponent> ASC;
+		FLyraGameplayCueBatch Batch;
+	};
+
 private:
 	// Cues that were preloaded on the client due to being referenced by content
 	UPROPERTY(transient)
@@ -73,6 +125,18 @@ private:
 	UPROPERTY(transient)
 	TSet<TObjectPtr<UClass>> AlwaysLoadedCues;
 
+	// Cues that were preloaded on the client because something that can trigger them was granted or equipped
+	UPROPERTY(transient)
+	TSet<TObjectPtr<UClass>> PredictedCueClasses;
+	TMap<FSoftObjectPath, FPredictedCue> PredictedCues;
+	uint64 PredictedCueSerial = 0;
+
+	// Cue tags referenced by ability and effect classes
+	TMap<TObjectKey<UClass>, FGameplayTagContainer> ReferencedCueTagsByClass;
+
+	// Cue executes merged so far this frame
+	TArray<FPendingCueBatch> PendingCueBatches;
+
 	TArray<FLoadedGameplayTagToProcessData> LoadedGameplayTagsToProcess;
 	FCriticalSection LoadedGameplayTagsToProcessCS;
 	bool bProcessLoadedTagsAfterGC = false;
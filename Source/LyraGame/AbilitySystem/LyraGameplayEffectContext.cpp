@@ -32,6 +32,7 @@ bool FLyraGameplayEffectContext::NetSerialize(FArchive& Ar, class UPackageMap* M
 
 	// Not serialized for post-activation use:
 	// CartridgeID
+	// CueBatch
 
 	return true;
 }
@@ -11,6 +11,7 @@ class FArchive;
 class ILyraAbilitySourceInterface;
 class UObject;
 class UPhysicalMaterial;
+struct FLyraGameplayCueBatch;
 
 USTRUCT()
 struct FLyraGameplayEffectContext : public FGameplayEffectContext
@@ -59,6 +60,12 @@ struct FLyraGameplayEffectContext : public FGameplayEffectContext
 	/** Returns the physical material from the hit result if there is one */
 	const UPhysicalMaterial* GetPhysicalMaterial() const;
 
+	/** Sets the multi-hit payload of a batched gameplay cue execute */
+	void SetCueBatch(const TSharedPtr<const FLyraGameplayCueBatch>& InCueBatch) { CueBatch = InCueBatch; }
+
+	/** Returns the multi-hit payload if this context is for a batched gameplay cue execute */
+	const FLyraGameplayCueBatch* GetCueBatch() const { return CueBatch.Get(); }
+
 public:
 	/** ID to allow the identification of multiple bullets that were part of the same cartridge */
 	UPROPERTY()
@@ -68,6 +75,9 @@ protected:
 	/** Ability Source object (should implement ILyraAbilitySourceInterface). NOT replicated currently */
 	UPROPERTY()
 	TWeakObjectPtr<const UObject> AbilitySourceObject;
+
+	/** Impacts of a batched gameplay cue execute. NOT replicated, batches are sent by ULyraAbilitySystemComponent::MulticastGameplayCueBatch */
+	TSharedPtr<const FLyraGameplayCueBatch> CueBatch;
 };
 
 template<>
@@ -187,7 +187,9 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 
 	float DistBlockedPctThisFrame = 1.f;
 
-	int32 const NumRaysToShoot = bSingleRayOnly ? FMath::Min(1, PenetrationAvoidanceFeelers.Num()) : PenetrationAvoidanceFeelers.Num();
+	// In async mode only the main ray is swept here, the predictive feelers are handled by UpdateAsyncPenetrationFeelers
+	bool const bAsyncFeelers = bAsyncPredictiveAvoidance && !bSingleRayOnly;
+	int32 const NumRaysToShoot = (bSingleRayOnly || bAsyncFeelers) ? FMath::Min(1, PenetrationAvoidanceFeelers.Num()) : PenetrationAvoidanceFeelers.Num();
 	FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(CameraPen), false, nullptr/*PlayerCamera*/);
 
 	SphereParams.AddIgnoredActor(&ViewTarget);
@@ -240,35 +242,12 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 
 			if (bHit && HitActor)
 			{
-				bool bIgnoreHit = false;
-
-				if (HitActor->ActorHasTag(LyraCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+				const bool bIgnoreHit = ShouldIgnorePenetrationHit(ViewTarget, *HitActor, Hit.Location);
+				if (bIgnoreHit)
 				{
-					bIgnoreHit = true;
+					// Ignore this actor on the remaining sweeps.
 					SphereParams.AddIgnoredActor(HitActor);
 				}
-
-				// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
-				if (!bIgnoreHit && HitActor->IsA<ACameraBlockingVolume>())
-				{
-					const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
-					const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
-					const FVector HitOffset = Hit.Location - ViewTargetLocation;
-					const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
-					const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
-					if (DotHitDirection > 0.0f)
-					{
-						bIgnoreHit = true;
-						// Ignore this CameraBlockingVolume on the remaining sweeps.
-						SphereParams.AddIgnoredActor(HitActor);
-					}
-					else
-					{
-#if ENABLE_DRAW_DEBUG
-						DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
-#endif
-					}
-				}
 				
 				if (!bIgnoreHit)
 				{
@@ -306,6 +285,15 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 		}
 	}
 
+	if (bAsyncFeelers)
+	{
+		UpdateAsyncPenetrationFeelers(ViewTarget, SafeLoc, BaseRay, BaseRayLocalUp, BaseRayLocalRight, DeltaTime, DistBlockedPctThisFrame, SoftBlockedPct);
+	}
+	else
+	{
+		AsyncFeelerTraceHandles.Reset();
+	}
+
 	if (bResetInterpolation)
 	{
 		DistBlockedPct = DistBlockedPctThisFrame;
@@ -349,6 +337,108 @@ void ULyraCameraMode_ThirdPerson::PreventCameraPenetration(class AActor const& V
 	}
 }
 
+void ULyraCameraMode_ThirdPerson::UpdateAsyncPenetrationFeelers(AActor const& ViewTarget, FVector const& SafeLoc, FVector const& BaseRay, FVector const& BaseRayLocalUp, FVector const& BaseRayLocalRight,
+	float DeltaTime, float& DistBlockedPctThisFrame, float& SoftBlockedPct)
+{
+	UWorld* World = GetWorld();
+
+	// Results from before a camera cut were swept from somewhere else entirely
+	if (bResetInterpolation)
+	{
+		AsyncFeelerTraceHandles.Reset();
+	}
+	AsyncFeelerTraceHandles.SetNum(PenetrationAvoidanceFeelers.Num());
+
+	FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(CameraPenAsync), false, nullptr/*PlayerCamera*/);
+	SphereParams.AddIgnoredActor(&ViewTarget);
+
+	// Where the target will be when the sweeps dispatched this frame are consumed
+	const FVector PredictedOffset = ViewTarget.GetVelocity() * DeltaTime;
+
+	for (int32 RayIdx = 1; RayIdx < PenetrationAvoidanceFeelers.Num(); ++RayIdx)
+	{
+		FLyraPenetrationAvoidanceFeeler& Feeler = PenetrationAvoidanceFeelers[RayIdx];
+		FTraceHandle& TraceHandle = AsyncFeelerTraceHandles[RayIdx];
+
+		// calc ray target
+		FVector RayTarget;
+		{
+			FVector RotatedRay = BaseRay.RotateAngleAxis(Feeler.AdjustmentRot.Yaw, BaseRayLocalUp);
+			RotatedRay = RotatedRay.RotateAngleAxis(Feeler.AdjustmentRot.Pitch, BaseRayLocalRight);
+			RayTarget = SafeLoc + RotatedRay;
+		}
+
+		// Consume the sweep dispatched last frame
+		FTraceDatum TraceDatum;
+		if (TraceHandle.IsValid() && World->QueryTraceData(TraceHandle, TraceDatum))
+		{
+			const FHitResult* Hit = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits);
+			const AActor* HitActor = Hit ? Hit->GetActor() : nullptr;
+			const FVector RayDelta = RayTarget - SafeLoc;
+			const float RayLength = RayDelta.Size();
+
+#if ENABLE_DRAW_DEBUG
+			if (World->TimeSince(LastDrawDebugTime) < 1.f)
+			{
+				DrawDebugLine(World, TraceDatum.Start, HitActor ? Hit->Location : TraceDatum.End, FColor::Orange);
+			}
+#endif // ENABLE_DRAW_DEBUG
+
+			if (HitActor && (RayLength > UE_KINDA_SMALL_NUMBER) && !ShouldIgnorePenetrationHit(ViewTarget, *HitActor, Hit->Location))
+			{
+				// The hit was swept from a predicted location, so measure it along this frame's ray
+				const float HitDistance = FMath::Max(FVector::DotProduct(Hit->Location - SafeLoc, RayDelta / RayLength), 0.f);
+				const float NewBlockPct = (HitDistance - CollisionPushOutDistance) / RayLength;
+				DistBlockedPctThisFrame = FMath::Min(NewBlockPct, DistBlockedPctThisFrame);
+
+				// This feeler got a hit, so do another trace next frame
+				Feeler.FramesUntilNextTrace = 0;
+
+#if ENABLE_DRAW_DEBUG
+				DebugActorsHitDuringCameraPenetration.AddUnique(TObjectPtr<const AActor>(HitActor));
+#endif
+			}
+
+			SoftBlockedPct = DistBlockedPctThisFrame;
+		}
+		TraceHandle = FTraceHandle();
+
+		// Dispatch this frame's sweep, results are available next frame
+		if (Feeler.FramesUntilNextTrace <= 0)
+		{
+			TraceHandle = World->AsyncSweepByChannel(EAsyncTraceType::Single, SafeLoc + PredictedOffset, RayTarget + PredictedOffset, FQuat::Identity, ECC_Camera,
+				FCollisionShape::MakeSphere(Feeler.Extent), SphereParams);
+
+			Feeler.FramesUntilNextTrace = Feeler.TraceInterval;
+		}
+		else
+		{
+			--Feeler.FramesUntilNextTrace;
+		}
+	}
+}
+
+bool ULyraCameraMode_ThirdPerson::ShouldIgnorePenetrationHit(AActor const& ViewTarget, AActor const& HitActor, FVector const& HitLocation) const
+{
+	if (HitActor.ActorHasTag(LyraCameraMode_ThirdPerson_Statics::NAME_IgnoreCameraCollision))
+	{
+		return true;
+	}
+
+	// Ignore CameraBlockingVolume hits that occur in front of the ViewTarget.
+	if (HitActor.IsA<ACameraBlockingVolume>())
+	{
+		const FVector ViewTargetForwardXY = ViewTarget.GetActorForwardVector().GetSafeNormal2D();
+		const FVector ViewTargetLocation = ViewTarget.GetActorLocation();
+		const FVector HitOffset = HitLocation - ViewTargetLocation;
+		const FVector HitDirectionXY = HitOffset.GetSafeNormal2D();
+		const float DotHitDirection = FVector::DotProduct(ViewTargetForwardXY, HitDirectionXY);
+		return (DotHitDirection > 0.0f);
+	}
+
+	return false;
+}
+
 void ULyraCameraMode_ThirdPerson::SetTargetCrouchOffset(FVector NewTargetOffset)
 {
 	CrouchOffsetBlendPct = 0.0f;
@@ -6,6 +6,7 @@
 #include "Curves/CurveFloat.h"
 #include "LyraPenetrationAvoidanceFeeler.h"
 #include "DrawDebugHelpers.h"
+#include "WorldCollision.h"
 #include "LyraCameraMode_ThirdPerson.generated.h"
 
 class UCurveVector;
@@ -32,6 +33,13 @@ protected:
 	void UpdatePreventPenetration(float DeltaTime);
 	void PreventCameraPenetration(class AActor const& ViewTarget, FVector const& SafeLoc, FVector& CameraLoc, float const& DeltaTime, float& DistBlockedPct, bool bSingleRayOnly);
 
+	// Consumes last frame's async sweeps for the predictive feelers and dispatches this frame's (see bAsyncPredictiveAvoidance)
+	void UpdateAsyncPenetrationFeelers(AActor const& ViewTarget, FVector const& SafeLoc, FVector const& BaseRay, FVector const& BaseRayLocalUp, FVector const& BaseRayLocalRight,
+		float DeltaTime, float& DistBlockedPctThisFrame, float& SoftBlockedPct);
+
+	// Returns true if a penetration feeler hit should not pull the camera in
+	bool ShouldIgnorePenetrationHit(AActor const& ViewTarget, AActor const& HitActor, FVector const& HitLocation) const;
+
 	virtual void DrawDebug(UCanvas* Canvas) const override;
 
 protected:
@@ -74,6 +82,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Collision")
 	bool bDoPredictiveAvoidance = true;
 
+	/**
+	 * If true, only the main feeler is swept synchronously. The predictive feelers are swept asynchronously from where the target
+	 * is expected to be next frame, and their results are applied the following frame, keeping those sweeps off the game thread.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Collision", meta = (EditCondition = "bDoPredictiveAvoidance"))
+	bool bAsyncPredictiveAvoidance = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
 	float CollisionPushOutDistance = 2.f;
 
@@ -101,6 +116,9 @@ public:
 	mutable float LastDrawDebugTime = -MAX_FLT;
 #endif
 
+	// Async sweep in flight for each predictive feeler (indexed like PenetrationAvoidanceFeelers)
+	TArray<FTraceHandle> AsyncFeelerTraceHandles;
+
 protected:
 	
 	void SetTargetCrouchOffset(FVector NewTargetOffset);
@@ -16,6 +16,7 @@
 #include "Player/LyraPlayerState.h"
 #include "System/LyraSignificanceManager.h"
 #include "TimerManager.h"
+#include "Weapons/LyraLagCompensationSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraCharacter)
 
@@ -96,7 +97,17 @@ void ALyraCharacter::BeginPlay()
 	{
 		if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(World))
 		{
-//@TODO: SignificanceManager->RegisterObject(this, (EFortSignificanceType)SignificanceType);
+			SignificanceManager->RegisterCharacter(this);
+		}
+	}
+
+	// Record hitbox history so hits claimed by remote clients can be validated
+	const bool bRegisterWithLagCompensation = HasAuthority() && !IsNetMode(NM_Standalone);
+	if (bRegisterWithLagCompensation)
+	{
+		if (ULyraLagCompensationSubsystem* LagCompensation = World->GetSubsystem<ULyraLagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterCharacter(this);
 		}
 	}
 }
@@ -115,6 +126,11 @@ void ALyraCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 			SignificanceManager->UnregisterObject(this);
 		}
 	}
+
+	if (ULyraLagCompensationSubsystem* LagCompensation = World->GetSubsystem<ULyraLagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterCharacter(this);
+	}
 }
 
 void ALyraCharacter::Reset()
@@ -177,7 +177,9 @@ void ULyraHealthComponent::HandleOutOfHealth(AActor* DamageInstigator, AActor* D
 			//@TODO: Fill out context tags, and any non-ability-system source/instigator tags
 			//@TODO: Determine if it's an opposing team kill, self-own, team kill, etc...
 
+			// Damage messages are held for batch listeners until the end of the frame, deliver the hits that led to this elimination before it
 			UGameplayMessageSubsystem& MessageSystem = UGameplayMessageSubsystem::Get(GetWorld());
+			MessageSystem.FlushQueuedMessages();
 			MessageSystem.BroadcastMessage(Message.Verb, Message);
 		}
 
@@ -7,6 +7,7 @@
 #include "GameFramework/Character.h"
 #include "GameplayTagAssetInterface.h"
 #include "Net/UnrealNetwork.h"
+#include "System/LyraSignificanceManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraPawnComponent_CharacterParts)
 
@@ -188,6 +189,12 @@ bool FLyraCharacterPartList::SpawnActorForEntry(FLyraAppliedCharacterPartEntry&
 					{
 						SpawnedRootComponent->AddTickPrerequisiteComponent(ComponentToAttachTo);
 					}
+
+					// Let the significance manager scale the part's animation rate and LOD with the pawn's relevance
+					if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(World))
+					{
+						SignificanceManager->RegisterCharacterPart(SpawnedActor);
+					}
 				}
 
 				Entry.SpawnedComponent = PartComponent;
@@ -205,6 +212,14 @@ bool FLyraCharacterPartList::DestroyActorForEntry(FLyraAppliedCharacterPartEntry
 
 	if (Entry.SpawnedComponent != nullptr)
 	{
+		if (AActor* SpawnedActor = Entry.SpawnedComponent->GetChildActor())
+		{
+			if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(SpawnedActor->GetWorld()))
+			{
+				SignificanceManager->UnregisterObject(SpawnedActor);
+			}
+		}
+
 		Entry.SpawnedComponent->DestroyComponent();
 		Entry.SpawnedComponent = nullptr;
 		bDestroyedAnyActors = true;
@@ -2,7 +2,9 @@
 
 #include "LyraEquipmentManagerComponent.h"
 
+#include "AbilitySystem/LyraAbilitySet.h"
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
 #include "AbilitySystemGlobals.h"
 #include "Engine/ActorChannel.h"
 #include "LyraEquipmentDefinition.h"
@@ -27,6 +29,8 @@ FString FLyraAppliedEquipmentEntry::GetDebugString() const
 
 void FLyraEquipmentList::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
+	++Revision;
+
  	for (int32 Index : RemovedIndices)
  	{
  		const FLyraAppliedEquipmentEntry& Entry = Entries[Index];
@@ -39,12 +43,24 @@ void FLyraEquipmentList::PreReplicatedRemove(const TArrayView<int32> RemovedIndi
 
 void FLyraEquipmentList::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
+	++Revision;
+
 	for (int32 Index : AddedIndices)
 	{
 		const FLyraAppliedEquipmentEntry& Entry = Entries[Index];
 		if (Entry.Instance != nullptr)
 		{
 			Entry.Instance->OnEquipped();
+
+			// Ability sets are only granted on the authority, so start streaming the cues they can trigger here (e.g., the first shot of a new weapon)
+			ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get();
+			if (GCM && (Entry.EquipmentDefinition != nullptr))
+			{
+				for (const TObjectPtr<const ULyraAbilitySet>& AbilitySet : GetDefault<ULyraEquipmentDefinition>(Entry.EquipmentDefinition)->AbilitySetsToGrant)
+				{
+					GCM->PreloadCuesForAbilitySet(AbilitySet, Entry.Instance);
+				}
+			}
 		}
 	}
 }
@@ -102,6 +118,7 @@ ULyraEquipmentInstance* FLyraEquipmentList::AddEntry(TSubclassOf<ULyraEquipmentD
 
 
 	MarkItemDirty(NewEntry);
+	++Revision;
 
 	return Result;
 }
@@ -123,6 +140,7 @@ void FLyraEquipmentList::RemoveEntry(ULyraEquipmentInstance* Instance)
 
 			EntryIt.RemoveCurrent();
 			MarkArrayDirty();
+			++Revision;
 		}
 	}
 }
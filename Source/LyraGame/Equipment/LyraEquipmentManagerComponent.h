@@ -91,6 +91,9 @@ private:
 
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UActorComponent> OwnerComponent;
+
+	// Incremented whenever equipment is added or removed, locally or by replication
+	int32 Revision = 0;
 };
 
 template<>
@@ -150,6 +153,12 @@ public:
 		return (T*)GetFirstInstanceOfType(T::StaticClass());
 	}
 
+	/** Returns a number that changes whenever an item is equipped or unequipped, so lookups into the equipment can be cached */
+	int32 GetEquipmentRevision() const
+	{
+		return EquipmentList.Revision;
+	}
+
 private:
 	UPROPERTY(Replicated)
 	FLyraEquipmentList EquipmentList;
@@ -3,9 +3,12 @@
 
 #include "LyraContextEffectComponent.h"
 
+#include "Components/AudioComponent.h"
 #include "Engine/World.h"
+#include "NiagaraComponent.h"
 #include "LyraContextEffectsSubsystem.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
+#include "System/LyraSignificanceManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraContextEffectComponent)
 
@@ -41,10 +44,24 @@ void ULyraContextEffectComponent::BeginPlay()
 			LyraContextEffectsSubsystem->LoadAndAddContextEffectsLibraries(GetOwner(), CurrentContextEffectsLibraries);
 		}
 	}
+
+	// Register with the Significance Manager so distant owners stop spawning effects
+	if (!IsNetMode(NM_DedicatedServer))
+	{
+		if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(GetWorld()))
+		{
+			SignificanceManager->RegisterContextEffectComponent(this);
+		}
+	}
 }
 
 void ULyraContextEffectComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	if (ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(GetWorld()))
+	{
+		SignificanceManager->UnregisterObject(this);
+	}
+
 	// On End PLay, remove unnecessary context effects pairings
 	if (const UWorld* World = GetWorld())
 	{
@@ -54,6 +71,9 @@ void ULyraContextEffectComponent::EndPlay(const EEndPlayReason::Type EndPlayReas
 		}
 	}
 
+	ActiveAudioComponents.Reset();
+	ActiveNiagaraComponents.Reset();
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -63,9 +83,11 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 	const bool bHitSuccess, const FHitResult HitResult, FGameplayTagContainer Contexts,
 	FVector VFXScale, float AudioVolume, float AudioPitch)
 {
-	// Prep Components
-	TArray<UAudioComponent*> AudioComponentsToAdd;
-	TArray<UNiagaraComponent*> NiagaraComponentsToAdd;
+	// Skip spawning anything while the owner is too far from any viewpoint to matter
+	if (bEffectsSuppressedBySignificance)
+	{
+		return;
+	}
 
 	FGameplayTagContainer TotalContexts;
 
@@ -99,23 +121,22 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 		}
 	}
 
-	// Cycle through Active Audio Components and cache
-	for (UAudioComponent* ActiveAudioComponent : ActiveAudioComponents)
+	// Drop the components that are done with this actor's effects, pooled ones get reused by other actors once they finish
+	const AActor* Owner = GetOwner();
+	auto IsPlayingForOwner = [Owner](const USceneComponent* EffectComponent)
 	{
-		if (ActiveAudioComponent)
-		{
-			AudioComponentsToAdd.Add(ActiveAudioComponent);
-		}
-	}
+		return IsValid(EffectComponent) && EffectComponent->IsActive() && EffectComponent->GetAttachParent() && (EffectComponent->GetAttachParent()->GetOwner() == Owner);
+	};
 
-	// Cycle through Active Niagara Components and cache
-	for (UNiagaraComponent* ActiveNiagaraComponent : ActiveNiagaraComponents)
+	ActiveAudioComponents.RemoveAll([&IsPlayingForOwner](const UAudioComponent* ActiveAudioComponent)
 	{
-		if (ActiveNiagaraComponent)
-		{
-			NiagaraComponentsToAdd.Add(ActiveNiagaraComponent);
-		}
-	}
+		return !IsPlayingForOwner(ActiveAudioComponent) || !ActiveAudioComponent->IsPlaying();
+	});
+
+	ActiveNiagaraComponents.RemoveAll([&IsPlayingForOwner](const UNiagaraComponent* ActiveNiagaraComponent)
+	{
+		return !IsPlayingForOwner(ActiveNiagaraComponent);
+	});
 
 	// Get World
 	if (const UWorld* World = GetWorld())
@@ -132,20 +153,24 @@ void ULyraContextEffectComponent::AnimMotionEffect_Implementation(const FName Bo
 				LocationOffset, RotationOffset, MotionEffect, TotalContexts,
 				AudioComponents, NiagaraComponents, VFXScale, AudioVolume, AudioPitch);
 
-			// Append resultant effects
-			AudioComponentsToAdd.Append(AudioComponents);
-			NiagaraComponentsToAdd.Append(NiagaraComponents);
+			// Add resultant effects, pooled audio components may already be in the list
+			for (UAudioComponent* AudioComponent : AudioComponents)
+			{
+				if (AudioComponent)
+				{
+					ActiveAudioComponents.AddUnique(AudioComponent);
+				}
+			}
+
+			for (UNiagaraComponent* NiagaraComponent : NiagaraComponents)
+			{
+				if (NiagaraComponent)
+				{
+					ActiveNiagaraComponents.AddUnique(NiagaraComponent);
+				}
+			}
 		}
 	}
-
-	// Append Active Audio Components
-	ActiveAudioComponents.Empty();
-	ActiveAudioComponents.Append(AudioComponentsToAdd);
-
-	// Append Active
-	ActiveNiagaraComponents.Empty();
-	ActiveNiagaraComponents.Append(NiagaraComponentsToAdd);
-
 }
 
 void ULyraContextEffectComponent::UpdateEffectContexts(FGameplayTagContainer NewEffectContexts)
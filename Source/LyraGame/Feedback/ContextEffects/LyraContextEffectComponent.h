@@ -62,7 +62,16 @@ public:
 	UFUNCTION(BlueprintCallable)
 	UE_API void UpdateLibraries(TSet<TSoftObjectPtr<ULyraContextEffectsLibrary>> NewContextEffectsLibraries);
 
+	// Called by the significance manager when the owner becomes too insignificant to spawn effects for (or significant again)
+	void SetEffectsSuppressedBySignificance(bool bSuppressed) { bEffectsSuppressedBySignificance = bSuppressed; }
+
+	// Components still playing effects for this actor, as of the last effect played
+	const TArray<TObjectPtr<UAudioComponent>>& GetActiveAudioComponents() const { return ActiveAudioComponents; }
+	const TArray<TObjectPtr<UNiagaraComponent>>& GetActiveNiagaraComponents() const { return ActiveNiagaraComponents; }
+
 private:
+	bool bEffectsSuppressedBySignificance = false;
+
 	UPROPERTY(Transient)
 	FGameplayTagContainer CurrentContexts;
 
@@ -2,6 +2,7 @@
 
 #include "Feedback/ContextEffects/LyraContextEffectsLibrary.h"
 
+#include "Engine/AssetManager.h"
 #include "NiagaraSystem.h"
 #include "Sound/SoundBase.h"
 
@@ -14,19 +15,33 @@ void ULyraContextEffectsLibrary::GetEffects(const FGameplayTag Effect, const FGa
 	// Make sure Effect is valid and Library is loaded
 	if (Effect.IsValid() && Context.IsValid() && EffectsLoadState == EContextEffectsLibraryLoadState::Loaded)
 	{
-		// Loop through Context Effects
-		for (const auto& ActiveContextEffect : ActiveContextEffects)
+		// Every entry is indexed under the first tag of its Context, so only the entries sharing a tag with Context can match
+		TArray<int32, TInlineAllocator<16>> MatchingIndices;
+		for (const FGameplayTag& ContextTag : Context)
 		{
-			// Make sure the Effect is an exact Tag Match and ensure the Context has all tags in the Effect (and neither or both are empty)
-			if (Effect.MatchesTagExact(ActiveContextEffect->EffectTag)
-				&& Context.HasAllExact(ActiveContextEffect->Context)
-				&& (ActiveContextEffect->Context.IsEmpty() == Context.IsEmpty()))
+			if (const TArray<int32>* EntryIndices = EffectLookup.Find(MakeTuple(Effect, ContextTag)))
 			{
-				// Get all Matching Sounds and Niagara Systems
-				Sounds.Append(ActiveContextEffect->Sounds);
-				NiagaraSystems.Append(ActiveContextEffect->NiagaraSystems);
+				for (const int32 EntryIndex : *EntryIndices)
+				{
+					// Ensure the Context has all tags in the Effect
+					if (Context.HasAllExact(ActiveContextEffects[EntryIndex]->Context))
+					{
+						MatchingIndices.Add(EntryIndex);
+					}
+				}
 			}
 		}
+
+		// Keep the authoring order of the library
+		MatchingIndices.Sort();
+
+		// Get all Matching Sounds and Niagara Systems
+		for (const int32 EntryIndex : MatchingIndices)
+		{
+			const ULyraActiveContextEffects* ActiveContextEffect = ActiveContextEffects[EntryIndex];
+			Sounds.Append(ActiveContextEffect->Sounds);
+			NiagaraSystems.Append(ActiveContextEffect->NiagaraSystems);
+		}
 	}
 }
 
@@ -40,6 +55,7 @@ void ULyraContextEffectsLibrary::LoadEffects()
 
 		// Clear out any old Active Effects
 		ActiveContextEffects.Empty();
+		EffectLookup.Empty();
 
 		// Call internal loading function
 		LoadEffectsInternal();
@@ -54,16 +70,43 @@ EContextEffectsLibraryLoadState ULyraContextEffectsLibrary::GetContextEffectsLib
 
 void ULyraContextEffectsLibrary::LoadEffectsInternal()
 {
-	// TODO Add Async Loading for Libraries
+	// Gather every effect with valid tags so they can be streamed in as a single batch
+	TArray<FSoftObjectPath> EffectPaths;
+	for (const FLyraContextEffects& ContextEffect : ContextEffects)
+	{
+		if (ContextEffect.EffectTag.IsValid() && ContextEffect.Context.IsValid())
+		{
+			for (const FSoftObjectPath& Effect : ContextEffect.Effects)
+			{
+				if (!Effect.IsNull())
+				{
+					EffectPaths.AddUnique(Effect);
+				}
+			}
+		}
+	}
 
-	// Copy data for async load
-	TArray<FLyraContextEffects> LocalContextEffects = ContextEffects;
+	if (EffectPaths.Num() > 0)
+	{
+		EffectsLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(EffectPaths),
+			FStreamableDelegate::CreateUObject(this, &ThisClass::OnEffectsStreamed), FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("LyraContextEffectsLibrary"));
+	}
+	else
+	{
+		OnEffectsStreamed();
+	}
+}
+
+void ULyraContextEffectsLibrary::OnEffectsStreamed()
+{
+	// The active effects reference everything that was loaded from here on
+	EffectsLoadHandle.Reset();
 
 	// Prepare Active Context Effects Array
 	TArray<ULyraActiveContextEffects*> ActiveContextEffectsArray;
 
 	// Loop through Context Effects
-	for (const FLyraContextEffects& ContextEffect : LocalContextEffects)
+	for (const FLyraContextEffects& ContextEffect : ContextEffects)
 	{
 		// Make sure Tags are Valid
 		if (ContextEffect.EffectTag.IsValid() && ContextEffect.Context.IsValid())
@@ -75,24 +118,18 @@ void ULyraContextEffectsLibrary::LoadEffectsInternal()
 			NewActiveContextEffects->EffectTag = ContextEffect.EffectTag;
 			NewActiveContextEffects->Context = ContextEffect.Context;
 
-			// Try to load and add Effects to New Active Context Effects
+			// Add the streamed in Effects to New Active Context Effects
 			for (const FSoftObjectPath& Effect : ContextEffect.Effects)
 			{
-				if (UObject* Object = Effect.TryLoad())
+				if (UObject* Object = Effect.ResolveObject())
 				{
-					if (Object->IsA(USoundBase::StaticClass()))
+					if (USoundBase* SoundBase = Cast<USoundBase>(Object))
 					{
-						if (USoundBase* SoundBase = Cast<USoundBase>(Object))
-						{
-							NewActiveContextEffects->Sounds.Add(SoundBase);
-						}
+						NewActiveContextEffects->Sounds.Add(SoundBase);
 					}
-					else if (Object->IsA(UNiagaraSystem::StaticClass()))
+					else if (UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(Object))
 					{
-						if (UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(Object))
-						{
-							NewActiveContextEffects->NiagaraSystems.Add(NiagaraSystem);
-						}
+						NewActiveContextEffects->NiagaraSystems.Add(NiagaraSystem);
 					}
 				}
 			}
@@ -102,9 +139,8 @@ void ULyraContextEffectsLibrary::LoadEffectsInternal()
 		}
 	}
 
-	// TODO Call Load Complete after Async Load
 	// Mark loading complete
-	this->LyraContextEffectLibraryLoadingComplete(ActiveContextEffectsArray);
+	LyraContextEffectLibraryLoadingComplete(ActiveContextEffectsArray);
 }
 
 void ULyraContextEffectsLibrary::LyraContextEffectLibraryLoadingComplete(
@@ -115,5 +151,17 @@ void ULyraContextEffectsLibrary::LyraContextEffectLibraryLoadingComplete(
 
 	// Append incoming Context Effects Array to current list of Active Context Effects
 	ActiveContextEffects.Append(LyraActiveContextEffects);
+
+	BuildEffectLookup();
 }
 
+void ULyraContextEffectsLibrary::BuildEffectLookup()
+{
+	EffectLookup.Reset();
+
+	for (int32 EntryIndex = 0; EntryIndex < ActiveContextEffects.Num(); ++EntryIndex)
+	{
+		const ULyraActiveContextEffects* ActiveContextEffect = ActiveContextEffects[EntryIndex];
+		EffectLookup.FindOrAdd(MakeTuple(ActiveContextEffect->EffectTag, ActiveContextEffect->Context.First())).Add(EntryIndex);
+	}
+}
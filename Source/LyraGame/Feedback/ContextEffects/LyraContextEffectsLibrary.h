@@ -3,6 +3,7 @@
 #pragma once
 
 #include "GameplayTagContainer.h"
+#include "Templates/Tuple.h"
 #include "UObject/SoftObjectPath.h"
 #include "UObject/WeakObjectPtr.h"
 
@@ -13,6 +14,7 @@
 class UNiagaraSystem;
 class USoundBase;
 struct FFrame;
+struct FStreamableHandle;
 
 /**
  *
@@ -68,7 +70,10 @@ public:
 DECLARE_DYNAMIC_DELEGATE_OneParam(FLyraContextEffectLibraryLoadingComplete, TArray<ULyraActiveContextEffects*>, LyraActiveContextEffects);
 
 /**
- * 
+ * ULyraContextEffectsLibrary
+ *
+ * Effects are streamed in asynchronously by LoadEffects. Once loaded, they are indexed by (effect tag, context tag)
+ * using the first tag of each entry's context, so GetEffects only has to check the entries that share a tag with the query
  */
 UCLASS(MinimalAPI, BlueprintType)
 class ULyraContextEffectsLibrary : public UObject
@@ -91,8 +96,19 @@ public:
 private:
 	void LoadEffectsInternal();
 
+	void OnEffectsStreamed();
+
 	void LyraContextEffectLibraryLoadingComplete(TArray<ULyraActiveContextEffects*> LyraActiveContextEffects);
 
+	// Rebuilds EffectLookup from ActiveContextEffects
+	void BuildEffectLookup();
+
+	// Handle for the effects currently being streamed in
+	TSharedPtr<FStreamableHandle> EffectsLoadHandle;
+
+	// Indices into ActiveContextEffects, keyed by (effect tag, first tag of the entry's context), in authoring order
+	TMap<TTuple<FGameplayTag, FGameplayTag>, TArray<int32>> EffectLookup;
+
 	UPROPERTY(Transient)
 	TArray< TObjectPtr<ULyraActiveContextEffects>> ActiveContextEffects;
 
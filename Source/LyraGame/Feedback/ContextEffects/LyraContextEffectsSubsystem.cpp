@@ -3,8 +3,11 @@
 
 #include "LyraContextEffectsSubsystem.h"
 
+#include "Components/AudioComponent.h"
+#include "Engine/AssetManager.h"
 #include "Feedback/ContextEffects/LyraContextEffectsLibrary.h"
 #include "Feedback/ContextEffects/LyraContextEffectsSubsystem.h"
+#include "HAL/IConsoleManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraSystem.h"
@@ -17,6 +20,23 @@ class UNiagaraSystem;
 class USceneComponent;
 class USoundBase;
 
+namespace LyraContextEffects
+{
+	static bool bPoolNiagara = true;
+	static FAutoConsoleVariableRef CVarPoolNiagara(
+		TEXT("Lyra.ContextEffects.PoolNiagara"),
+		bPoolNiagara,
+		TEXT("Should context effect Niagara systems be spawned from the world's component pool"),
+		ECVF_Default);
+
+	static int32 MaxPooledAudioComponents = 8;
+	static FAutoConsoleVariableRef CVarMaxPooledAudioComponents(
+		TEXT("Lyra.ContextEffects.MaxPooledAudioComponents"),
+		MaxPooledAudioComponents,
+		TEXT("Number of audio components each actor keeps around for reuse by its context effects (0 spawns a new component for every sound)"),
+		ECVF_Default);
+}
+
 void ULyraContextEffectsSubsystem::SpawnContextEffects(
 	const AActor* SpawningActor
 	, USceneComponent* AttachToComponent
@@ -68,19 +88,21 @@ void ULyraContextEffectsSubsystem::SpawnContextEffects(
 			// Cycle through found Sounds
 			for (USoundBase* Sound : TotalSounds)
 			{
-				// Spawn Sounds Attached, add Audio Component to List of ACs
-				UAudioComponent* AudioComponent = UGameplayStatics::SpawnSoundAttached(Sound, AttachToComponent, AttachPoint, LocationOffset, RotationOffset, EAttachLocation::KeepRelativeOffset,
-					false, AudioVolume, AudioPitch, 0.0f, nullptr, nullptr, true);
+				// Play Sounds Attached, add Audio Component to List of ACs
+				UAudioComponent* AudioComponent = PlayPooledSound(EffectsLibraries, Sound, AttachToComponent, AttachPoint, LocationOffset, RotationOffset, AudioVolume, AudioPitch);
 
 				AudioOut.Add(AudioComponent);
 			}
 
+			// Pooled components are released back to the pool once the system completes
+			const ENCPoolMethod NiagaraPoolMethod = LyraContextEffects::bPoolNiagara ? ENCPoolMethod::AutoRelease : ENCPoolMethod::None;
+
 			// Cycle through found Niagara Systems
 			for (UNiagaraSystem* NiagaraSystem : TotalNiagaraSystems)
 			{
 				// Spawn Niagara Systems Attached, add Niagara Component to List of NCs
 				UNiagaraComponent* NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAttached(NiagaraSystem, AttachToComponent, AttachPoint, LocationOffset,
-					RotationOffset, VFXScale, EAttachLocation::KeepRelativeOffset, true, ENCPoolMethod::None, true, true);
+					RotationOffset, VFXScale, EAttachLocation::KeepRelativeOffset, true, NiagaraPoolMethod, true, true);
 
 				NiagaraOut.Add(NiagaraComponent);
 			}
@@ -117,23 +139,123 @@ void ULyraContextEffectsSubsystem::LoadAndAddContextEffectsLibraries(AActor* Own
 	// Create new Context Effect Set
 	ULyraContextEffectsSet* EffectsLibrariesSet = NewObject<ULyraContextEffectsSet>(this);
 
+	// Keep the audio components of the previous set, they are still attached to the same actor
+	if (const TObjectPtr<ULyraContextEffectsSet>* PreviousSetPtr = ActiveActorEffectsMap.Find(OwningActor))
+	{
+		if (ULyraContextEffectsSet* PreviousSet = *PreviousSetPtr)
+		{
+			EffectsLibrariesSet->PooledAudioComponents = MoveTemp(PreviousSet->PooledAudioComponents);
+		}
+	}
+
 	// Cycle through Libraries getting Soft Obj Refs
+	TArray<TSoftObjectPtr<ULyraContextEffectsLibrary>> LibrariesToStream;
+	TArray<FSoftObjectPath> LibraryPathsToStream;
 	for (const TSoftObjectPtr<ULyraContextEffectsLibrary>& ContextEffectSoftObj : ContextEffectsLibraries)
 	{
-		// Load Library Assets from Soft Obj refs
-		// TODO Support Async Loading of Asset Data
-		if (ULyraContextEffectsLibrary* EffectsLibrary = ContextEffectSoftObj.LoadSynchronous())
+		if (ULyraContextEffectsLibrary* EffectsLibrary = ContextEffectSoftObj.Get())
 		{
-			// Call load on valid Libraries
-			EffectsLibrary->LoadEffects();
+			// Call load on already loaded Libraries
+			if (EffectsLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Unloaded)
+			{
+				EffectsLibrary->LoadEffects();
+			}
 
-			// Add new library to Set
+			// Add library to Set
 			EffectsLibrariesSet->LyraContextEffectsLibraries.Add(EffectsLibrary);
 		}
+		else if (!ContextEffectSoftObj.IsNull())
+		{
+			LibrariesToStream.Add(ContextEffectSoftObj);
+			LibraryPathsToStream.Add(ContextEffectSoftObj.ToSoftObjectPath());
+		}
 	}
 
 	// Update Active Actor Effects Map
 	ActiveActorEffectsMap.Emplace(OwningActor, EffectsLibrariesSet);
+
+	// Stream in the remaining Library Assets, they get added to the Set once loaded
+	if (LibraryPathsToStream.Num() > 0)
+	{
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(LibraryPathsToStream),
+			FStreamableDelegate::CreateUObject(this, &ThisClass::OnContextEffectsLibrariesStreamed, TWeakObjectPtr<AActor>(OwningActor), TWeakObjectPtr<ULyraContextEffectsSet>(EffectsLibrariesSet), MoveTemp(LibrariesToStream)),
+			FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("LyraContextEffectsSubsystem"));
+	}
+}
+
+void ULyraContextEffectsSubsystem::OnContextEffectsLibrariesStreamed(TWeakObjectPtr<AActor> WeakOwningActor,
+	TWeakObjectPtr<ULyraContextEffectsSet> WeakEffectsLibrariesSet, TArray<TSoftObjectPtr<ULyraContextEffectsLibrary>> ContextEffectsLibraries)
+{
+	// Ignore the load if the actor has been removed or has had its libraries replaced since
+	ULyraContextEffectsSet* EffectsLibrariesSet = WeakEffectsLibrariesSet.Get();
+	const TObjectPtr<ULyraContextEffectsSet>* ActiveSetPtr = WeakOwningActor.IsValid() ? ActiveActorEffectsMap.Find(WeakOwningActor.Get()) : nullptr;
+	if (EffectsLibrariesSet == nullptr || ActiveSetPtr == nullptr || *ActiveSetPtr != EffectsLibrariesSet)
+	{
+		return;
+	}
+
+	for (const TSoftObjectPtr<ULyraContextEffectsLibrary>& ContextEffectSoftObj : ContextEffectsLibraries)
+	{
+		if (ULyraContextEffectsLibrary* EffectsLibrary = ContextEffectSoftObj.Get())
+		{
+			// Call load on valid Libraries
+			if (EffectsLibrary->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Unloaded)
+			{
+				EffectsLibrary->LoadEffects();
+			}
+
+			// Add new library to Set
+			EffectsLibrariesSet->LyraContextEffectsLibraries.Add(EffectsLibrary);
+		}
+	}
+}
+
+UAudioComponent* ULyraContextEffectsSubsystem::PlayPooledSound(ULyraContextEffectsSet* EffectsLibrariesSet, USoundBase* Sound, USceneComponent* AttachToComponent, const FName AttachPoint,
+	const FVector& LocationOffset, const FRotator& RotationOffset, float AudioVolume, float AudioPitch)
+{
+	TArray<TObjectPtr<UAudioComponent>>& Pool = EffectsLibrariesSet->PooledAudioComponents;
+
+	// Reuse an idle component if there is one
+	if (AttachToComponent != nullptr)
+	{
+		for (int32 PoolIndex = Pool.Num() - 1; PoolIndex >= 0; --PoolIndex)
+		{
+			UAudioComponent* PooledComponent = Pool[PoolIndex];
+			if (!IsValid(PooledComponent))
+			{
+				// Destroyed along with whatever it was attached to
+				Pool.RemoveAtSwap(PoolIndex, EAllowShrinking::No);
+				continue;
+			}
+
+			if (!PooledComponent->IsPlaying())
+			{
+				if ((PooledComponent->GetAttachParent() != AttachToComponent) || (PooledComponent->GetAttachSocketName() != AttachPoint))
+				{
+					PooledComponent->AttachToComponent(AttachToComponent, FAttachmentTransformRules::KeepRelativeTransform, AttachPoint);
+				}
+				PooledComponent->SetRelativeLocationAndRotation(LocationOffset, RotationOffset);
+				PooledComponent->SetSound(Sound);
+				PooledComponent->SetVolumeMultiplier(AudioVolume);
+				PooledComponent->SetPitchMultiplier(AudioPitch);
+				PooledComponent->Play();
+				return PooledComponent;
+			}
+		}
+	}
+
+	// Otherwise spawn a new one, keeping it for reuse while the pool has room
+	const bool bAddToPool = (AttachToComponent != nullptr) && (Pool.Num() < LyraContextEffects::MaxPooledAudioComponents);
+
+	UAudioComponent* AudioComponent = UGameplayStatics::SpawnSoundAttached(Sound, AttachToComponent, AttachPoint, LocationOffset, RotationOffset, EAttachLocation::KeepRelativeOffset,
+		false, AudioVolume, AudioPitch, 0.0f, nullptr, nullptr, !bAddToPool);
+
+	if (bAddToPool && AudioComponent)
+	{
+		Pool.Add(AudioComponent);
+	}
+
+	return AudioComponent;
 }
 
 void ULyraContextEffectsSubsystem::UnloadAndRemoveContextEffectsLibraries(AActor* OwningActor)
@@ -145,6 +267,24 @@ void ULyraContextEffectsSubsystem::UnloadAndRemoveContextEffectsLibraries(AActor
 	}
 
 	// Remove ref from Active Actor/Effects Set Map
-	ActiveActorEffectsMap.Remove(OwningActor);
+	TObjectPtr<ULyraContextEffectsSet> EffectsLibrariesSet;
+	if (ActiveActorEffectsMap.RemoveAndCopyValue(OwningActor, EffectsLibrariesSet) && EffectsLibrariesSet)
+	{
+		// Let any sounds still playing finish before their components go away
+		for (UAudioComponent* PooledComponent : EffectsLibrariesSet->PooledAudioComponents)
+		{
+			if (IsValid(PooledComponent))
+			{
+				if (PooledComponent->IsPlaying())
+				{
+					PooledComponent->bAutoDestroy = true;
+				}
+				else
+				{
+					PooledComponent->DestroyComponent();
+				}
+			}
+		}
+		EffectsLibrariesSet->PooledAudioComponents.Reset();
+	}
 }
-
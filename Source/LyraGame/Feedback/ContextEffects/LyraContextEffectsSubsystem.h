@@ -17,6 +17,7 @@ class UAudioComponent;
 class ULyraContextEffectsLibrary;
 class UNiagaraComponent;
 class USceneComponent;
+class USoundBase;
 struct FFrame;
 struct FGameplayTag;
 struct FGameplayTagContainer;
@@ -46,11 +47,20 @@ class ULyraContextEffectsSet : public UObject
 public:
 	UPROPERTY(Transient)
 	TSet<TObjectPtr<ULyraContextEffectsLibrary>> LyraContextEffectsLibraries;
+
+	// Audio components spawned for this actor's effects, reused once they finish playing
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAudioComponent>> PooledAudioComponents;
 };
 
 
 /**
- * 
+ * ULyraContextEffectsSubsystem
+ *
+ * Libraries and their effects are streamed in asynchronously, an actor's effects start playing once they are loaded.
+ * Niagara effects are spawned from the world's component pool (Lyra.ContextEffects.PoolNiagara) and each actor keeps
+ * a small pool of audio components (Lyra.ContextEffects.MaxPooledAudioComponents), so frequent effects like footsteps
+ * don't create new components every time. Components returned by SpawnContextEffects may therefore be reused later.
  */
 UCLASS(MinimalAPI)
 class ULyraContextEffectsSubsystem : public UWorldSubsystem
@@ -88,6 +98,13 @@ public:
 
 private:
 
+	// Adds the libraries to the set once they have been streamed in, unless the set was replaced or removed in the meantime
+	void OnContextEffectsLibrariesStreamed(TWeakObjectPtr<AActor> WeakOwningActor, TWeakObjectPtr<ULyraContextEffectsSet> WeakEffectsLibrariesSet, TArray<TSoftObjectPtr<ULyraContextEffectsLibrary>> ContextEffectsLibraries);
+
+	// Plays a sound on an idle pooled audio component of the set, spawning a new one if none are available
+	UAudioComponent* PlayPooledSound(ULyraContextEffectsSet* EffectsLibrariesSet, USoundBase* Sound, USceneComponent* AttachToComponent, const FName AttachPoint,
+		const FVector& LocationOffset, const FRotator& RotationOffset, float AudioVolume, float AudioPitch);
+
 	UPROPERTY(Transient)
 	TMap<TObjectPtr<AActor>, TObjectPtr<ULyraContextEffectsSet>> ActiveActorEffectsMap;
 
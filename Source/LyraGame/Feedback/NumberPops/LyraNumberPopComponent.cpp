@@ -2,6 +2,8 @@
 
 #include "LyraNumberPopComponent.h"
 
+#include "System/LyraSignificanceManager.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraNumberPopComponent)
 
 ULyraNumberPopComponent::ULyraNumberPopComponent(const FObjectInitializer& ObjectInitializer)
@@ -9,3 +11,12 @@ ULyraNumberPopComponent::ULyraNumberPopComponent(const FObjectInitializer& Objec
 {
 }
 
+bool ULyraNumberPopComponent::IsNumberPopSignificant(const FLyraNumberPopRequest& Request) const
+{
+	if (const ULyraSignificanceManager* SignificanceManager = USignificanceManager::Get<ULyraSignificanceManager>(GetWorld()))
+	{
+		return SignificanceManager->ShouldDisplayNumberPop(Request.WorldLocation);
+	}
+
+	return true;
+}
@@ -7,6 +7,7 @@
 
 #include "LyraNumberPopComponent.generated.h"
 
+class AActor;
 class UObject;
 struct FFrame;
 
@@ -35,6 +36,10 @@ struct FLyraNumberPopRequest
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lyra|Number Pops")
 	bool bIsCriticalDamage = false;
 
+	// The actor the number pop is for, optional (used to merge pops on the same target)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lyra|Number Pops")
+	TWeakObjectPtr<AActor> TargetActor;
+
 	FLyraNumberPopRequest()
 		: WorldLocation(ForceInitToZero)
 	{
@@ -54,4 +59,8 @@ public:
 	/** Adds a damage number to the damage number list for visualization */
 	UFUNCTION(BlueprintCallable, Category = Foo)
 	virtual void AddNumberPop(const FLyraNumberPopRequest& NewRequest) {}
+
+protected:
+	// Returns false if the request is too far from any local viewpoint to be worth displaying (see Lyra.Significance.NumberPops.MaxBucket)
+	bool IsNumberPopSignificant(const FLyraNumberPopRequest& Request) const;
 };
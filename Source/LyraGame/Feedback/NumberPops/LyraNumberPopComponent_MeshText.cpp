@@ -54,6 +54,11 @@ void ULyraNumberPopComponent_MeshText::AddNumberPop(const FLyraNumberPopRequest&
 		}
 	}
 
+	if (!IsNumberPopSignificant(NewRequest))
+	{
+		return;
+	}
+
 	FTempNumberPopInfo PreparedNumberInfo;
 
 	// Prepare the DamageNumberArray with the digits from the damage.
@@ -2,6 +2,7 @@
 
 #include "LyraNumberPopComponent_NiagaraText.h"
 
+#include "Engine/World.h"
 #include "Feedback/NumberPops/LyraNumberPopComponent.h"
 #include "LyraDamagePopStyleNiagara.h"
 #include "LyraLogChannels.h"
@@ -13,44 +14,177 @@
 ULyraNumberPopComponent_NiagaraText::ULyraNumberPopComponent_NiagaraText(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	// Only ticks while there are pops waiting to be flushed, after everything that can add a pop this frame
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void ULyraNumberPopComponent_NiagaraText::AddNumberPop(const FLyraNumberPopRequest& NewRequest)
+{
+	if (!IsNumberPopSignificant(NewRequest))
+	{
+		return;
+	}
+
+	if (FPendingNumberPop* PendingPop = FindPendingPopToMergeInto(NewRequest))
+	{
+		PendingPop->Number += NewRequest.NumberToDisplay;
+		PendingPop->bIsCriticalDamage |= NewRequest.bIsCriticalDamage;
+		PendingPop->WorldLocation = NewRequest.WorldLocation;
+		return;
+	}
 
+	FPendingNumberPop& NewPop = PendingNumberPops.AddDefaulted_GetRef();
+	NewPop.TargetActor = NewRequest.TargetActor;
+	NewPop.WorldLocation = NewRequest.WorldLocation;
+	NewPop.Number = NewRequest.NumberToDisplay;
+	NewPop.bIsCriticalDamage = NewRequest.bIsCriticalDamage;
+	NewPop.DisplayTime = GetDisplayTimeForNewPop(NewRequest);
 
+	SetComponentTickEnabled(true);
 }
 
-void ULyraNumberPopComponent_NiagaraText::AddNumberPop(const FLyraNumberPopRequest& NewRequest)
+void ULyraNumberPopComponent_NiagaraText::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FlushPendingNumberPops();
+
+	if (PendingNumberPops.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+ULyraNumberPopComponent_NiagaraText::FPendingNumberPop* ULyraNumberPopComponent_NiagaraText::FindPendingPopToMergeInto(const FLyraNumberPopRequest& NewRequest)
+{
+	if (AActor* TargetActor = NewRequest.TargetActor.Get())
+	{
+		if (FPendingNumberPop* PendingPop = PendingNumberPops.FindByPredicate([TargetActor](const FPendingNumberPop& Pop) { return Pop.TargetActor.Get() == TargetActor; }))
+		{
+			return PendingPop;
+		}
+	}
+
+	// Without a target fall back to merging pops that would be drawn on top of each other, and once at the cap merge with whichever pop is closest
+	const bool bAtCap = PendingNumberPops.Num() >= MaxPendingNumberPops;
+	const double MergeDistanceSq = bAtCap ? UE_DOUBLE_BIG_NUMBER : (NewRequest.TargetActor.IsValid() ? -1.0 : FMath::Square(AggregationRadius));
+
+	FPendingNumberPop* ClosestPop = nullptr;
+	double ClosestDistanceSq = MergeDistanceSq;
+	for (FPendingNumberPop& PendingPop : PendingNumberPops)
+	{
+		if (!bAtCap && PendingPop.TargetActor.IsValid())
+		{
+			continue;
+		}
+
+		const double DistanceSq = FVector::DistSquared(PendingPop.WorldLocation, NewRequest.WorldLocation);
+		if (DistanceSq <= ClosestDistanceSq)
+		{
+			ClosestPop = &PendingPop;
+			ClosestDistanceSq = DistanceSq;
+		}
+	}
+
+	return ClosestPop;
+}
+
+double ULyraNumberPopComponent_NiagaraText::GetDisplayTimeForNewPop(const FLyraNumberPopRequest& NewRequest) const
 {
-	int32 LocalDamage = NewRequest.NumberToDisplay;
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const double AggregationRadiusSq = FMath::Square(AggregationRadius);
 
-	//Change Damage to negative to differentiate Critial vs Normal hit
-	if (NewRequest.bIsCriticalDamage)
+	double DisplayTime = CurrentTime;
+	for (const FShownNumberPop& ShownPop : RecentlyShownNumberPops)
 	{
-		LocalDamage *= -1;
+		const bool bSameTarget = NewRequest.TargetActor.IsValid()
+			? (ShownPop.TargetActor == NewRequest.TargetActor)
+			: (!ShownPop.TargetActor.IsValid() && (FVector::DistSquared(ShownPop.WorldLocation, NewRequest.WorldLocation) <= AggregationRadiusSq));
+
+		if (bSameTarget)
+		{
+			DisplayTime = FMath::Max(DisplayTime, ShownPop.ShownTime + AggregationWindow);
+		}
 	}
 
+	return DisplayTime;
+}
+
+void ULyraNumberPopComponent_NiagaraText::FlushPendingNumberPops()
+{
+	if (PendingNumberPops.Num() == 0)
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULyraNumberPopComponent_NiagaraText_Flush);
+
 	//Add a NiagaraComponent if we don't already have one
 	if (!NiagaraComp)
 	{
-		NiagaraComp = NewObject<UNiagaraComponent>(GetOwner());
-		if (Style != nullptr)
+		CreateNiagaraComponent();
+	}
+
+	if ((Style == nullptr) || Style->NiagaraArrayName.IsNone())
+	{
+		PendingNumberPops.Reset();
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	RecentlyShownNumberPops.RemoveAllSwap([ExpiredTime = CurrentTime - AggregationWindow](const FShownNumberPop& ShownPop) { return ShownPop.ShownTime <= ExpiredTime; });
+
+	bool bWroteAnyPops = false;
+	FVector LastLocation = FVector::ZeroVector;
+	for (auto It = PendingNumberPops.CreateIterator(); It; ++It)
+	{
+		const FPendingNumberPop& PendingPop = *It;
+		if (PendingPop.DisplayTime > CurrentTime)
 		{
-			NiagaraComp->SetAsset(Style->TextNiagara);
-			NiagaraComp->bAutoActivate = false;
-			
+			continue;
 		}
-		NiagaraComp->SetupAttachment(nullptr);
-		check(NiagaraComp);
-		NiagaraComp->RegisterComponent();
-	}
 
+		//Change Damage to negative to differentiate Critial vs Normal hit
+		const int32 LocalDamage = PendingPop.bIsCriticalDamage ? -PendingPop.Number : PendingPop.Number;
+
+		UE_LOG(LogLyra, Verbose, TEXT("DamageHit location : %s"), *PendingPop.WorldLocation.ToString());
+
+		//Append the Damage information to the Niagara list in place - Damage informations are packed inside a FVector4 where XYZ = Position, W = Damage
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4Value(NiagaraComp, Style->NiagaraArrayName, NumWrittenNumberPops, FVector4(PendingPop.WorldLocation.X, PendingPop.WorldLocation.Y, PendingPop.WorldLocation.Z, LocalDamage), /*bSizeToFit=*/ true);
+		++NumWrittenNumberPops;
+
+		LastLocation = PendingPop.WorldLocation;
+		bWroteAnyPops = true;
+
+		if (AggregationWindow > 0.0f)
+		{
+			RecentlyShownNumberPops.Add({ PendingPop.TargetActor, PendingPop.WorldLocation, CurrentTime });
+		}
 
-	NiagaraComp->Activate(false);
-	NiagaraComp->SetWorldLocation(NewRequest.WorldLocation);
+		It.RemoveCurrent();
+	}
 
-	UE_LOG(LogLyra, Log, TEXT("DamageHit location : %s"), *(NewRequest.WorldLocation.ToString()));
-	//Add Damage information to the current Niagara list - Damage informations are packed inside a FVector4 where XYZ = Position, W = Damage
-	TArray<FVector4> DamageList = UNiagaraDataInterfaceArrayFunctionLibrary::GetNiagaraArrayVector4(NiagaraComp, Style->NiagaraArrayName);
-	DamageList.Add(FVector4(NewRequest.WorldLocation.X, NewRequest.WorldLocation.Y, NewRequest.WorldLocation.Z, LocalDamage));
-	UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector4(NiagaraComp, Style->NiagaraArrayName, DamageList);
-	
+	if (bWroteAnyPops)
+	{
+		NiagaraComp->Activate(false);
+		NiagaraComp->SetWorldLocation(LastLocation);
+	}
 }
 
+void ULyraNumberPopComponent_NiagaraText::CreateNiagaraComponent()
+{
+	NiagaraComp = NewObject<UNiagaraComponent>(GetOwner());
+	if (Style != nullptr)
+	{
+		NiagaraComp->SetAsset(Style->TextNiagara);
+		NiagaraComp->bAutoActivate = false;
+		
+	}
+	NiagaraComp->SetupAttachment(nullptr);
+	check(NiagaraComp);
+	NiagaraComp->RegisterComponent();
+
+	NumWrittenNumberPops = 0;
+}
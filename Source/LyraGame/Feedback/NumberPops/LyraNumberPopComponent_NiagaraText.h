@@ -23,6 +23,43 @@ public:
 	virtual void AddNumberPop(const FLyraNumberPopRequest& NewRequest) override;
 	//~End of ULyraNumberPopComponent interface
 
+	//~UActorComponent interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~End of UActorComponent interface
+
+protected:
+
+	/** A number pop waiting to be written to the Niagara array */
+	struct FPendingNumberPop
+	{
+		TWeakObjectPtr<AActor> TargetActor;
+		FVector WorldLocation = FVector::ZeroVector;
+		int32 Number = 0;
+		bool bIsCriticalDamage = false;
+
+		// World time at which the pop is written, pops arriving before then are merged into it
+		double DisplayTime = 0.0;
+	};
+
+	/** A number pop that was written recently, later pops for the same target are held until its aggregation window ends */
+	struct FShownNumberPop
+	{
+		TWeakObjectPtr<AActor> TargetActor;
+		FVector WorldLocation = FVector::ZeroVector;
+		double ShownTime = 0.0;
+	};
+
+	// Returns the pending pop that a new request should be merged into, if any
+	FPendingNumberPop* FindPendingPopToMergeInto(const FLyraNumberPopRequest& NewRequest);
+
+	// Returns when a new pop for the request can be displayed, now unless a pop for the same target was shown within the aggregation window
+	double GetDisplayTimeForNewPop(const FLyraNumberPopRequest& NewRequest) const;
+
+	// Appends the pending pops whose display time has come to the Niagara array
+	void FlushPendingNumberPops();
+
+	void CreateNiagaraComponent();
+
 protected:
 	
 	TArray<int32> DamageNumberArray;
@@ -34,4 +71,25 @@ protected:
 	//Niagara Component used to display the damage
 	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Style")
 	TObjectPtr<UNiagaraComponent> NiagaraComp;
+
+	/** The first pop on a target is displayed right away, further pops on it within this long (in seconds) are summed and displayed when the window ends, 0 only merges pops from the same frame */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Aggregation", meta = (ClampMin = 0.0, Units = s))
+	float AggregationWindow = 0.1f;
+
+	/** Pops without a target actor are merged when they are closer than this */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Aggregation", meta = (ClampMin = 0.0, Units = cm))
+	float AggregationRadius = 50.0f;
+
+	/** Maximum number of pops waiting to be displayed, further pops are merged into the closest waiting pop */
+	UPROPERTY(EditDefaultsOnly, Category = "Number Pop|Aggregation", meta = (ClampMin = 1))
+	int32 MaxPendingNumberPops = 16;
+
+	// Pops added since the last flush
+	TArray<FPendingNumberPop> PendingNumberPops;
+
+	// Pops written within the last AggregationWindow
+	TArray<FShownNumberPop> RecentlyShownNumberPops;
+
+	// Number of elements written to the Niagara array so far, new pops are appended after them
+	int32 NumWrittenNumberPops = 0;
 };
@@ -157,6 +157,9 @@ void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& A
 		}
 
 		UUIExtensionSubsystem* ExtensionSubsystem = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>();
+
+		// Register the whole HUD at once so each extension point is notified in one pass
+		FUIExtensionRegistrationBatchScope RegistrationBatch(ExtensionSubsystem);
 		for (const FLyraHUDElementEntry& Entry : Widgets)
 		{
 			ActorData.ExtensionHandles.Add(ExtensionSubsystem->RegisterExtensionAsWidgetForContext(Entry.SlotID, LocalPlayer, Entry.WidgetClass.Get(), -1));
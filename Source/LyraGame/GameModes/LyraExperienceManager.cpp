@@ -4,9 +4,152 @@
 #include "GameModes/LyraExperienceManager.h"
 #include "Engine/Engine.h"
 #include "Subsystems/SubsystemCollection.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "LyraExperienceActionSet.h"
+#include "LyraExperienceDefinition.h"
+#include "LyraLogChannels.h"
+#include "LyraUserFacingExperienceDefinition.h"
+#include "System/LyraAssetManager.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraExperienceManager)
 
+void ULyraExperienceManager::PrefetchExperience(FPrimaryAssetId ExperienceId, bool bWillHost)
+{
+	if (!ExperienceId.IsValid() || ExperiencePrefetches.Contains(ExperienceId))
+	{
+		return;
+	}
+
+	// Only the latest guess is worth keeping in memory
+	CancelExperiencePrefetches();
+
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	const FSoftObjectPath AssetPath = AssetManager.GetPrimaryAssetPath(ExperienceId);
+	if (!AssetPath.IsValid())
+	{
+		UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Can't prefetch %s, it isn't a known primary asset"), *ExperienceId.ToString());
+		return;
+	}
+
+	UE_LOG(LogLyraExperience, Log, TEXT("EXPERIENCE: Prefetching %s"), *ExperienceId.ToString());
+
+	// The definition may already be in memory, in which case the delegate runs before this returns
+	ExperiencePrefetches.Add(ExperienceId);
+	TSharedPtr<FStreamableHandle> DefinitionHandle = AssetManager.GetStreamableManager().RequestAsyncLoad(AssetPath,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnPrefetchDefinitionLoaded, ExperienceId, bWillHost),
+		FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("PrefetchExperience"));
+
+	if (FLyraExperiencePrefetch* Prefetch = ExperiencePrefetches.Find(ExperienceId))
+	{
+		Prefetch->DefinitionHandle = DefinitionHandle;
+	}
+}
+
+void ULyraExperienceManager::OnPrefetchDefinitionLoaded(FPrimaryAssetId ExperienceId, bool bWillHost)
+{
+	FLyraExperiencePrefetch* Prefetch = ExperiencePrefetches.Find(ExperienceId);
+	if (Prefetch == nullptr)
+	{
+		// Released or replaced while the definition was loading
+		return;
+	}
+
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	UObject* LoadedObject = AssetManager.GetPrimaryAssetPath(ExperienceId).ResolveObject();
+
+	// User facing experiences (what sessions advertise) just point at the experience to prefetch
+	if (const ULyraUserFacingExperienceDefinition* UserFacingExperience = Cast<ULyraUserFacingExperienceDefinition>(LoadedObject))
+	{
+		PrefetchExperience(UserFacingExperience->ExperienceID, bWillHost);
+		return;
+	}
+
+	const UClass* ExperienceClass = Cast<UClass>(LoadedObject);
+	const ULyraExperienceDefinition* Experience = (ExperienceClass && ExperienceClass->IsChildOf<ULyraExperienceDefinition>()) ? GetDefault<ULyraExperienceDefinition>(ExperienceClass) : nullptr;
+	if (Experience == nullptr)
+	{
+		UE_LOG(LogLyraExperience, Warning, TEXT("EXPERIENCE: Prefetch of %s failed, it isn't an experience definition"), *ExperienceId.ToString());
+		ExperiencePrefetches.Remove(ExperienceId);
+		return;
+	}
+
+	// The world the experience will be loaded in doesn't exist yet, so go by the role this process will have in it
+	const ENetMode ExpectedNetMode = IsRunningDedicatedServer() ? NM_DedicatedServer : (bWillHost ? NM_ListenServer : NM_Client);
+
+	// Preloaded rather than loaded, so nothing stays in memory once the handle is released unless the experience itself loads it
+	Prefetch->BundlesHandle = AssetManager.PreloadPrimaryAssets(GetBundleAssetList(*Experience), GetBundlesToLoad(ExpectedNetMode), false);
+}
+
+void ULyraExperienceManager::ReleaseExperiencePrefetch(FPrimaryAssetId ExperienceId)
+{
+	FLyraExperiencePrefetch Prefetch;
+	if (ExperiencePrefetches.RemoveAndCopyValue(ExperienceId, /*out*/ Prefetch))
+	{
+		if (Prefetch.DefinitionHandle.IsValid())
+		{
+			Prefetch.DefinitionHandle->ReleaseHandle();
+		}
+		if (Prefetch.BundlesHandle.IsValid())
+		{
+			Prefetch.BundlesHandle->ReleaseHandle();
+		}
+	}
+}
+
+void ULyraExperienceManager::CancelExperiencePrefetches()
+{
+	for (const TPair<FPrimaryAssetId, FLyraExperiencePrefetch>& Pair : ExperiencePrefetches)
+	{
+		if (Pair.Value.DefinitionHandle.IsValid())
+		{
+			Pair.Value.DefinitionHandle->CancelHandle();
+		}
+		if (Pair.Value.BundlesHandle.IsValid())
+		{
+			Pair.Value.BundlesHandle->CancelHandle();
+		}
+	}
+
+	ExperiencePrefetches.Reset();
+}
+
+TArray<FName> ULyraExperienceManager::GetBundlesToLoad(ENetMode NetMode)
+{
+	//@TODO: Centralize this client/server stuff into the LyraAssetManager
+	const bool bLoadClient = GIsEditor || (NetMode != NM_DedicatedServer);
+	const bool bLoadServer = GIsEditor || (NetMode != NM_Client);
+
+	TArray<FName> BundlesToLoad;
+	BundlesToLoad.Add(FLyraBundles::Equipped);
+
+	if (bLoadClient)
+	{
+		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+	}
+	if (bLoadServer)
+	{
+		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+	}
+
+	return BundlesToLoad;
+}
+
+TArray<FPrimaryAssetId> ULyraExperienceManager::GetBundleAssetList(const ULyraExperienceDefinition& Experience)
+{
+	TArray<FPrimaryAssetId> BundleAssetList;
+
+	BundleAssetList.Add(Experience.GetPrimaryAssetId());
+	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : Experience.ActionSets)
+	{
+		if (ActionSet != nullptr)
+		{
+			BundleAssetList.AddUnique(ActionSet->GetPrimaryAssetId());
+		}
+	}
+
+	return BundleAssetList;
+}
+
 #if WITH_EDITOR
 
 void ULyraExperienceManager::OnPlayInEditorBegun()
@@ -2,9 +2,13 @@
 
 #pragma once
 
+#include "Engine/EngineBaseTypes.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "LyraExperienceManager.generated.h"
 
+class ULyraExperienceDefinition;
+struct FStreamableHandle;
+
 /**
  * Manager for experiences - primarily for arbitration between multiple PIE sessions
  */
@@ -14,6 +18,25 @@ class ULyraExperienceManager : public UEngineSubsystem
 	GENERATED_BODY()
 
 public:
+	/**
+	 * Speculatively starts streaming an experience (its definition, action sets and their bundles) before any game state asks for it,
+	 * e.g., as soon as a session is hosted or joined, so less of the load is left for the loading screen after map travel.
+	 * Accepts either a LyraExperienceDefinition or a LyraUserFacingExperienceDefinition id. Only the latest prefetch is kept.
+	 *
+	 * @param bWillHost		True if this process will be the server for the experience (also preloads server bundles)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Lyra|Experience")
+	LYRAGAME_API void PrefetchExperience(FPrimaryAssetId ExperienceId, bool bWillHost);
+
+	// Releases a prefetch once the experience itself has loaded (or is no longer expected)
+	LYRAGAME_API void ReleaseExperiencePrefetch(FPrimaryAssetId ExperienceId);
+
+	// Returns the bundles an experience loads in a world with the given net mode (the editor always loads both client and server bundles)
+	static LYRAGAME_API TArray<FName> GetBundlesToLoad(ENetMode NetMode);
+
+	// Returns the primary assets whose bundles make up an experience
+	static LYRAGAME_API TArray<FPrimaryAssetId> GetBundleAssetList(const ULyraExperienceDefinition& Experience);
+
 #if WITH_EDITOR
 	LYRAGAME_API void OnPlayInEditorBegun();
 
@@ -25,6 +48,19 @@ public:
 #endif
 
 private:
+	void OnPrefetchDefinitionLoaded(FPrimaryAssetId ExperienceId, bool bWillHost);
+	void CancelExperiencePrefetches();
+
+private:
+	struct FLyraExperiencePrefetch
+	{
+		TSharedPtr<FStreamableHandle> DefinitionHandle;
+		TSharedPtr<FStreamableHandle> BundlesHandle;
+	};
+
+	// Prefetches in flight (or completed and waiting to be used), by experience id
+	TMap<FPrimaryAssetId, FLyraExperiencePrefetch> ExperiencePrefetches;
+
 	// The map of requests to active count for a given game feature plugin
 	// (to allow first in, last out activation management during PIE)
 	TMap<FString, int32> GameFeaturePluginRequestCountMap;
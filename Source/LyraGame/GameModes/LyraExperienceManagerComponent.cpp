@@ -16,7 +16,6 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraExperienceManagerComponent)
 
-//@TODO: Async load the experience definition itself
 //@TODO: Handle failures explicitly (go into a 'completed but failed' state rather than check()-ing)
 //@TODO: Do the action phases at the appropriate times instead of all at once
 //@TODO: Support deactivating an experience and do the unloading actions
@@ -55,15 +54,39 @@ ULyraExperienceManagerComponent::ULyraExperienceManagerComponent(const FObjectIn
 
 void ULyraExperienceManagerComponent::SetCurrentExperience(FPrimaryAssetId ExperienceId)
 {
+	check(CurrentExperience == nullptr);
+	check(LoadState == ELyraExperienceLoadState::Unloaded);
+
 	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
 	FSoftObjectPath AssetPath = AssetManager.GetPrimaryAssetPath(ExperienceId);
-	TSubclassOf<ULyraExperienceDefinition> AssetClass = Cast<UClass>(AssetPath.TryLoad());
+	check(AssetPath.IsValid());
+
+	// Stream the definition in, it is usually already in memory (or on its way) if the experience was prefetched
+	LoadState = ELyraExperienceLoadState::LoadingDefinition;
+	TSharedPtr<FStreamableHandle> Handle = AssetManager.GetStreamableManager().RequestAsyncLoad(AssetPath,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnExperienceDefinitionLoaded, AssetPath),
+		FStreamableManager::AsyncLoadHighPriority, false, false, TEXT("SetCurrentExperience()"));
+
+	// The delegate may have already run if the definition was loaded
+	if (LoadState == ELyraExperienceLoadState::LoadingDefinition)
+	{
+		ExperienceDefinitionLoadHandle = Handle;
+	}
+}
+
+void ULyraExperienceManagerComponent::OnExperienceDefinitionLoaded(FSoftObjectPath AssetPath)
+{
+	check(LoadState == ELyraExperienceLoadState::LoadingDefinition);
+	ExperienceDefinitionLoadHandle.Reset();
+
+	TSubclassOf<ULyraExperienceDefinition> AssetClass = Cast<UClass>(AssetPath.ResolveObject());
 	check(AssetClass);
 	const ULyraExperienceDefinition* Experience = GetDefault<ULyraExperienceDefinition>(AssetClass);
 
 	check(Experience != nullptr);
 	check(CurrentExperience == nullptr);
 	CurrentExperience = Experience;
+	LoadState = ELyraExperienceLoadState::Unloaded;
 	StartExperienceLoad();
 }
 
@@ -131,42 +154,66 @@ void ULyraExperienceManagerComponent::StartExperienceLoad()
 
 	LoadState = ELyraExperienceLoadState::Loading;
 
-	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
+	GameFeaturePluginURLs.Reset();
 
-	TSet<FPrimaryAssetId> BundleAssetList;
-	TSet<FSoftObjectPath> RawAssetList;
+	auto CollectGameFeaturePluginURLs = [This=this](const UPrimaryDataAsset* Context, const TArray<FString>& FeaturePluginList)
+	{
+		for (const FString& PluginName : FeaturePluginList)
+		{
+			FString PluginURL;
+			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
+			{
+				This->GameFeaturePluginURLs.AddUnique(PluginURL);
+			}
+			else
+			{
+				ensureMsgf(false, TEXT("StartExperienceLoad failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
+			}
+		}
+
+		// 		// Add in our extra plugin
+		// 		if (!CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent.IsEmpty())
+		// 		{
+		// 			FString PluginURL;
+		// 			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent, PluginURL))
+		// 			{
+		// 				GameFeaturePluginURLs.AddUnique(PluginURL);
+		// 			}
+		// 		}
+	};
 
-	BundleAssetList.Add(CurrentExperience->GetPrimaryAssetId());
+	CollectGameFeaturePluginURLs(CurrentExperience, CurrentExperience->GameFeaturesToEnable);
 	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
 	{
 		if (ActionSet != nullptr)
 		{
-			BundleAssetList.Add(ActionSet->GetPrimaryAssetId());
+			CollectGameFeaturePluginURLs(ActionSet, ActionSet->GameFeaturesToEnable);
 		}
 	}
 
-	// Load assets associated with the experience
-
-	TArray<FName> BundlesToLoad;
-	BundlesToLoad.Add(FLyraBundles::Equipped);
-
-	//@TODO: Centralize this client/server stuff into the LyraAssetManager
-	const ENetMode OwnerNetMode = GetOwner()->GetNetMode();
-	const bool bLoadClient = GIsEditor || (OwnerNetMode != NM_DedicatedServer);
-	const bool bLoadServer = GIsEditor || (OwnerNetMode != NM_Client);
-	if (bLoadClient)
-	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
-	}
-	if (bLoadServer)
+	// Load and activate the features while the bundles below are streaming, the action sets are hard references of the experience so the plugin list is already known
+	// Completion is only acted on once the bundles have loaded too (see OnExperienceLoadComplete)
+	NumGameFeaturePluginsLoading = GameFeaturePluginURLs.Num();
+	for (const FString& PluginURL : GameFeaturePluginURLs)
 	{
-		BundlesToLoad.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+		ULyraExperienceManager::NotifyOfPluginActivation(PluginURL);
+		UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete));
 	}
 
+	ULyraAssetManager& AssetManager = ULyraAssetManager::Get();
+
+	const TArray<FPrimaryAssetId> BundleAssetList = ULyraExperienceManager::GetBundleAssetList(*CurrentExperience);
+	TSet<FSoftObjectPath> RawAssetList;
+
+	// Load assets associated with the experience
+
+	const TArray<FName> BundlesToLoad = ULyraExperienceManager::GetBundlesToLoad(GetOwner()->GetNetMode());
+
 	TSharedPtr<FStreamableHandle> BundleLoadHandle = nullptr;
 	if (BundleAssetList.Num() > 0)
 	{
-		BundleLoadHandle = AssetManager.ChangeBundleStateForPrimaryAssets(BundleAssetList.Array(), BundlesToLoad, {}, false, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+		BundleLoadHandle = AssetManager.ChangeBundleStateForPrimaryAssets(BundleAssetList, BundlesToLoad, {}, false, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
 	}
 
 	TSharedPtr<FStreamableHandle> RawLoadHandle = nullptr;
@@ -220,54 +267,13 @@ void ULyraExperienceManagerComponent::OnExperienceLoadComplete()
 		*CurrentExperience->GetPrimaryAssetId().ToString(),
 		*GetClientServerContextString(this));
 
-	// find the URLs for our GameFeaturePlugins - filtering out dupes and ones that don't have a valid mapping
-	GameFeaturePluginURLs.Reset();
+	// Anything prefetched for this experience is now held by the experience itself
+	GEngine->GetEngineSubsystem<ULyraExperienceManager>()->ReleaseExperiencePrefetch(CurrentExperience->GetPrimaryAssetId());
 
-	auto CollectGameFeaturePluginURLs = [This=this](const UPrimaryDataAsset* Context, const TArray<FString>& FeaturePluginList)
-	{
-		for (const FString& PluginName : FeaturePluginList)
-		{
-			FString PluginURL;
-			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(PluginName, /*out*/ PluginURL))
-			{
-				This->GameFeaturePluginURLs.AddUnique(PluginURL);
-			}
-			else
-			{
-				ensureMsgf(false, TEXT("OnExperienceLoadComplete failed to find plugin URL from PluginName %s for experience %s - fix data, ignoring for this run"), *PluginName, *Context->GetPrimaryAssetId().ToString());
-			}
-		}
-
-		// 		// Add in our extra plugin
-		// 		if (!CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent.IsEmpty())
-		// 		{
-		// 			FString PluginURL;
-		// 			if (UGameFeaturesSubsystem::Get().GetPluginURLByName(CurrentPlaylistData->GameFeaturePluginToActivateUntilDownloadedContentIsPresent, PluginURL))
-		// 			{
-		// 				GameFeaturePluginURLs.AddUnique(PluginURL);
-		// 			}
-		// 		}
-	};
-
-	CollectGameFeaturePluginURLs(CurrentExperience, CurrentExperience->GameFeaturesToEnable);
-	for (const TObjectPtr<ULyraExperienceActionSet>& ActionSet : CurrentExperience->ActionSets)
-	{
-		if (ActionSet != nullptr)
-		{
-			CollectGameFeaturePluginURLs(ActionSet, ActionSet->GameFeaturesToEnable);
-		}
-	}
-
-	// Load and activate the features	
-	NumGameFeaturePluginsLoading = GameFeaturePluginURLs.Num();
+	// Wait for any features that are still activating
 	if (NumGameFeaturePluginsLoading > 0)
 	{
 		LoadState = ELyraExperienceLoadState::LoadingGameFeatures;
-		for (const FString& PluginURL : GameFeaturePluginURLs)
-		{
-			ULyraExperienceManager::NotifyOfPluginActivation(PluginURL);
-			UGameFeaturesSubsystem::Get().LoadAndActivateGameFeaturePlugin(PluginURL, FGameFeaturePluginLoadComplete::CreateUObject(this, &ThisClass::OnGameFeaturePluginLoadComplete));
-		}
 	}
 	else
 	{
@@ -280,7 +286,8 @@ void ULyraExperienceManagerComponent::OnGameFeaturePluginLoadComplete(const UE::
 	// decrement the number of plugins that are loading
 	NumGameFeaturePluginsLoading--;
 
-	if (NumGameFeaturePluginsLoading == 0)
+	// While still Loading the bundles haven't finished, OnExperienceLoadComplete will pick this up
+	if ((NumGameFeaturePluginsLoading == 0) && (LoadState == ELyraExperienceLoadState::LoadingGameFeatures))
 	{
 		OnExperienceFullLoadCompleted();
 	}
@@ -381,6 +388,13 @@ void ULyraExperienceManagerComponent::EndPlay(const EEndPlayReason::Type EndPlay
 {
 	Super::EndPlay(EndPlayReason);
 
+	if (ExperienceDefinitionLoadHandle.IsValid())
+	{
+		ExperienceDefinitionLoadHandle->CancelHandle();
+		ExperienceDefinitionLoadHandle.Reset();
+		LoadState = ELyraExperienceLoadState::Unloaded;
+	}
+
 	// deactivate any features this experience loaded
 	//@TODO: This should be handled FILO as well
 	for (const FString& PluginURL : GameFeaturePluginURLs)
@@ -12,12 +12,14 @@
 namespace UE::GameFeatures { struct FResult; }
 
 class ULyraExperienceDefinition;
+struct FStreamableHandle;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnLyraExperienceLoaded, const ULyraExperienceDefinition* /*Experience*/);
 
 enum class ELyraExperienceLoadState
 {
 	Unloaded,
+	LoadingDefinition,
 	Loading,
 	LoadingGameFeatures,
 	LoadingChaosTestingDelay,
@@ -70,6 +72,7 @@ private:
 	UFUNCTION()
 	void OnRep_CurrentExperience();
 
+	void OnExperienceDefinitionLoaded(FSoftObjectPath AssetPath);
 	void StartExperienceLoad();
 	void OnExperienceLoadComplete();
 	void OnGameFeaturePluginLoadComplete(const UE::GameFeatures::FResult& Result);
@@ -84,6 +87,9 @@ private:
 
 	ELyraExperienceLoadState LoadState = ELyraExperienceLoadState::Unloaded;
 
+	// Async load of the experience definition on the authority, until it completes and CurrentExperience is set
+	TSharedPtr<FStreamableHandle> ExperienceDefinitionLoadHandle;
+
 	int32 NumGameFeaturePluginsLoading = 0;
 	TArray<FString> GameFeaturePluginURLs;
 
@@ -6,6 +6,7 @@
 #include "UObject/NameTypes.h"
 #include "Engine/GameInstance.h"
 #include "Engine/Engine.h"
+#include "GameModes/LyraExperienceManager.h"
 #include "Replays/LyraReplaySubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraUserFacingExperienceDefinition)
@@ -40,6 +41,12 @@ UCommonSession_HostSessionRequest* ULyraUserFacingExperienceDefinition::CreateHo
 	Result->ExtraArgs.Add(TEXT("Experience"), ExperienceName);
 	Result->MaxPlayerCount = MaxPlayerCount;
 
+	// Start streaming the experience while the session is created and the map loads
+	if (ULyraExperienceManager* ExperienceManager = GEngine->GetEngineSubsystem<ULyraExperienceManager>())
+	{
+		ExperienceManager->PrefetchExperience(ExperienceID, /*bWillHost=*/ true);
+	}
+
 	if (ULyraReplaySubsystem::DoesPlatformSupportReplays())
 	{
 		if (bRecordReplay)
@@ -27,21 +27,17 @@ void FGameplayTagStackContainer::AddStack(FGameplayTag Tag, int32 StackCount)
 
 	if (StackCount > 0)
 	{
-		for (FGameplayTagStack& Stack : Stacks)
+		if (const int32* IndexPtr = TagToIndex.Find(Tag))
 		{
-			if (Stack.Tag == Tag)
-			{
-				const int32 NewCount = Stack.StackCount + StackCount;
-				Stack.StackCount = NewCount;
-				TagToCountMap[Tag] = NewCount;
-				MarkItemDirty(Stack);
-				return;
-			}
+			FGameplayTagStack& Stack = Stacks[*IndexPtr];
+			Stack.StackCount += StackCount;
+			MarkItemDirty(Stack);
+			return;
 		}
 
-		FGameplayTagStack& NewStack = Stacks.Emplace_GetRef(Tag, StackCount);
-		MarkItemDirty(NewStack);
-		TagToCountMap.Add(Tag, StackCount);
+		const int32 NewIndex = Stacks.Emplace(Tag, StackCount);
+		MarkItemDirty(Stacks[NewIndex]);
+		TagToIndex.Add(Tag, NewIndex);
 	}
 }
 
@@ -56,45 +52,44 @@ void FGameplayTagStackContainer::RemoveStack(FGameplayTag Tag, int32 StackCount)
 	//@TODO: Should we error if you try to remove a stack that doesn't exist or has a smaller count?
 	if (StackCount > 0)
 	{
-		for (auto It = Stacks.CreateIterator(); It; ++It)
+		if (const int32* IndexPtr = TagToIndex.Find(Tag))
 		{
-			FGameplayTagStack& Stack = *It;
-			if (Stack.Tag == Tag)
+			FGameplayTagStack& Stack = Stacks[*IndexPtr];
+			if (Stack.StackCount > 0)
 			{
-				if (Stack.StackCount <= StackCount)
-				{
-					It.RemoveCurrent();
-					TagToCountMap.Remove(Tag);
-					MarkArrayDirty();
-				}
-				else
-				{
-					const int32 NewCount = Stack.StackCount - StackCount;
-					Stack.StackCount = NewCount;
-					TagToCountMap[Tag] = NewCount;
-					MarkItemDirty(Stack);
-				}
-				return;
+				// Emptied items stay in the list so removal only has to replicate this item
+				Stack.StackCount = FMath::Max(Stack.StackCount - StackCount, 0);
+				MarkItemDirty(Stack);
 			}
 		}
 	}
 }
 
+void FGameplayTagStackContainer::RebuildTagToIndex()
+{
+	TagToIndex.Reset();
+	for (int32 Index = 0; Index < Stacks.Num(); ++Index)
+	{
+		TagToIndex.Add(Stacks[Index].Tag, Index);
+	}
+	bTagToIndexNeedsRebuild = false;
+}
+
 void FGameplayTagStackContainer::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
+	// The remaining items get compacted after this, so the indices are fixed up once the whole update has been received
 	for (int32 Index : RemovedIndices)
 	{
-		const FGameplayTag Tag = Stacks[Index].Tag;
-		TagToCountMap.Remove(Tag);
+		TagToIndex.Remove(Stacks[Index].Tag);
 	}
+	bTagToIndexNeedsRebuild = true;
 }
 
 void FGameplayTagStackContainer::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
 	for (int32 Index : AddedIndices)
 	{
-		const FGameplayTagStack& Stack = Stacks[Index];
-		TagToCountMap.Add(Stack.Tag, Stack.StackCount);
+		TagToIndex.Add(Stacks[Index].Tag, Index);
 	}
 }
 
@@ -102,8 +97,14 @@ void FGameplayTagStackContainer::PostReplicatedChange(const TArrayView<int32> Ch
 {
 	for (int32 Index : ChangedIndices)
 	{
-		const FGameplayTagStack& Stack = Stacks[Index];
-		TagToCountMap[Stack.Tag] = Stack.StackCount;
+		TagToIndex.Add(Stacks[Index].Tag, Index);
 	}
 }
 
+void FGameplayTagStackContainer::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (bTagToIndexNeedsRebuild)
+	{
+		RebuildTagToIndex();
+	}
+}
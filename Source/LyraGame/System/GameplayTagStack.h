@@ -39,7 +39,14 @@ private:
 	int32 StackCount = 0;
 };
 
-/** Container of gameplay tag stacks */
+/**
+ * Container of gameplay tag stacks
+ *
+ * Each tag owns a single item for the lifetime of the container, found through TagToIndex, so adding, removing
+ * and querying stacks never searches the list. When the last stack of a tag is removed its item is kept with
+ * a count of zero and reused if the tag is added again; this keeps replication IDs stable so removal only
+ * dirties that one item instead of forcing the whole array to be rebuilt on every client.
+ */
 USTRUCT(BlueprintType)
 struct FGameplayTagStackContainer : public FFastArraySerializer
 {
@@ -60,19 +67,21 @@ public:
 	// Returns the stack count of the specified tag (or 0 if the tag is not present)
 	int32 GetStackCount(FGameplayTag Tag) const
 	{
-		return TagToCountMap.FindRef(Tag);
+		const int32* IndexPtr = TagToIndex.Find(Tag);
+		return IndexPtr ? Stacks[*IndexPtr].StackCount : 0;
 	}
 
 	// Returns true if there is at least one stack of the specified tag
 	bool ContainsTag(FGameplayTag Tag) const
 	{
-		return TagToCountMap.Contains(Tag);
+		return GetStackCount(Tag) > 0;
 	}
 
 	//~FFastArraySerializer contract
 	void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
 	void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
 	void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
 	//~End of FFastArraySerializer contract
 
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
@@ -84,9 +93,14 @@ private:
 	// Replicated list of gameplay tag stacks
 	UPROPERTY()
 	TArray<FGameplayTagStack> Stacks;
-	
-	// Accelerated list of tag stacks for queries
-	TMap<FGameplayTag, int32> TagToCountMap;
+
+	// Index of the item for each tag in Stacks (including emptied items, which have a count of zero)
+	TMap<FGameplayTag, int32> TagToIndex;
+
+	// Set on clients when the server removed items, which can move the remaining items around
+	bool bTagToIndexNeedsRebuild = false;
+
+	void RebuildTagToIndex();
 };
 
 template<>
@@ -12,6 +12,7 @@
 #include "AbilitySystem/LyraGameplayCueManager.h"
 #include "Misc/ScopedSlowTask.h"
 #include "System/LyraAssetManagerStartupJob.h"
+#include "Tasks/Task.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraAssetManager)
 
@@ -30,6 +31,12 @@ static FAutoConsoleCommand CVarDumpLoadedAssets(
 #define STARTUP_JOB_WEIGHTED(JobFunc, JobWeight) StartupJobs.Add(FLyraAssetManagerStartupJob(#JobFunc, [this](const FLyraAssetManagerStartupJob& StartupJob, TSharedPtr<FStreamableHandle>& LoadHandle){JobFunc;}, JobWeight))
 #define STARTUP_JOB(JobFunc) STARTUP_JOB_WEIGHTED(JobFunc, 1.f)
 
+// The job macros return the index of the job, which later jobs can list as prerequisites
+#define STARTUP_JOB_WEIGHTED_AFTER(JobFunc, JobWeight, ...) StartupJobs[STARTUP_JOB_WEIGHTED(JobFunc, JobWeight)].Prerequisites.Append({__VA_ARGS__})
+
+// For jobs that don't touch UObjects, they run on a worker thread
+#define STARTUP_JOB_ANY_THREAD(JobFunc, JobWeight) StartupJobs[STARTUP_JOB_WEIGHTED(JobFunc, JobWeight)].bCanRunOnAnyThread = true
+
 //////////////////////////////////////////////////////////////////////
 
 ULyraAssetManager::ULyraAssetManager()
@@ -110,11 +117,14 @@ void ULyraAssetManager::StartInitialLoading()
 	// This does all of the scanning, need to do this now even if loads are deferred
 	Super::StartInitialLoading();
 
+	// Start streaming the base game data asset first, it loads while the jobs that don't need it run
+	const int32 StreamGameDataJob = STARTUP_JOB_WEIGHTED(LoadHandle = StartLoadingGameData(), 20.f);
+
 	STARTUP_JOB(InitializeGameplayCueManager());
 
 	{
 		// Load base game data asset
-		STARTUP_JOB_WEIGHTED(GetGameData(), 25.f);
+		STARTUP_JOB_WEIGHTED_AFTER(GetGameData(), 5.f, StreamGameDataJob);
 	}
 
 	// Run all the queued up startup jobs
@@ -136,6 +146,17 @@ const ULyraGameData& ULyraAssetManager::GetGameData()
 	return GetOrLoadTypedGameData<ULyraGameData>(LyraGameDataPath);
 }
 
+TSharedPtr<FStreamableHandle> ULyraAssetManager::StartLoadingGameData()
+{
+	// The editor loads game data synchronously on demand (see LoadGameDataOfClass)
+	if (GIsEditor || LyraGameDataPath.IsNull() || GameDataMap.Contains(ULyraGameData::StaticClass()))
+	{
+		return nullptr;
+	}
+
+	return LoadPrimaryAssetsWithType(ULyraGameData::StaticClass()->GetFName());
+}
+
 const ULyraPawnData* ULyraAssetManager::GetDefaultPawnData() const
 {
 	return GetAsset(DefaultPawnData);
@@ -195,51 +216,174 @@ void ULyraAssetManager::DoAllStartupJobs()
 	SCOPED_BOOT_TIMING("ULyraAssetManager::DoAllStartupJobs");
 	const double AllStartupJobsStartTime = FPlatformTime::Seconds();
 
-	if (IsRunningDedicatedServer())
+	// No need for periodic progress updates on dedicated servers
+	const bool bReportProgress = !IsRunningDedicatedServer();
+	const int32 NumJobs = StartupJobs.Num();
+
+	// Build the task graph, prerequisites can only be jobs added earlier so it has no cycles
+	TArray<int32> NumUnfinishedPrerequisites;
+	NumUnfinishedPrerequisites.SetNumZeroed(NumJobs);
+	TArray<TArray<int32>> Dependents;
+	Dependents.SetNum(NumJobs);
+
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
 	{
-		// No need for periodic progress updates, just run the jobs
-		for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+		for (const int32 PrerequisiteIndex : StartupJobs[JobIndex].Prerequisites)
 		{
-			StartupJob.DoJob();
+			if (ensureMsgf((PrerequisiteIndex >= 0) && (PrerequisiteIndex < JobIndex), TEXT("Startup job \"%s\" can only depend on jobs added before it"), *StartupJobs[JobIndex].JobName))
+			{
+				Dependents[PrerequisiteIndex].Add(JobIndex);
+				++NumUnfinishedPrerequisites[JobIndex];
+			}
 		}
 	}
-	else
+
+	// Progress is the weighted sum of every job's progress, jobs that are running at the same time all contribute
+	float TotalJobValue = 0.0f;
+	for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+	{
+		TotalJobValue += StartupJob.JobWeight;
+	}
+
+	TArray<float> JobProgress;
+	JobProgress.SetNumZeroed(NumJobs);
+
+	auto UpdateOverallProgress = [this, &JobProgress, TotalJobValue]()
 	{
-		if (StartupJobs.Num() > 0)
+		float AccumulatedJobValue = 0.0f;
+		for (int32 JobIndex = 0; JobIndex < JobProgress.Num(); ++JobIndex)
 		{
-			float TotalJobValue = 0.0f;
-			for (const FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+			AccumulatedJobValue += JobProgress[JobIndex] * StartupJobs[JobIndex].JobWeight;
+		}
+
+		UpdateInitialGameContentLoadPercent((TotalJobValue > 0.0f) ? (AccumulatedJobValue / TotalJobValue) : 1.0f);
+	};
+
+	// Jobs are started in the order they were added once their prerequisites are met
+	TArray<int32> ReadyJobs;
+	for (int32 JobIndex = 0; JobIndex < NumJobs; ++JobIndex)
+	{
+		if (NumUnfinishedPrerequisites[JobIndex] == 0)
+		{
+			ReadyJobs.Add(JobIndex);
+		}
+	}
+
+	TArray<TPair<int32, TSharedPtr<FStreamableHandle>>> LoadingJobs;
+	TArray<TPair<int32, UE::Tasks::FTask>> WorkerJobs;
+	int32 NumFinishedJobs = 0;
+
+	auto FinishJob = [&](int32 JobIndex, const TSharedPtr<FStreamableHandle>& Handle)
+	{
+		FLyraAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+		StartupJob.FinishJob(Handle);
+		StartupJob.SubstepProgressDelegate.Unbind();
+
+		JobProgress[JobIndex] = 1.0f;
+		++NumFinishedJobs;
+
+		for (int32 DependentIndex : Dependents[JobIndex])
+		{
+			if (--NumUnfinishedPrerequisites[DependentIndex] == 0)
 			{
-				TotalJobValue += StartupJob.JobWeight;
+				ReadyJobs.Add(DependentIndex);
 			}
+		}
 
-			float AccumulatedJobValue = 0.0f;
-			for (FLyraAssetManagerStartupJob& StartupJob : StartupJobs)
+		if (bReportProgress)
+		{
+			UpdateOverallProgress();
+		}
+	};
+
+	while (NumFinishedJobs < NumJobs)
+	{
+		// Start everything that is ready. Worker jobs, game thread jobs and the loads they started all run at the same time
+		while (ReadyJobs.Num() > 0)
+		{
+			const int32 JobIndex = ReadyJobs[0];
+			ReadyJobs.RemoveAt(0, EAllowShrinking::No);
+
+			FLyraAssetManagerStartupJob& StartupJob = StartupJobs[JobIndex];
+			if (StartupJob.bCanRunOnAnyThread)
 			{
-				const float JobValue = StartupJob.JobWeight;
-				StartupJob.SubstepProgressDelegate.BindLambda([This = this, AccumulatedJobValue, JobValue, TotalJobValue](float NewProgress)
+				WorkerJobs.Emplace(JobIndex, UE::Tasks::Launch(UE_SOURCE_LOCATION, [&StartupJob]()
 					{
-						const float SubstepAdjustment = FMath::Clamp(NewProgress, 0.0f, 1.0f) * JobValue;
-						const float OverallPercentWithSubstep = (AccumulatedJobValue + SubstepAdjustment) / TotalJobValue;
+						const TSharedPtr<FStreamableHandle> Handle = StartupJob.StartJob();
+						ensureMsgf(!Handle.IsValid(), TEXT("Startup job \"%s\" runs on a worker thread, so it can't load assets"), *StartupJob.JobName);
+					}));
+				continue;
+			}
 
-						This->UpdateInitialGameContentLoadPercent(OverallPercentWithSubstep);
+			if (bReportProgress)
+			{
+				StartupJob.SubstepProgressDelegate.BindLambda([&JobProgress, &UpdateOverallProgress, JobIndex](float NewProgress)
+					{
+						JobProgress[JobIndex] = FMath::Clamp(NewProgress, 0.0f, 1.0f);
+						UpdateOverallProgress();
 					});
+			}
 
-				StartupJob.DoJob();
+			TSharedPtr<FStreamableHandle> Handle = StartupJob.StartJob();
+			if (Handle.IsValid() && Handle->IsLoadingInProgress())
+			{
+				LoadingJobs.Emplace(JobIndex, Handle);
+			}
+			else
+			{
+				FinishJob(JobIndex, Handle);
+			}
+		}
 
-				StartupJob.SubstepProgressDelegate.Unbind();
+		if (NumFinishedJobs == NumJobs)
+		{
+			break;
+		}
 
-				AccumulatedJobValue += JobValue;
+		checkf((LoadingJobs.Num() > 0) || (WorkerJobs.Num() > 0), TEXT("Startup jobs are waiting on prerequisites that are not running"));
 
-				UpdateInitialGameContentLoadPercent(AccumulatedJobValue / TotalJobValue);
-			}
+		// Waiting on any handle keeps every outstanding load going, the timeout lets us finish whichever job completes first
+		if (LoadingJobs.Num() > 0)
+		{
+			LoadingJobs[0].Value->WaitUntilComplete(1.0f / 30.0f, false);
 		}
 		else
 		{
-			UpdateInitialGameContentLoadPercent(1.0f);
+			WorkerJobs[0].Value.Wait(FTimespan::FromSeconds(1.0 / 30.0));
+		}
+
+		for (int32 LoadingIndex = 0; LoadingIndex < LoadingJobs.Num(); )
+		{
+			if (LoadingJobs[LoadingIndex].Value->IsLoadingInProgress())
+			{
+				++LoadingIndex;
+				continue;
+			}
+
+			const TPair<int32, TSharedPtr<FStreamableHandle>> FinishedJob = LoadingJobs[LoadingIndex];
+			LoadingJobs.RemoveAt(LoadingIndex, EAllowShrinking::No);
+			FinishJob(FinishedJob.Key, FinishedJob.Value);
+		}
+
+		for (int32 WorkerIndex = 0; WorkerIndex < WorkerJobs.Num(); )
+		{
+			if (!WorkerJobs[WorkerIndex].Value.IsCompleted())
+			{
+				++WorkerIndex;
+				continue;
+			}
+
+			const int32 FinishedJobIndex = WorkerJobs[WorkerIndex].Key;
+			WorkerJobs.RemoveAt(WorkerIndex, EAllowShrinking::No);
+			FinishJob(FinishedJobIndex, nullptr);
 		}
 	}
 
+	if (bReportProgress && (NumJobs == 0))
+	{
+		UpdateInitialGameContentLoadPercent(1.0f);
+	}
+
 	StartupJobs.Empty();
 
 	UE_LOG(LogLyra, Display, TEXT("All startup jobs took %.2f seconds to complete"), FPlatformTime::Seconds() - AllStartupJobsStartTime);
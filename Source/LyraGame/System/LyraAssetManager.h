@@ -51,6 +51,9 @@ public:
 	static UE_API void DumpLoadedAssets();
 
 	UE_API const ULyraGameData& GetGameData();
+
+	// Starts streaming the game data and its bundles without waiting, returns the handle of the load if there is one
+	UE_API TSharedPtr<FStreamableHandle> StartLoadingGameData();
 	UE_API const ULyraPawnData* GetDefaultPawnData() const;
 
 protected:
@@ -97,7 +100,7 @@ protected:
 	TSoftObjectPtr<ULyraPawnData> DefaultPawnData;
 
 private:
-	// Flushes the StartupJobs array. Processes all startup work.
+	// Flushes the StartupJobs array. Processes all startup work as a task graph, starting each job once its prerequisites have completed so independent jobs and their loads overlap.
 	UE_API void DoAllStartupJobs();
 
 	// Sets up the ability system
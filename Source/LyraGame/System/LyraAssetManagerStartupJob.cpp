@@ -3,23 +3,52 @@
 #include "LyraAssetManagerStartupJob.h"
 
 #include "LyraLogChannels.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
 
 TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::DoJob() const
 {
-	const double JobStartTime = FPlatformTime::Seconds();
+	TSharedPtr<FStreamableHandle> Handle = StartJob();
+
+	if (Handle.IsValid())
+	{
+		Handle->WaitUntilComplete(0.0f, false);
+	}
+
+	FinishJob(Handle);
+
+	return Handle;
+}
+
+TSharedPtr<FStreamableHandle> FLyraAssetManagerStartupJob::StartJob() const
+{
+	JobStartTime = FPlatformTime::Seconds();
 
 	TSharedPtr<FStreamableHandle> Handle;
 	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" starting"), *JobName);
-	JobFunc(*this, Handle);
+
+	// The region spans the whole job including its load, while the CPU scope only covers the time spent in the job function
+	TRACE_BEGIN_REGION(*JobName);
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*JobName);
+		JobFunc(*this, Handle);
+	}
 
 	if (Handle.IsValid())
 	{
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateRaw(this, &FLyraAssetManagerStartupJob::UpdateSubstepProgressFromStreamable));
-		Handle->WaitUntilComplete(0.0f, false);
+	}
+
+	return Handle;
+}
+
+void FLyraAssetManagerStartupJob::FinishJob(const TSharedPtr<FStreamableHandle>& Handle) const
+{
+	if (Handle.IsValid())
+	{
 		Handle->BindUpdateDelegate(FStreamableUpdateDelegate());
 	}
 
+	TRACE_END_REGION(*JobName);
 	UE_LOG(LogLyra, Display, TEXT("Startup job \"%s\" took %.2f seconds to complete"), *JobName, FPlatformTime::Seconds() - JobStartTime);
-
-	return Handle;
 }
@@ -14,6 +14,13 @@ struct FLyraAssetManagerStartupJob
 	FString JobName;
 	float JobWeight;
 	mutable double LastUpdate = 0;
+	mutable double JobStartTime = 0;
+
+	/** Indices of earlier jobs that must complete, including their loads, before this one starts. Jobs without a path between them run at the same time */
+	TArray<int32> Prerequisites;
+
+	/** Set for jobs that don't touch UObjects, they run on a worker thread alongside the game thread jobs and can't return a load handle */
+	bool bCanRunOnAnyThread = false;
 
 	/** Simple job that is all synchronous */
 	FLyraAssetManagerStartupJob(const FString& InJobName, const TFunction<void(const FLyraAssetManagerStartupJob&, TSharedPtr<FStreamableHandle>&)>& InJobFunc, float InJobWeight)
@@ -25,6 +32,12 @@ struct FLyraAssetManagerStartupJob
 	/** Perform actual loading, will return a handle if it created one */
 	TSharedPtr<FStreamableHandle> DoJob() const;
 
+	/** Runs the job function without waiting on the load it started, will return a handle if it created one */
+	TSharedPtr<FStreamableHandle> StartJob() const;
+
+	/** Called once the handle returned by StartJob (if any) has completed */
+	void FinishJob(const TSharedPtr<FStreamableHandle>& Handle) const;
+
 	void UpdateSubstepProgress(float NewProgress) const
 	{
 		SubstepProgressDelegate.ExecuteIfBound(NewProgress);
@@ -36,7 +49,7 @@ struct FLyraAssetManagerStartupJob
 		{
 			// StreamableHandle::GetProgress traverses() a large graph and is quite expensive
 			double Now = FPlatformTime::Seconds();
-			if (LastUpdate - Now > 1.0 / 60)
+			if (Now - LastUpdate > 1.0 / 60)
 			{
 				SubstepProgressDelegate.Execute(StreamableHandle->GetProgress());
 				LastUpdate = Now;
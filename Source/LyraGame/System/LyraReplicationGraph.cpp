@@ -36,9 +36,10 @@
 *		but currently not necessary.
 *		
 *		ULyraReplicationGraphNode_PlayerStateFrequencyLimiter
-*		A custom node for handling player state replication. This replicates a small rolling set of player states (currently 2/frame). This is so player states replicate
+*		A custom node for handling player state replication. This replicates a small rolling set of player states (at least 2/frame, more for large sessions). This is so player states replicate
 *		to simulated connections at a low, steady frequency, and to take advantage of serialization sharing. Auto proxy player states are replicated at higher frequency (to the
-*		owning connection only) via ULyraReplicationGraphNode_AlwaysRelevant_ForConnection.
+*		owning connection only) via ULyraReplicationGraphNode_AlwaysRelevant_ForConnection. Player states are NotRouted, the graph forwards their add/remove notifications
+*		to this node which keeps them in persistent buckets.
 *		
 *		UReplicationGraphNode_TearOff_ForConnection
 *		Connection specific node for handling tear off actors. This is created and managed in the base implementation of Replication Graph.
@@ -132,6 +133,24 @@ namespace Lyra::RepGraph
 	int32 EnableFastSharedPath = 1;
 	static FAutoConsoleVariableRef CVarLyraRepEnableFastSharedPath(TEXT("Lyra.RepGraph.EnableFastSharedPath"), EnableFastSharedPath, TEXT(""), ECVF_Default);
 
+	// Every player state should be sent to simulated connections at least this often. Large sessions grow the player state buckets to meet this, within the limits below.
+	float PlayerStateTargetCycleTime = 2.0f;
+	static FAutoConsoleVariableRef CVarLyraRepPlayerStateTargetCycleTime(TEXT("Lyra.RepGraph.PlayerStates.TargetCycleTime"), PlayerStateTargetCycleTime, TEXT("Seconds it should take to cycle through every player state bucket"), ECVF_Default);
+
+	// Fraction of the slowest connection's net speed that player states may use
+	float PlayerStateBandwidthPct = 0.1f;
+	static FAutoConsoleVariableRef CVarLyraRepPlayerStateBandwidthPct(TEXT("Lyra.RepGraph.PlayerStates.BandwidthPct"), PlayerStateBandwidthPct, TEXT("Fraction of the slowest connection's bandwidth player state buckets are sized for"), ECVF_Default);
+
+	int32 PlayerStateEstimatedBytes = 48;
+	static FAutoConsoleVariableRef CVarLyraRepPlayerStateEstimatedBytes(TEXT("Lyra.RepGraph.PlayerStates.EstimatedBytes"), PlayerStateEstimatedBytes, TEXT("Estimated size of a player state update, used to turn the bandwidth budget into a bucket size"), ECVF_Default);
+
+	// Total number of player state sends per frame, summed over every connection
+	int32 PlayerStateMaxSendsPerFrame = 1024;
+	static FAutoConsoleVariableRef CVarLyraRepPlayerStateMaxSendsPerFrame(TEXT("Lyra.RepGraph.PlayerStates.MaxSendsPerFrame"), PlayerStateMaxSendsPerFrame, TEXT("Caps the player state bucket size so bucket size * connection count stays under this"), ECVF_Default);
+
+	int32 PlayerStateCompactionMovesPerFrame = 4;
+	static FAutoConsoleVariableRef CVarLyraRepPlayerStateCompactionMovesPerFrame(TEXT("Lyra.RepGraph.PlayerStates.CompactionMovesPerFrame"), PlayerStateCompactionMovesPerFrame, TEXT("How many player states may be moved per frame to fill holes left by removed player states"), ECVF_Default);
+
 	UReplicationDriver* ConditionalCreateReplicationDriver(UNetDriver* ForNetDriver, UWorld* World)
 	{
 		// Only create for GameNetDriver
@@ -555,7 +574,7 @@ void ULyraReplicationGraph::InitGlobalGraphNodes()
 	// -----------------------------------------------
 	//	Player State specialization. This will return a rolling subset of the player states to replicate
 	// -----------------------------------------------
-	ULyraReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode = CreateNewNode<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	PlayerStateNode = CreateNewNode<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter>();
 	AddGlobalGraphNode(PlayerStateNode);
 }
 
@@ -586,6 +605,11 @@ void ULyraReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActo
 	{
 		case EClassRepNodeMapping::NotRouted:
 		{
+			// Player states are not routed to the regular nodes, the frequency limiter keeps its own persistent buckets of them
+			if (PlayerStateNode && ActorInfo.Class->IsChildOf(APlayerState::StaticClass()))
+			{
+				PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+			}
 			break;
 		}
 		
@@ -630,6 +654,10 @@ void ULyraReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedA
 	{
 		case EClassRepNodeMapping::NotRouted:
 		{
+			if (PlayerStateNode && ActorInfo.Class->IsChildOf(APlayerState::StaticClass()))
+			{
+				PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+			}
 			break;
 		}
 		
@@ -882,33 +910,215 @@ ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::ULyraReplicationGraphNode
 	bRequiresPrepareForReplicationCall = true;
 }
 
-void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (ActorToBucket.Contains(ActorInfo.Actor))
+	{
+		return;
+	}
+
+	if (BucketSize <= 0)
+	{
+		BucketSize = FMath::Max(TargetActorsPerFrame, 1);
+	}
+
+	// Prefer filling a hole over growing the last bucket, so removals followed by adds don't need compaction
+	while (UnderfilledBuckets.Num() > 0)
+	{
+		const int32 BucketIndex = UnderfilledBuckets.Pop(EAllowShrinking::No);
+		if (ReplicationActorLists.IsValidIndex(BucketIndex) && (ReplicationActorLists[BucketIndex].Num() < BucketSize))
+		{
+			AddToBucket(ActorInfo.Actor, BucketIndex);
+			if (ReplicationActorLists[BucketIndex].Num() < BucketSize)
+			{
+				UnderfilledBuckets.Push(BucketIndex);
+			}
+			return;
+		}
+	}
+
+	if ((ReplicationActorLists.Num() == 0) || (ReplicationActorLists.Last().Num() >= BucketSize))
+	{
+		ReplicationActorLists.AddDefaulted_GetRef().Reset(BucketSize);
+	}
+
+	AddToBucket(ActorInfo.Actor, ReplicationActorLists.Num() - 1);
+}
+
+bool ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	int32 BucketIndex = INDEX_NONE;
+	if (!ActorToBucket.RemoveAndCopyValue(ActorInfo.Actor, /*out*/ BucketIndex))
+	{
+		UE_CLOG(bWarnIfNotFound, LogLyraRepGraph, Warning, TEXT("Attempted to remove %s from %s but it was not found."), *GetActorRepListTypeDebugString(ActorInfo.Actor), *GetName());
+		return false;
+	}
+
+	ReplicationActorLists[BucketIndex].RemoveFast(ActorInfo.Actor);
+
+	// The last bucket is allowed to be partially filled, every other bucket is a hole to compact
+	if (BucketIndex != ReplicationActorLists.Num() - 1)
+	{
+		UnderfilledBuckets.Push(BucketIndex);
+	}
+
+	return true;
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyResetAllNetworkActors()
 {
 	ReplicationActorLists.Reset();
 	ForceNetUpdateReplicationActorList.Reset();
+	ActorToBucket.Reset();
+	UnderfilledBuckets.Reset();
+}
 
-	ReplicationActorLists.AddDefaulted();
-	FActorRepListRefView* CurrentList = &ReplicationActorLists[0];
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::AddToBucket(FActorRepListType Actor, int32 BucketIndex)
+{
+	ReplicationActorLists[BucketIndex].Add(Actor);
+	ActorToBucket.Add(Actor, BucketIndex);
+}
 
-	// We rebuild our lists of player states each frame. This is not as efficient as it could be but its the simplest way
-	// to handle players disconnecting and keeping the lists compact. If the lists were persistent we would need to defrag them as players left.
+int32 ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::CalculateBucketSize() const
+{
+	const int32 MinBucketSize = FMath::Max(TargetActorsPerFrame, 1);
 
-	for (TActorIterator<APlayerState> It(GetWorld()); It; ++It)
+	const UReplicationGraph* Graph = Cast<UReplicationGraph>(GetOuter());
+	if ((Graph == nullptr) || (Graph->NetDriver == nullptr) || (Graph->Connections.Num() == 0))
 	{
-		APlayerState* PS = *It;
-		if (IsActorValidForReplicationGather(PS) == false)
+		return MinBucketSize;
+	}
+
+	const float TickRate = FMath::Max(Graph->NetDriver->GetNetServerMaxTickRate(), 1.0f);
+
+	// Enough player states per frame to cycle through all of them in the target time
+	const float FramesPerCycle = FMath::Max(Lyra::RepGraph::PlayerStateTargetCycleTime * TickRate, 1.0f);
+	const int32 CycleBucketSize = FMath::CeilToInt32((float)ActorToBucket.Num() / FramesPerCycle);
+
+	// No more than the slowest connection can afford
+	int32 SlowestNetSpeed = MAX_int32;
+	for (const UNetReplicationGraphConnection* ConnectionManager : Graph->Connections)
+	{
+		if (const UNetConnection* Connection = ConnectionManager ? ConnectionManager->NetConnection.Get() : nullptr)
 		{
-			continue;
+			SlowestNetSpeed = FMath::Min(SlowestNetSpeed, Connection->CurrentNetSpeed);
+		}
+	}
+
+	int32 MaxBucketSize = MAX_int32;
+	if (SlowestNetSpeed != MAX_int32)
+	{
+		const float BytesPerFrame = (SlowestNetSpeed * Lyra::RepGraph::PlayerStateBandwidthPct) / TickRate;
+		MaxBucketSize = FMath::FloorToInt32(BytesPerFrame / FMath::Max(Lyra::RepGraph::PlayerStateEstimatedBytes, 1));
+	}
+
+	// Every connection gathers the same bucket, so the server cost of a bucket scales with the connection count
+	MaxBucketSize = FMath::Min(MaxBucketSize, Lyra::RepGraph::PlayerStateMaxSendsPerFrame / Graph->Connections.Num());
+
+	return FMath::Max(FMath::Min(CycleBucketSize, MaxBucketSize), MinBucketSize);
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::ResizeBuckets(int32 NewBucketSize)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	const int32 OldBucketSize = BucketSize;
+	BucketSize = NewBucketSize;
+
+	if (NewBucketSize > OldBucketSize)
+	{
+		// Every bucket but the last now has room, compaction tops them up from the last bucket over the next frames
+		for (int32 BucketIndex = 0; BucketIndex < ReplicationActorLists.Num() - 1; ++BucketIndex)
+		{
+			UnderfilledBuckets.Push(BucketIndex);
 		}
+	}
+	else
+	{
+		// Only the buckets over the new size are touched, their overflow moves to the end
+		const int32 NumBuckets = ReplicationActorLists.Num();
+		for (int32 BucketIndex = 0; BucketIndex < NumBuckets; ++BucketIndex)
+		{
+			while (ReplicationActorLists[BucketIndex].Num() > BucketSize)
+			{
+				if ((ReplicationActorLists.Num() - 1 == BucketIndex) || (ReplicationActorLists.Last().Num() >= BucketSize))
+				{
+					ReplicationActorLists.AddDefaulted_GetRef().Reset(BucketSize);
+				}
 
-		if (CurrentList->Num() >= TargetActorsPerFrame)
+				FActorRepListRefView& Bucket = ReplicationActorLists[BucketIndex];
+				const FActorRepListType Actor = Bucket[Bucket.Num() - 1];
+				Bucket.RemoveFast(Actor);
+				ReplicationActorLists.Last().Add(Actor);
+				ActorToBucket.FindChecked(Actor) = ReplicationActorLists.Num() - 1;
+			}
+		}
+	}
+
+	LastResizeTimeMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	++NumResizes;
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::CompactBuckets(int32 MaxMoves)
+{
+	int32 NumMoves = 0;
+	while ((NumMoves < MaxMoves) && (UnderfilledBuckets.Num() > 0))
+	{
+		// Drop empty trailing buckets first so we always move from a bucket that has actors
+		while ((ReplicationActorLists.Num() > 1) && (ReplicationActorLists.Last().Num() == 0))
 		{
-			ReplicationActorLists.AddDefaulted();
-			CurrentList = &ReplicationActorLists.Last(); 
+			ReplicationActorLists.Pop(EAllowShrinking::No);
 		}
-		
-		CurrentList->Add(PS);
-	}	
+
+		const int32 LastBucketIndex = ReplicationActorLists.Num() - 1;
+		const int32 BucketIndex = UnderfilledBuckets.Last();
+		if ((BucketIndex >= LastBucketIndex) || (ReplicationActorLists[BucketIndex].Num() >= BucketSize))
+		{
+			// Stale entry, the bucket was refilled or is now the last bucket
+			UnderfilledBuckets.Pop(EAllowShrinking::No);
+			continue;
+		}
+
+		FActorRepListRefView& LastBucket = ReplicationActorLists[LastBucketIndex];
+		const FActorRepListType Actor = LastBucket[LastBucket.Num() - 1];
+		LastBucket.RemoveFast(Actor);
+		ReplicationActorLists[BucketIndex].Add(Actor);
+		ActorToBucket.FindChecked(Actor) = BucketIndex;
+		++NumMoves;
+	}
+
+	while ((ReplicationActorLists.Num() > 1) && (ReplicationActorLists.Last().Num() == 0))
+	{
+		ReplicationActorLists.Pop(EAllowShrinking::No);
+	}
+
+	NumCompactionMoves += NumMoves;
+}
+
+void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULyraReplicationGraphNode_PlayerStateFrequencyLimiter_PrepareForReplication);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	ForceNetUpdateReplicationActorList.Reset();
+
+	// The buckets are persistent, only resize them when the ideal size changes (player count, connection count or bandwidth changed)
+	const int32 NewBucketSize = CalculateBucketSize();
+	if (NewBucketSize != BucketSize)
+	{
+		ResizeBuckets(NewBucketSize);
+	}
+
+	CompactBuckets(Lyra::RepGraph::PlayerStateCompactionMovesPerFrame);
+
+	if (ReplicationActorLists.Num() == 0)
+	{
+		ReplicationActorLists.AddDefaulted_GetRef().Reset(BucketSize);
+	}
+
+	LastPrepareTimeMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	PeakPrepareTimeMs = FMath::Max(PeakPrepareTimeMs, LastPrepareTimeMs);
 }
 
 void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
@@ -927,6 +1137,9 @@ void ULyraReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplication
 	DebugInfo.Log(NodeName);
 	DebugInfo.PushIndent();	
 
+	DebugInfo.Log(FString::Printf(TEXT("PlayerStates: %d BucketSize: %d Buckets: %d PendingHoles: %d"), ActorToBucket.Num(), BucketSize, ReplicationActorLists.Num(), UnderfilledBuckets.Num()));
+	DebugInfo.Log(FString::Printf(TEXT("Prepare: %.3fms (peak %.3fms) LastResize: %.3fms Resizes: %d CompactionMoves: %d"), LastPrepareTimeMs, PeakPrepareTimeMs, LastResizeTimeMs, NumResizes, NumCompactionMoves));
+
 	int32 i=0;
 	for (const FActorRepListRefView& List : ReplicationActorLists)
 	{
@@ -7,6 +7,7 @@
 #include "LyraReplicationGraph.generated.h"
 
 class AGameplayDebuggerCategoryReplicator;
+class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogLyraRepGraph, Display, All);
 
@@ -36,6 +37,9 @@ public:
 	UPROPERTY()
 	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
 
+	UPROPERTY()
+	TObjectPtr<ULyraReplicationGraphNode_PlayerStateFrequencyLimiter> PlayerStateNode;
+
 	TMap<FName, FActorRepListRefView> AlwaysRelevantStreamingLevelActors;
 
 #if WITH_GAMEPLAY_DEBUGGER
@@ -95,6 +99,11 @@ private:
 /** 
 	This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame. 
 	This is an optimization for large player connection counts, and not a requirement.
+
+	Player states are kept in persistent buckets that are updated as they are added and removed. Removals leave a hole in their bucket which is
+	filled a few actors per frame by moving actors out of the last bucket, so the buckets stay compact without a per frame rebuild.
+	The bucket size grows with the player state count so every player state is sent within Lyra.RepGraph.PlayerStates.TargetCycleTime,
+	but is capped by the per connection bandwidth budget and by the total number of sends per frame across all connections.
 */
 UCLASS()
 class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicationGraphNode
@@ -103,9 +112,10 @@ class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicatio
 
 	ULyraReplicationGraphNode_PlayerStateFrequencyLimiter();
 
-	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
-	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override { return false; }
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound=true) override;
 	virtual bool NotifyActorRenamed(const FRenamedReplicatedActorInfo& Actor, bool bWarnIfNotFound=true) override { return false; }
+	virtual void NotifyResetAllNetworkActors() override;
 
 	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
 
@@ -113,11 +123,37 @@ class ULyraReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicatio
 
 	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
 
-	/** How many actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
+	/** The minimum number of actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
 	int32 TargetActorsPerFrame = 2;
 
 private:
+
+	/** Returns the bucket size to use for the current player state count, connection count and bandwidth */
+	int32 CalculateBucketSize() const;
+
+	/** Changes the bucket size, only moving actors out of buckets that are over the new size */
+	void ResizeBuckets(int32 NewBucketSize);
+
+	/** Moves up to MaxMoves actors from the last bucket into buckets that have had actors removed */
+	void CompactBuckets(int32 MaxMoves);
+
+	void AddToBucket(FActorRepListType Actor, int32 BucketIndex);
 	
 	TArray<FActorRepListRefView> ReplicationActorLists;
 	FActorRepListRefView ForceNetUpdateReplicationActorList;
-};
\ No newline at end of file
+
+	/** Bucket index of every tracked player state */
+	TMap<FActorRepListType, int32> ActorToBucket;
+
+	/** Buckets that had actors removed and may have room, can contain duplicates and stale entries */
+	TArray<int32> UnderfilledBuckets;
+
+	int32 BucketSize = 0;
+
+	// Timings and counters reported by LogNode
+	double LastPrepareTimeMs = 0.0;
+	double PeakPrepareTimeMs = 0.0;
+	double LastResizeTimeMs = 0.0;
+	int32 NumResizes = 0;
+	int32 NumCompactionMoves = 0;
+};
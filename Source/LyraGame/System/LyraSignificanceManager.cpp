@@ -2,5 +2,278 @@
 
 #include "LyraSignificanceManager.h"
 
+#include "Character/LyraCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "Feedback/ContextEffects/LyraContextEffectComponent.h"
+#include "GameFramework/PlayerController.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(LyraSignificanceManager)
 
+namespace LyraSignificance
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(TEXT("Lyra.Significance.Enabled"), bEnabled, TEXT("When disabled every registered object is treated as Highest significance"), ECVF_Default);
+
+	static float HighestMaxDistance = 1500.0f;
+	static FAutoConsoleVariableRef CVarHighestMaxDistance(TEXT("Lyra.Significance.HighestMaxDistance"), HighestMaxDistance, TEXT("Max distance from a viewpoint for an object to be in the Highest significance bucket"), ECVF_Default);
+
+	static float HighMaxDistance = 3500.0f;
+	static FAutoConsoleVariableRef CVarHighMaxDistance(TEXT("Lyra.Significance.HighMaxDistance"), HighMaxDistance, TEXT("Max distance from a viewpoint for an object to be in the High significance bucket"), ECVF_Default);
+
+	static float MediumMaxDistance = 7000.0f;
+	static FAutoConsoleVariableRef CVarMediumMaxDistance(TEXT("Lyra.Significance.MediumMaxDistance"), MediumMaxDistance, TEXT("Max distance from a viewpoint for an object to be in the Medium significance bucket"), ECVF_Default);
+
+	static float LowMaxDistance = 12000.0f;
+	static FAutoConsoleVariableRef CVarLowMaxDistance(TEXT("Lyra.Significance.LowMaxDistance"), LowMaxDistance, TEXT("Max distance from a viewpoint for an object to be in the Low significance bucket, anything further is Lowest"), ECVF_Default);
+
+	static bool bDemoteBehindViewer = true;
+	static FAutoConsoleVariableRef CVarDemoteBehindViewer(TEXT("Lyra.Significance.DemoteBehindViewer"), bDemoteBehindViewer, TEXT("Should objects behind a viewpoint drop one significance bucket?"), ECVF_Default);
+
+	static float MediumTickInterval = 1.0f / 30.0f;
+	static FAutoConsoleVariableRef CVarMediumTickInterval(TEXT("Lyra.Significance.MediumTickInterval"), MediumTickInterval, TEXT("Mesh tick interval (animation update rate) for objects in the Medium bucket"), ECVF_Default);
+
+	static float LowTickInterval = 1.0f / 15.0f;
+	static FAutoConsoleVariableRef CVarLowTickInterval(TEXT("Lyra.Significance.LowTickInterval"), LowTickInterval, TEXT("Mesh tick interval (animation update rate) for objects in the Low bucket"), ECVF_Default);
+
+	static float LowestTickInterval = 1.0f / 5.0f;
+	static FAutoConsoleVariableRef CVarLowestTickInterval(TEXT("Lyra.Significance.LowestTickInterval"), LowestTickInterval, TEXT("Mesh tick interval (animation update rate) for objects in the Lowest bucket"), ECVF_Default);
+
+	static int32 CosmeticLODMinBucket = (int32)ELyraSignificanceBucket::Lowest;
+	static FAutoConsoleVariableRef CVarCosmeticLODMinBucket(TEXT("Lyra.Significance.CosmeticLODMinBucket"), CosmeticLODMinBucket, TEXT("Character part meshes in this bucket or lower are forced to their lowest LOD (0 = Highest ... 4 = Lowest, 5 = never)"), ECVF_Default);
+
+	static int32 ContextEffectsMaxBucket = (int32)ELyraSignificanceBucket::Low;
+	static FAutoConsoleVariableRef CVarContextEffectsMaxBucket(TEXT("Lyra.Significance.ContextEffects.MaxBucket"), ContextEffectsMaxBucket, TEXT("Least significant bucket that still spawns context effects (0 = Highest ... 4 = Lowest)"), ECVF_Default);
+
+	static int32 NumberPopsMaxBucket = (int32)ELyraSignificanceBucket::Low;
+	static FAutoConsoleVariableRef CVarNumberPopsMaxBucket(TEXT("Lyra.Significance.NumberPops.MaxBucket"), NumberPopsMaxBucket, TEXT("Least significant bucket that still displays number pops (0 = Highest ... 4 = Lowest)"), ECVF_Default);
+
+	static float GetTickInterval(ELyraSignificanceBucket Bucket)
+	{
+		switch (Bucket)
+		{
+		case ELyraSignificanceBucket::Medium:
+			return MediumTickInterval;
+		case ELyraSignificanceBucket::Low:
+			return LowTickInterval;
+		case ELyraSignificanceBucket::Lowest:
+			return LowestTickInterval;
+		default:
+			return 0.0f;
+		}
+	}
+}
+
+const FName ULyraSignificanceManager::PawnTag(TEXT("Lyra.Pawn"));
+const FName ULyraSignificanceManager::CharacterPartTag(TEXT("Lyra.CharacterPart"));
+const FName ULyraSignificanceManager::ContextEffectTag(TEXT("Lyra.ContextEffect"));
+
+void ULyraSignificanceManager::RegisterCharacter(ALyraCharacter* Character)
+{
+	RegisterObject(Character, PawnTag, &ThisClass::CalculateSignificance, EPostSignificanceType::Sequential,
+		[](FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+		{
+			if ((OldSignificance != Significance) || bFinal)
+			{
+				// Restore full rate when unregistering in case the character is reused
+				const ELyraSignificanceBucket Bucket = bFinal ? ELyraSignificanceBucket::Highest : SignificanceToBucket(Significance);
+				ApplyBucketToActorMeshes(CastChecked<AActor>(ObjectInfo->GetObject()), Bucket, /*bApplyCosmeticLOD=*/ false);
+			}
+		});
+}
+
+void ULyraSignificanceManager::RegisterCharacterPart(AActor* PartActor)
+{
+	RegisterObject(PartActor, CharacterPartTag, &ThisClass::CalculateSignificance, EPostSignificanceType::Sequential,
+		[](FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+		{
+			if ((OldSignificance != Significance) || bFinal)
+			{
+				const ELyraSignificanceBucket Bucket = bFinal ? ELyraSignificanceBucket::Highest : SignificanceToBucket(Significance);
+				ApplyBucketToActorMeshes(CastChecked<AActor>(ObjectInfo->GetObject()), Bucket, /*bApplyCosmeticLOD=*/ true);
+			}
+		});
+}
+
+void ULyraSignificanceManager::RegisterContextEffectComponent(ULyraContextEffectComponent* Component)
+{
+	RegisterObject(Component, ContextEffectTag, &ThisClass::CalculateSignificance, EPostSignificanceType::Sequential,
+		[](FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+		{
+			if ((OldSignificance != Significance) || bFinal)
+			{
+				const ELyraSignificanceBucket Bucket = bFinal ? ELyraSignificanceBucket::Highest : SignificanceToBucket(Significance);
+				const bool bAllowEffects = (int32)Bucket <= LyraSignificance::ContextEffectsMaxBucket;
+				CastChecked<ULyraContextEffectComponent>(ObjectInfo->GetObject())->SetEffectsSuppressedBySignificance(!bAllowEffects);
+			}
+		});
+}
+
+ELyraSignificanceBucket ULyraSignificanceManager::GetBucketForObject(const UObject* Object) const
+{
+	float Significance = 0.0f;
+	if (QuerySignificance(Object, /*out*/ Significance))
+	{
+		return SignificanceToBucket(Significance);
+	}
+
+	return ELyraSignificanceBucket::Highest;
+}
+
+ELyraSignificanceBucket ULyraSignificanceManager::GetBucketForLocation(const FVector& Location) const
+{
+	const TArray<FTransform>& CurrentViewpoints = GetViewpoints();
+	if (CurrentViewpoints.Num() == 0)
+	{
+		return ELyraSignificanceBucket::Highest;
+	}
+
+	ELyraSignificanceBucket BestBucket = ELyraSignificanceBucket::Lowest;
+	for (const FTransform& Viewpoint : CurrentViewpoints)
+	{
+		BestBucket = FMath::Min(BestBucket, CalculateBucket(Location, Viewpoint));
+	}
+	return BestBucket;
+}
+
+bool ULyraSignificanceManager::ShouldDisplayNumberPop(const FVector& Location) const
+{
+	return (int32)GetBucketForLocation(Location) <= LyraSignificance::NumberPopsMaxBucket;
+}
+
+void ULyraSignificanceManager::Tick(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULyraSignificanceManager_Tick);
+
+	TArray<FTransform, TInlineAllocator<4>> LocalViewpoints;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(/*out*/ ViewLocation, /*out*/ ViewRotation);
+			LocalViewpoints.Emplace(ViewRotation, ViewLocation);
+		}
+	}
+
+	Update(LocalViewpoints);
+}
+
+ETickableTickType ULyraSignificanceManager::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool ULyraSignificanceManager::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return (World != nullptr) && World->IsGameWorld() && (World->GetNetMode() != NM_DedicatedServer);
+}
+
+TStatId ULyraSignificanceManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraSignificanceManager, STATGROUP_Tickables);
+}
+
+UWorld* ULyraSignificanceManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+ELyraSignificanceBucket ULyraSignificanceManager::CalculateBucket(const FVector& Location, const FTransform& Viewpoint)
+{
+	if (!LyraSignificance::bEnabled)
+	{
+		return ELyraSignificanceBucket::Highest;
+	}
+
+	const FVector ToObject = Location - Viewpoint.GetLocation();
+	const double DistanceSquared = ToObject.SizeSquared();
+
+	int32 Bucket = (int32)ELyraSignificanceBucket::Lowest;
+	if (DistanceSquared <= FMath::Square(LyraSignificance::HighestMaxDistance))
+	{
+		Bucket = (int32)ELyraSignificanceBucket::Highest;
+	}
+	else if (DistanceSquared <= FMath::Square(LyraSignificance::HighMaxDistance))
+	{
+		Bucket = (int32)ELyraSignificanceBucket::High;
+	}
+	else if (DistanceSquared <= FMath::Square(LyraSignificance::MediumMaxDistance))
+	{
+		Bucket = (int32)ELyraSignificanceBucket::Medium;
+	}
+	else if (DistanceSquared <= FMath::Square(LyraSignificance::LowMaxDistance))
+	{
+		Bucket = (int32)ELyraSignificanceBucket::Low;
+	}
+
+	// Anything beyond the closest bucket that is behind the viewer can't be seen, but may be turned towards soon, so only drop one bucket
+	if (LyraSignificance::bDemoteBehindViewer && (Bucket > (int32)ELyraSignificanceBucket::Highest) && (Bucket < (int32)ELyraSignificanceBucket::Lowest))
+	{
+		if ((ToObject | Viewpoint.GetRotation().GetForwardVector()) < 0.0)
+		{
+			++Bucket;
+		}
+	}
+
+	return (ELyraSignificanceBucket)Bucket;
+}
+
+float ULyraSignificanceManager::BucketToSignificance(ELyraSignificanceBucket Bucket)
+{
+	// Higher significance is more significant, so invert the bucket order
+	return (float)((int32)ELyraSignificanceBucket::Lowest - (int32)Bucket);
+}
+
+ELyraSignificanceBucket ULyraSignificanceManager::SignificanceToBucket(float Significance)
+{
+	const int32 Bucket = (int32)ELyraSignificanceBucket::Lowest - FMath::RoundToInt32(Significance);
+	return (ELyraSignificanceBucket)FMath::Clamp(Bucket, (int32)ELyraSignificanceBucket::Highest, (int32)ELyraSignificanceBucket::Lowest);
+}
+
+float ULyraSignificanceManager::CalculateSignificance(FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+{
+	// This runs on worker threads, so stick to reading the location
+	const UObject* Object = ObjectInfo->GetObject();
+
+	const AActor* Actor = Cast<const AActor>(Object);
+	if (Actor == nullptr)
+	{
+		if (const UActorComponent* Component = Cast<const UActorComponent>(Object))
+		{
+			Actor = Component->GetOwner();
+		}
+	}
+
+	if (Actor == nullptr)
+	{
+		return BucketToSignificance(ELyraSignificanceBucket::Highest);
+	}
+
+	return BucketToSignificance(CalculateBucket(Actor->GetActorLocation(), Viewpoint));
+}
+
+void ULyraSignificanceManager::ApplyBucketToMesh(USkeletalMeshComponent* MeshComponent, ELyraSignificanceBucket Bucket, bool bApplyCosmeticLOD)
+{
+	// Skeletal meshes update their animation from their component tick, so the tick interval doubles as the animation update rate
+	MeshComponent->SetComponentTickInterval(LyraSignificance::GetTickInterval(Bucket));
+
+	if (bApplyCosmeticLOD)
+	{
+		// A forced LOD of 0 means automatic LOD selection, while N forces LOD N-1
+		const bool bForceLowestLOD = (int32)Bucket >= LyraSignificance::CosmeticLODMinBucket;
+		MeshComponent->SetForcedLOD(bForceLowestLOD ? MeshComponent->GetNumLODs() : 0);
+	}
+}
+
+void ULyraSignificanceManager::ApplyBucketToActorMeshes(AActor* Actor, ELyraSignificanceBucket Bucket, bool bApplyCosmeticLOD)
+{
+	TInlineComponentArray<USkeletalMeshComponent*> MeshComponents(Actor);
+	for (USkeletalMeshComponent* MeshComponent : MeshComponents)
+	{
+		ApplyBucketToMesh(MeshComponent, Bucket, bApplyCosmeticLOD);
+	}
+}
@@ -3,14 +3,91 @@
 #pragma once
 
 #include "SignificanceManager.h"
+#include "Tickable.h"
 
 #include "LyraSignificanceManager.generated.h"
 
+class AActor;
+class ALyraCharacter;
+class ULyraContextEffectComponent;
 class UObject;
+class USkeletalMeshComponent;
 
+/**
+ * Coarse significance buckets, ordered from most to least significant
+ * The distance thresholds between buckets are console tunable (Lyra.Significance.*)
+ */
+UENUM(BlueprintType)
+enum class ELyraSignificanceBucket : uint8
+{
+	Highest,
+	High,
+	Medium,
+	Low,
+	Lowest
+};
+
+/**
+ * ULyraSignificanceManager
+ *
+ * Buckets pawns, their cosmetic parts and their context effects by distance and direction from the local viewpoints,
+ * then scales their cost (tick interval, animation update rate, cosmetic LOD, effect spawning) from that bucket.
+ *
+ * Significance is evaluated from USignificanceManager::Update, which runs the significance functions in parallel,
+ * so they only read the registered object's location. The cost scaling runs sequentially on the game thread afterwards,
+ * and only when an object changes bucket.
+ */
 UCLASS()
-class ULyraSignificanceManager : public USignificanceManager
+class ULyraSignificanceManager : public USignificanceManager, public FTickableGameObject
 {
 	GENERATED_BODY()
 
+public:
+
+	// Significance manager tags for each kind of object we register
+	static const FName PawnTag;
+	static const FName CharacterPartTag;
+	static const FName ContextEffectTag;
+
+	// Registers a character, scaling the animation update rate of its meshes by significance
+	void RegisterCharacter(ALyraCharacter* Character);
+
+	// Registers a cosmetic actor spawned for a character part, scaling its animation update rate and LOD by significance
+	void RegisterCharacterPart(AActor* PartActor);
+
+	// Registers a context effect component, which stops spawning effects for its owner once it drops below Lyra.Significance.ContextEffects.MaxBucket
+	void RegisterContextEffectComponent(ULyraContextEffectComponent* Component);
+
+	// Returns the bucket a registered object is currently in (Highest if the object is not registered)
+	ELyraSignificanceBucket GetBucketForObject(const UObject* Object) const;
+
+	// Returns the bucket an arbitrary world location would fall in for the viewpoints of the last update
+	ELyraSignificanceBucket GetBucketForLocation(const FVector& Location) const;
+
+	// Returns true if number pops at the specified location are significant enough to be displayed
+	bool ShouldDisplayNumberPop(const FVector& Location) const;
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	//~End of FTickableGameObject interface
+
+private:
+	// Maps a location to a bucket for a single viewpoint, safe to call from worker threads
+	static ELyraSignificanceBucket CalculateBucket(const FVector& Location, const FTransform& Viewpoint);
+
+	static float BucketToSignificance(ELyraSignificanceBucket Bucket);
+	static ELyraSignificanceBucket SignificanceToBucket(float Significance);
+
+	// Applies the tick interval and LOD for a bucket to a skeletal mesh
+	static void ApplyBucketToMesh(USkeletalMeshComponent* MeshComponent, ELyraSignificanceBucket Bucket, bool bApplyCosmeticLOD);
+
+	// Applies a bucket to every skeletal mesh on an actor
+	static void ApplyBucketToActorMeshes(AActor* Actor, ELyraSignificanceBucket Bucket, bool bApplyCosmeticLOD);
+
+	// Significance function shared by every registered object, uses the location of the object or its owning actor
+	static float CalculateSignificance(FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint);
 };
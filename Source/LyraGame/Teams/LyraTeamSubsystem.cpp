@@ -3,6 +3,8 @@
 #include "Teams/LyraTeamSubsystem.h"
 
 #include "AbilitySystemGlobals.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
 #include "LyraLogChannels.h"
@@ -17,6 +19,12 @@
 
 class FSubsystemCollectionBase;
 
+namespace LyraTeamSubsystem
+{
+	// Smallest number of cached teams before destroyed objects are pruned from the cache
+	static constexpr int32 MinTeamCachePruneThreshold = 256;
+}
+
 //////////////////////////////////////////////////////////////////////
 // FLyraTeamTrackingInfo
 
@@ -85,9 +93,52 @@ void ULyraTeamSubsystem::Deinitialize()
 {
 	UCheatManager::UnregisterFromOnCheatManagerCreated(CheatManagerRegistrationHandle);
 
+	if (UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+	{
+		GameInstance->OnPawnControllerChangedDelegates.RemoveDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+
+	InvalidateTeamCache();
+
 	Super::Deinitialize();
 }
 
+void ULyraTeamSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Pawns without a team of their own take it from their player state, which changes with possession
+	if (UGameInstance* GameInstance = InWorld.GetGameInstance())
+	{
+		GameInstance->OnPawnControllerChangedDelegates.AddUniqueDynamic(this, &ThisClass::HandlePawnControllerChanged);
+	}
+}
+
+void ULyraTeamSubsystem::HandlePawnControllerChanged(APawn* Pawn, AController* Controller)
+{
+	InvalidateTeamCache();
+}
+
+void ULyraTeamSubsystem::InvalidateTeamCache()
+{
+	CachedTeamIds.Reset();
+	TeamCachePruneThreshold = LyraTeamSubsystem::MinTeamCachePruneThreshold;
+}
+
+void ULyraTeamSubsystem::PruneTeamCache() const
+{
+	for (auto It = CachedTeamIds.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	CachedTeamIds.Compact();
+	TeamCachePruneThreshold = FMath::Max(LyraTeamSubsystem::MinTeamCachePruneThreshold, CachedTeamIds.Num() * 2);
+}
+
 bool ULyraTeamSubsystem::RegisterTeamInfo(ALyraTeamInfoBase* TeamInfo)
 {
 	if (!ensure(TeamInfo))
@@ -151,6 +202,44 @@ bool ULyraTeamSubsystem::ChangeTeamForActor(AActor* ActorToChange, int32 NewTeam
 }
 
 int32 ULyraTeamSubsystem::FindTeamFromObject(const UObject* TestObject) const
+{
+	if ((TestObject == nullptr) || !IsInGameThread())
+	{
+		return FindTeamFromObjectUncached(TestObject);
+	}
+
+	if (const int32* CachedTeamId = CachedTeamIds.Find(TestObject))
+	{
+		return *CachedTeamId;
+	}
+
+	const int32 TeamId = FindTeamFromObjectUncached(TestObject);
+
+	// Objects without a team are not cached, their player state or instigator may not have replicated yet
+	if (TeamId != INDEX_NONE)
+	{
+		if (CachedTeamIds.Num() >= TeamCachePruneThreshold)
+		{
+			PruneTeamCache();
+		}
+
+		CachedTeamIds.Add(TestObject, TeamId);
+	}
+
+	return TeamId;
+}
+
+void ULyraTeamSubsystem::FindTeamsFromObjects(TConstArrayView<const UObject*> TestObjects, TArrayView<int32> OutTeamIds) const
+{
+	check(TestObjects.Num() == OutTeamIds.Num());
+
+	for (int32 Index = 0; Index < TestObjects.Num(); ++Index)
+	{
+		OutTeamIds[Index] = FindTeamFromObject(TestObjects[Index]);
+	}
+}
+
+int32 ULyraTeamSubsystem::FindTeamFromObjectUncached(const UObject* TestObject) const
 {
 	// See if it's directly a team agent
 	if (const ILyraTeamAgentInterface* ObjectWithTeamInterface = Cast<ILyraTeamAgentInterface>(TestObject))
@@ -241,6 +330,34 @@ ELyraTeamComparison ULyraTeamSubsystem::CompareTeams(const UObject* A, const UOb
 	return CompareTeams(A, B, /*out*/ TeamIdA, /*out*/ TeamIdB);
 }
 
+void ULyraTeamSubsystem::CompareTeams(const UObject* A, TConstArrayView<const UObject*> Others, TArrayView<ELyraTeamComparison> OutResults) const
+{
+	check(Others.Num() == OutResults.Num());
+
+	const int32 TeamIdA = FindTeamFromObject(Cast<const AActor>(A));
+	if (TeamIdA == INDEX_NONE)
+	{
+		for (ELyraTeamComparison& Result : OutResults)
+		{
+			Result = ELyraTeamComparison::InvalidArgument;
+		}
+		return;
+	}
+
+	for (int32 Index = 0; Index < Others.Num(); ++Index)
+	{
+		const int32 TeamIdB = FindTeamFromObject(Cast<const AActor>(Others[Index]));
+		if (TeamIdB == INDEX_NONE)
+		{
+			OutResults[Index] = ELyraTeamComparison::InvalidArgument;
+		}
+		else
+		{
+			OutResults[Index] = (TeamIdA == TeamIdB) ? ELyraTeamComparison::OnSameTeam : ELyraTeamComparison::DifferentTeams;
+		}
+	}
+}
+
 void ULyraTeamSubsystem::FindTeamFromActor(const UObject* TestObject, bool& bIsPartOfTeam, int32& TeamId) const
 {
 	TeamId = FindTeamFromObject(TestObject);
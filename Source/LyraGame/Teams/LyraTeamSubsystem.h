@@ -3,13 +3,16 @@
 #pragma once
 
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 #include "LyraTeamSubsystem.generated.h"
 
 #define UE_API LYRAGAME_API
 
 class AActor;
+class AController;
 class ALyraPlayerState;
+class APawn;
 class ALyraTeamInfoBase;
 class ALyraTeamPrivateInfo;
 class ALyraTeamPublicInfo;
@@ -71,6 +74,10 @@ public:
 	UE_API virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
+	//~UWorldSubsystem interface
+	UE_API virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~End of UWorldSubsystem interface
+
 	// Tries to registers a new team
 	UE_API bool RegisterTeamInfo(ALyraTeamInfoBase* TeamInfo);
 
@@ -98,9 +105,18 @@ public:
 	// Compare the teams of two actors and returns a value indicating if they are on same teams, different teams, or one/both are invalid
 	UE_API ELyraTeamComparison CompareTeams(const UObject* A, const UObject* B) const;
 
+	// Returns the team of each object (INDEX_NONE for objects that are not part of a team), OutTeamIds must be the same size as TestObjects
+	UE_API void FindTeamsFromObjects(TConstArrayView<const UObject*> TestObjects, TArrayView<int32> OutTeamIds) const;
+
+	// Compares the team of one actor against each of the others, OutResults must be the same size as Others
+	UE_API void CompareTeams(const UObject* A, TConstArrayView<const UObject*> Others, TArrayView<ELyraTeamComparison> OutResults) const;
+
 	// Returns true if the instigator can damage the target, taking into account the friendly fire settings
 	UE_API bool CanCauseDamage(const UObject* Instigator, const UObject* Target, bool bAllowDamageToSelf = true) const;
 
+	// Forgets every cached team assignment, called whenever a team agent changes team or a pawn changes controller
+	UE_API void InvalidateTeamCache();
+
 	// Adds a specified number of stacks to the tag (does nothing if StackCount is below 1)
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Teams)
 	UE_API void AddTeamTagStack(int32 TeamId, FGameplayTag Tag, int32 StackCount);
@@ -141,11 +157,29 @@ public:
 	// Register for a team display asset notification for the specified team ID
 	UE_API FOnLyraTeamDisplayAssetChangedDelegate& GetTeamDisplayAssetChangedDelegate(int32 TeamId);
 
+private:
+	// Resolves the team of an object without going through the cache
+	int32 FindTeamFromObjectUncached(const UObject* TestObject) const;
+
+	// Drops cached teams of objects that have been destroyed (projectiles, dead pawns)
+	void PruneTeamCache() const;
+
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* Controller);
+
 private:
 	UPROPERTY()
 	TMap<int32, FLyraTeamTrackingInfo> TeamMap;
 
 	FDelegateHandle CheatManagerRegistrationHandle;
+
+	// Resolved team of each object that had one
+	// Resolving a team walks interface casts, instigators and player states, so repeated lookups are served from here
+	// Keys are weak so destroyed objects can be told apart and pruned
+	mutable TMap<TWeakObjectPtr<const UObject>, int32> CachedTeamIds;
+
+	// The cache is pruned once it holds this many entries, then the threshold is doubled from what survived
+	mutable int32 TeamCachePruneThreshold = 0;
 };
 
 #undef UE_API
@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "AbilitySystem/LyraAbilityTagRelationshipMapping.h"
+#include "Math/RandomStream.h"
+#include "NativeGameplayTags.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+namespace LyraAbilityTagRelationshipMappingTest
+{
+	// A small tag hierarchy so relationships authored on parent tags get exercised
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action, "Lyra.Test.TagRelationship.Action");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action_Move, "Lyra.Test.TagRelationship.Action.Move");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action_Move_Sprint, "Lyra.Test.TagRelationship.Action.Move.Sprint");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action_Move_Crouch, "Lyra.Test.TagRelationship.Action.Move.Crouch");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action_Weapon, "Lyra.Test.TagRelationship.Action.Weapon");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action_Weapon_Fire, "Lyra.Test.TagRelationship.Action.Weapon.Fire");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action_Weapon_Fire_Auto, "Lyra.Test.TagRelationship.Action.Weapon.Fire.Auto");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action_Weapon_Reload, "Lyra.Test.TagRelationship.Action.Weapon.Reload");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Action_Emote, "Lyra.Test.TagRelationship.Action.Emote");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Status_Dead, "Lyra.Test.TagRelationship.Status.Dead");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Status_Stunned, "Lyra.Test.TagRelationship.Status.Stunned");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Status_Aiming, "Lyra.Test.TagRelationship.Status.Aiming");
+
+	static constexpr int32 NumMappings = 200;
+	static constexpr int32 NumQueriesPerMapping = 50;
+
+	TArray<FGameplayTag> GetAllTags()
+	{
+		return {
+			TAG_Action, TAG_Action_Move, TAG_Action_Move_Sprint, TAG_Action_Move_Crouch,
+			TAG_Action_Weapon, TAG_Action_Weapon_Fire, TAG_Action_Weapon_Fire_Auto, TAG_Action_Weapon_Reload,
+			TAG_Action_Emote, TAG_Status_Dead, TAG_Status_Stunned, TAG_Status_Aiming
+		};
+	}
+
+	FGameplayTagContainer MakeRandomContainer(FRandomStream& Random, const TArray<FGameplayTag>& AllTags, int32 MaxTags)
+	{
+		FGameplayTagContainer Container;
+		const int32 NumTags = Random.RandRange(0, MaxTags);
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			Container.AddTag(AllTags[Random.RandRange(0, AllTags.Num() - 1)]);
+		}
+		return Container;
+	}
+
+	// Creates a mapping with the relationships, set the way the editor does since they are only exposed as a property
+	ULyraAbilityTagRelationshipMapping* MakeMapping(const TArray<FLyraAbilityTagRelationship>& Relationships)
+	{
+		ULyraAbilityTagRelationshipMapping* Mapping = NewObject<ULyraAbilityTagRelationshipMapping>(GetTransientPackage());
+
+		const FArrayProperty* RelationshipsProperty = FindFProperty<FArrayProperty>(ULyraAbilityTagRelationshipMapping::StaticClass(), TEXT("AbilityTagRelationships"));
+		check(RelationshipsProperty);
+		*RelationshipsProperty->ContainerPtrToValuePtr<TArray<FLyraAbilityTagRelationship>>(Mapping) = Relationships;
+
+		return Mapping;
+	}
+
+	// The original implementation, which walks every relationship for every query, kept as the reference
+	struct FReferenceMapping
+	{
+		const TArray<FLyraAbilityTagRelationship>& AbilityTagRelationships;
+
+		void GetAbilityTagsToBlockAndCancel(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer& OutTagsToBlock, FGameplayTagContainer& OutTagsToCancel) const
+		{
+			for (const FLyraAbilityTagRelationship& Tags : AbilityTagRelationships)
+			{
+				if (AbilityTags.HasTag(Tags.AbilityTag))
+				{
+					OutTagsToBlock.AppendTags(Tags.AbilityTagsToBlock);
+					OutTagsToCancel.AppendTags(Tags.AbilityTagsToCancel);
+				}
+			}
+		}
+
+		void GetRequiredAndBlockedActivationTags(const FGameplayTagContainer& AbilityTags, FGameplayTagContainer& OutActivationRequired, FGameplayTagContainer& OutActivationBlocked) const
+		{
+			for (const FLyraAbilityTagRelationship& Tags : AbilityTagRelationships)
+			{
+				if (AbilityTags.HasTag(Tags.AbilityTag))
+				{
+					OutActivationRequired.AppendTags(Tags.ActivationRequiredTags);
+					OutActivationBlocked.AppendTags(Tags.ActivationBlockedTags);
+				}
+			}
+		}
+
+		bool IsAbilityCancelledByTag(const FGameplayTagContainer& AbilityTags, const FGameplayTag& ActionTag) const
+		{
+			for (const FLyraAbilityTagRelationship& Tags : AbilityTagRelationships)
+			{
+				if (Tags.AbilityTag == ActionTag && Tags.AbilityTagsToCancel.HasAny(AbilityTags))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	// The compiled tables may append tags in a different order, so compare the containers as sets
+	bool AreContainersEquivalent(const FGameplayTagContainer& A, const FGameplayTagContainer& B)
+	{
+		return A.HasAllExact(B) && B.HasAllExact(A);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraAbilityTagRelationshipMappingEquivalenceTest, "Lyra.AbilitySystem.TagRelationshipMapping.CompiledMatchesReference", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FLyraAbilityTagRelationshipMappingEquivalenceTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraAbilityTagRelationshipMappingTest;
+
+	const TArray<FGameplayTag> AllTags = GetAllTags();
+	FRandomStream Random(0x1A7A);
+
+	for (int32 MappingIndex = 0; MappingIndex < NumMappings; ++MappingIndex)
+	{
+		// Random relationships, including several authored for the same tag and some for parent tags
+		TArray<FLyraAbilityTagRelationship> Relationships;
+		const int32 NumRelationships = Random.RandRange(0, 16);
+		for (int32 RelationshipIndex = 0; RelationshipIndex < NumRelationships; ++RelationshipIndex)
+		{
+			FLyraAbilityTagRelationship& Relationship = Relationships.AddDefaulted_GetRef();
+			Relationship.AbilityTag = AllTags[Random.RandRange(0, AllTags.Num() - 1)];
+			Relationship.AbilityTagsToBlock = MakeRandomContainer(Random, AllTags, 3);
+			Relationship.AbilityTagsToCancel = MakeRandomContainer(Random, AllTags, 3);
+			Relationship.ActivationRequiredTags = MakeRandomContainer(Random, AllTags, 2);
+			Relationship.ActivationBlockedTags = MakeRandomContainer(Random, AllTags, 2);
+		}
+
+		ULyraAbilityTagRelationshipMapping* Mapping = MakeMapping(Relationships);
+		const FReferenceMapping Reference{ Relationships };
+
+		for (int32 QueryIndex = 0; QueryIndex < NumQueriesPerMapping; ++QueryIndex)
+		{
+			const FGameplayTagContainer AbilityTags = MakeRandomContainer(Random, AllTags, 4);
+			const FGameplayTag ActionTag = AllTags[Random.RandRange(0, AllTags.Num() - 1)];
+			const FString Context = FString::Printf(TEXT("mapping %d, ability tags %s"), MappingIndex, *AbilityTags.ToStringSimple());
+
+			FGameplayTagContainer ExpectedBlock, ExpectedCancel, ExpectedRequired, ExpectedBlocked;
+			Reference.GetAbilityTagsToBlockAndCancel(AbilityTags, ExpectedBlock, ExpectedCancel);
+			Reference.GetRequiredAndBlockedActivationTags(AbilityTags, ExpectedRequired, ExpectedBlocked);
+
+			FGameplayTagContainer ActualBlock, ActualCancel, ActualRequired, ActualBlocked;
+			Mapping->GetAbilityTagsToBlockAndCancel(AbilityTags, &ActualBlock, &ActualCancel);
+			Mapping->GetRequiredAndBlockedActivationTags(AbilityTags, &ActualRequired, &ActualBlocked);
+
+			TestTrue(FString::Printf(TEXT("Tags to block (%s)"), *Context), AreContainersEquivalent(ActualBlock, ExpectedBlock));
+			TestTrue(FString::Printf(TEXT("Tags to cancel (%s)"), *Context), AreContainersEquivalent(ActualCancel, ExpectedCancel));
+			TestTrue(FString::Printf(TEXT("Activation required tags (%s)"), *Context), AreContainersEquivalent(ActualRequired, ExpectedRequired));
+			TestTrue(FString::Printf(TEXT("Activation blocked tags (%s)"), *Context), AreContainersEquivalent(ActualBlocked, ExpectedBlocked));
+			TestEqual(FString::Printf(TEXT("Cancelled by %s (%s)"), *ActionTag.ToString(), *Context), Mapping->IsAbilityCancelledByTag(AbilityTags, ActionTag), Reference.IsAbilityCancelledByTag(AbilityTags, ActionTag));
+
+			// Only passing one of the outputs must not change the other
+			FGameplayTagContainer BlockOnly;
+			Mapping->GetAbilityTagsToBlockAndCancel(AbilityTags, &BlockOnly, nullptr);
+			TestTrue(FString::Printf(TEXT("Tags to block without cancel output (%s)"), *Context), AreContainersEquivalent(BlockOnly, ExpectedBlock));
+		}
+
+		Mapping->MarkAsGarbage();
+	}
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
@@ -0,0 +1,174 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "AudioDevice.h"
+#include "Components/AudioComponent.h"
+#include "Feedback/ContextEffects/LyraContextEffectComponent.h"
+#include "Feedback/ContextEffects/LyraContextEffectsLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraTestWorld.h"
+#include "NativeGameplayTags.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Sound/SoundWave.h"
+#include "UObject/Package.h"
+
+namespace LyraContextEffectComponentTest
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Footstep, "AnimEffect.Footstep.Walk");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Concrete, "SurfaceType.Concrete");
+
+	// A few seconds of running, with footsteps landing every couple of frames
+	static constexpr int32 NumFootsteps = 256;
+	static constexpr int32 FramesPerFootstep = 2;
+
+	// The footstep sound is silent and ends right away, so it never needs more components than the actor's audio pool
+	ULyraContextEffectsLibrary* MakeFootstepLibrary(USoundBase*& OutSound, UNiagaraSystem*& OutSystem)
+	{
+		ULyraContextEffectsLibrary* Library = NewObject<ULyraContextEffectsLibrary>(GetTransientPackage(), TEXT("LyraContextEffectComponentTest_Library"));
+		OutSound = NewObject<USoundWave>(Library, TEXT("Sound"));
+		OutSystem = NewObject<UNiagaraSystem>(Library, TEXT("System"));
+
+		FLyraContextEffects& Footstep = Library->ContextEffects.AddDefaulted_GetRef();
+		Footstep.EffectTag = TAG_Footstep;
+		Footstep.Context.AddTag(TAG_Concrete);
+		Footstep.Effects.Add(FSoftObjectPath(OutSound));
+		Footstep.Effects.Add(FSoftObjectPath(OutSystem));
+
+		return Library;
+	}
+
+	static int32 GetMaxPooledAudioComponents()
+	{
+		const IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.ContextEffects.MaxPooledAudioComponents"));
+		return (CVar != nullptr) ? CVar->GetInt() : 0;
+	}
+
+	// Counts the effect components currently playing while attached to the actor, and the audio components kept for reuse
+	void CountEffectComponents(const USceneComponent* Root, int32& OutNumPlayingAudio, int32& OutNumPlayingNiagara, int32& OutNumPooledAudio)
+	{
+		OutNumPlayingAudio = 0;
+		OutNumPlayingNiagara = 0;
+		OutNumPooledAudio = 0;
+		for (const USceneComponent* Child : Root->GetAttachChildren())
+		{
+			if (const UAudioComponent* AudioComponent = Cast<UAudioComponent>(Child))
+			{
+				OutNumPlayingAudio += (AudioComponent->IsActive() && AudioComponent->IsPlaying()) ? 1 : 0;
+
+				// Components spawned past the pool are destroyed once their sound finishes
+				OutNumPooledAudio += AudioComponent->bAutoDestroy ? 0 : 1;
+			}
+			else if (const UNiagaraComponent* NiagaraComponent = Cast<UNiagaraComponent>(Child))
+			{
+				OutNumPlayingNiagara += NiagaraComponent->IsActive() ? 1 : 0;
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraContextEffectComponentTest, "Lyra.ContextEffects.Component.ActiveComponentsStayBounded", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FLyraContextEffectComponentTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraContextEffectComponentTest;
+
+	// The component hands its libraries to the context effects world subsystem
+	UWorld* World = LyraTestWorld::CreateGameInstanceWorld(TEXT("LyraContextEffectComponentTest"));
+
+	USoundBase* FootstepSound = nullptr;
+	UNiagaraSystem* FootstepSystem = nullptr;
+	ULyraContextEffectsLibrary* Library = MakeFootstepLibrary(FootstepSound, FootstepSystem);
+	Library->AddToRoot();
+
+	AActor* Owner = World->SpawnActor<AActor>();
+	USceneComponent* Root = NewObject<USceneComponent>(Owner);
+	Owner->SetRootComponent(Root);
+	Root->RegisterComponent();
+
+	// Registering after the owner began play runs BeginPlay, which hands the libraries to the subsystem
+	ULyraContextEffectComponent* EffectComponent = NewObject<ULyraContextEffectComponent>(Owner);
+	EffectComponent->DefaultContextEffectsLibraries.Add(TSoftObjectPtr<ULyraContextEffectsLibrary>(Library));
+	EffectComponent->RegisterComponent();
+
+	// The library effects are already in memory, give the streamable manager a few frames to report them loaded
+	for (int32 FrameIndex = 0; FrameIndex < 10 && Library->GetContextEffectsLibraryLoadState() != EContextEffectsLibraryLoadState::Loaded; ++FrameIndex)
+	{
+		World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+	}
+	TestTrue(TEXT("Library loaded"), Library->GetContextEffectsLibraryLoadState() == EContextEffectsLibraryLoadState::Loaded);
+
+	FGameplayTagContainer Contexts;
+	Contexts.AddTag(TAG_Concrete);
+
+	const FVector FootstepOffset(0.0, 0.0, -90.0);
+	const int32 MaxPooledAudioComponents = GetMaxPooledAudioComponents();
+
+	// Sounds only get a component when there is an audio device to play them on (e.g., not with -nosound)
+	const bool bCanPlaySounds = World->GetAudioDevice().IsValid();
+	if (!bCanPlaySounds)
+	{
+		AddWarning(TEXT("No audio device, only the Niagara effects are checked"));
+	}
+
+	int32 MaxAudioComponents = 0;
+	int32 MaxPooledAudio = 0;
+	for (int32 FootstepIndex = 0; FootstepIndex < NumFootsteps; ++FootstepIndex)
+	{
+		EffectComponent->AnimMotionEffect_Implementation(NAME_None, TAG_Footstep, Root, FootstepOffset, FRotator::ZeroRotator, nullptr, false, FHitResult(), Contexts);
+
+		// The library's sound and system are played on the footstep's component at its offset
+		const bool bPlayedSound = EffectComponent->GetActiveAudioComponents().ContainsByPredicate([Root, FootstepSound, &FootstepOffset](const UAudioComponent* AudioComponent)
+			{
+				return (AudioComponent->Sound == FootstepSound) && (AudioComponent->GetAttachParent() == Root) && AudioComponent->GetRelativeLocation().Equals(FootstepOffset);
+			});
+		const bool bSpawnedSystem = EffectComponent->GetActiveNiagaraComponents().ContainsByPredicate([Root, FootstepSystem, &FootstepOffset](const UNiagaraComponent* NiagaraComponent)
+			{
+				return (NiagaraComponent->GetAsset() == FootstepSystem) && (NiagaraComponent->GetAttachParent() == Root) && NiagaraComponent->GetRelativeLocation().Equals(FootstepOffset);
+			});
+		if ((bCanPlaySounds && !bPlayedSound) || !bSpawnedSystem)
+		{
+			AddError(FString::Printf(TEXT("Footstep %d: sound played %d, system spawned %d"), FootstepIndex, bPlayedSound, bSpawnedSystem));
+			break;
+		}
+
+		MaxAudioComponents = FMath::Max(MaxAudioComponents, EffectComponent->GetActiveAudioComponents().Num());
+
+		// Only the components played for this footstep can be held on top of the ones that were still playing before it
+		int32 NumPlayingAudio = 0;
+		int32 NumPlayingNiagara = 0;
+		int32 NumPooledAudio = 0;
+		CountEffectComponents(Root, NumPlayingAudio, NumPlayingNiagara, NumPooledAudio);
+		MaxPooledAudio = FMath::Max(MaxPooledAudio, NumPooledAudio);
+		if ((EffectComponent->GetActiveAudioComponents().Num() > NumPlayingAudio + 1) || (EffectComponent->GetActiveNiagaraComponents().Num() > NumPlayingNiagara + 1))
+		{
+			AddError(FString::Printf(TEXT("Footstep %d: holding %d audio and %d Niagara components while %d and %d are playing"), FootstepIndex,
+				EffectComponent->GetActiveAudioComponents().Num(), EffectComponent->GetActiveNiagaraComponents().Num(), NumPlayingAudio, NumPlayingNiagara));
+			break;
+		}
+
+		for (int32 FrameIndex = 0; FrameIndex < FramesPerFootstep; ++FrameIndex)
+		{
+			World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+		}
+	}
+
+	TestTrue(FString::Printf(TEXT("Audio components kept for reuse (at most %d, pool size %d)"), MaxPooledAudio, MaxPooledAudioComponents), ((MaxPooledAudio > 0) || !bCanPlaySounds) && (MaxPooledAudio <= MaxPooledAudioComponents));
+	TestTrue(FString::Printf(TEXT("Audio components held (at most %d, pool size %d)"), MaxAudioComponents, MaxPooledAudioComponents), MaxAudioComponents <= MaxPooledAudioComponents);
+
+	Owner->Destroy();
+	TestEqual(TEXT("Audio components held after EndPlay"), EffectComponent->GetActiveAudioComponents().Num(), 0);
+	TestEqual(TEXT("Niagara components held after EndPlay"), EffectComponent->GetActiveNiagaraComponents().Num(), 0);
+
+	Library->RemoveFromRoot();
+	Library->MarkAsGarbage();
+
+	LyraTestWorld::DestroyGameInstanceWorld(World);
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
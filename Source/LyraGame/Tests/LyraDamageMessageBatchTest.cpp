@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "AbilitySystem/Attributes/LyraHealthSet.h"
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "GameFramework/GameplayMessageSubsystem.h"
+#include "GameplayEffect.h"
+#include "LyraTestWorld.h"
+#include "Messages/LyraVerbMessage.h"
+#include "UObject/Package.h"
+
+namespace LyraDamageMessageBatchTest
+{
+	// A shotgun blast: every pellet lands in the same frame
+	static constexpr int32 NumPellets = 8;
+	static constexpr float DamagePerPellet = 5.0f;
+
+	UGameplayEffect* MakeDamageEffect()
+	{
+		UGameplayEffect* DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), TEXT("GE_LyraDamageMessageBatchTest"));
+		DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+		FGameplayModifierInfo& Modifier = DamageEffect->Modifiers.AddDefaulted_GetRef();
+		Modifier.Attribute = ULyraHealthSet::GetDamageAttribute();
+		Modifier.ModifierOp = EGameplayModOp::Additive;
+		Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(DamagePerPellet));
+
+		return DamageEffect;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraDamageMessageBatchTest, "Lyra.Messages.DamageMessage.SameFrameHitsBatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FLyraDamageMessageBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraDamageMessageBatchTest;
+
+	// The message router lives on the game instance, so the world needs one
+	UWorld* World = LyraTestWorld::CreateGameInstanceWorld(TEXT("LyraDamageMessageBatchTest"));
+
+	AActor* Target = World->SpawnActor<AActor>();
+	ULyraAbilitySystemComponent* AbilitySystemComponent = NewObject<ULyraAbilitySystemComponent>(Target);
+	AbilitySystemComponent->RegisterComponent();
+	AbilitySystemComponent->InitAbilityActorInfo(Target, Target);
+	AbilitySystemComponent->AddSpawnedAttribute(NewObject<ULyraHealthSet>(Target));
+
+	TArray<int32> BatchSizes;
+	int32 NumMismatchedPayloads = 0;
+	int32 NumImmediateMessages = 0;
+
+	UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(World);
+
+	// Regular listeners have not opted into batching, so they keep receiving each hit as it is applied
+	FGameplayMessageListenerHandle ImmediateListenerHandle = MessageSubsystem.RegisterListener<FLyraVerbMessage>(TAG_Lyra_Damage_Message,
+		[&NumImmediateMessages](FGameplayTag Channel, const FLyraVerbMessage& Payload)
+		{
+			++NumImmediateMessages;
+		});
+
+	FGameplayMessageListenerHandle ListenerHandle = MessageSubsystem.RegisterBatchListener<FLyraVerbMessage>(TAG_Lyra_Damage_Message,
+		[&BatchSizes, &NumMismatchedPayloads, Target](FGameplayTag Channel, TConstArrayView<FLyraVerbMessage> Payloads)
+		{
+			BatchSizes.Add(Payloads.Num());
+			for (const FLyraVerbMessage& Payload : Payloads)
+			{
+				if ((Payload.Target != Target) || !FMath::IsNearlyEqual(Payload.Magnitude, DamagePerPellet))
+				{
+					++NumMismatchedPayloads;
+				}
+			}
+		});
+
+	UGameplayEffect* DamageEffect = MakeDamageEffect();
+
+	for (int32 FrameIndex = 0; FrameIndex < 2; ++FrameIndex)
+	{
+		for (int32 PelletIndex = 0; PelletIndex < NumPellets; ++PelletIndex)
+		{
+			AbilitySystemComponent->ApplyGameplayEffectToSelf(DamageEffect, 1.0f, AbilitySystemComponent->MakeEffectContext());
+		}
+
+		TestEqual(FString::Printf(TEXT("Messages received immediately by frame %d"), FrameIndex), NumImmediateMessages, (FrameIndex + 1) * NumPellets);
+		TestEqual(FString::Printf(TEXT("Batches delivered before the end of frame %d"), FrameIndex), BatchSizes.Num(), FrameIndex);
+
+		World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+
+		if (TestEqual(FString::Printf(TEXT("Batches delivered by the end of frame %d"), FrameIndex), BatchSizes.Num(), FrameIndex + 1))
+		{
+			TestEqual(FString::Printf(TEXT("Hits in the frame %d batch"), FrameIndex), BatchSizes[FrameIndex], NumPellets);
+		}
+	}
+
+	TestEqual(TEXT("Damage messages with the wrong target or magnitude"), NumMismatchedPayloads, 0);
+
+	ListenerHandle.Unregister();
+	ImmediateListenerHandle.Unregister();
+	DamageEffect->MarkAsGarbage();
+
+	LyraTestWorld::DestroyGameInstanceWorld(World);
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
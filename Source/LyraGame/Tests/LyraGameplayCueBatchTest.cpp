@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "AbilitySystem/LyraAbilitySystemComponent.h"
+#include "AbilitySystem/LyraGameplayCueManager.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraGameplayCueBatchTestActor.h"
+#include "LyraTestWorld.h"
+#include "NativeGameplayTags.h"
+
+namespace LyraGameplayCueBatchTest
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_GameplayCue_Impact, "GameplayCue.Weapon.Shotgun.Impact");
+
+	// Impacts reported for the same cue within one frame
+	static constexpr int32 NumImpactsPerFrame = 8;
+	static constexpr int32 NumFrames = 3;
+
+	static int32 GetMaxImpactsPerBatch()
+	{
+		const IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lyra.GameplayCues.MaxImpactsPerBatch"));
+		return (CVar != nullptr) ? FMath::Max(CVar->GetInt(), 1) : 1;
+	}
+
+	static void AddImpacts(ULyraGameplayCueManager* GCM, ULyraAbilitySystemComponent* AbilitySystemComponent, int32 NumImpacts, int32 FrameIndex)
+	{
+		for (int32 ImpactIndex = 0; ImpactIndex < NumImpacts; ++ImpactIndex)
+		{
+			FHitResult Hit;
+			Hit.ImpactPoint = FVector(1000.0, ImpactIndex * 10.0, FrameIndex * 10.0);
+			Hit.ImpactNormal = FVector(-1.0, 0.0, 0.0);
+
+			FGameplayCueParameters CueParameters;
+			CueParameters.EffectContext = AbilitySystemComponent->MakeEffectContext();
+			CueParameters.EffectContext.AddHitResult(Hit);
+
+			GCM->AddBatchedGameplayCue(AbilitySystemComponent, TAG_GameplayCue_Impact, CueParameters, false);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraGameplayCueBatchTest, "Lyra.GameplayCues.Batch.OneMulticastPerFrame", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::ProductFilter)
+
+bool FLyraGameplayCueBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace LyraGameplayCueBatchTest;
+
+	ULyraGameplayCueManager* GCM = ULyraGameplayCueManager::Get();
+	if (!TestNotNull(TEXT("Lyra gameplay cue manager"), GCM))
+	{
+		return false;
+	}
+
+	UWorld* World = LyraTestWorld::CreateWorld(TEXT("LyraGameplayCueBatchTest"));
+
+	// A standalone world is the authority, so every flushed batch goes through the multicast and is played right away.
+	// The component is owned by a different actor than its avatar, as with Lyra's player state and pawn
+	ALyraGameplayCueBatchTestActor* Owner = World->SpawnActor<ALyraGameplayCueBatchTestActor>();
+	ALyraGameplayCueBatchTestActor* Avatar = World->SpawnActor<ALyraGameplayCueBatchTestActor>();
+	ULyraAbilitySystemComponent* AbilitySystemComponent = NewObject<ULyraAbilitySystemComponent>(Owner);
+	AbilitySystemComponent->RegisterComponent();
+	AbilitySystemComponent->InitAbilityActorInfo(Owner, Avatar);
+
+	for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+	{
+		AddImpacts(GCM, AbilitySystemComponent, NumImpactsPerFrame, FrameIndex);
+
+		TestEqual(FString::Printf(TEXT("Executes received before the end of frame %d"), FrameIndex), Avatar->ExecutedImpactCounts.Num(), FrameIndex);
+
+		World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+
+		if (TestEqual(FString::Printf(TEXT("Executes received by the avatar by the end of frame %d"), FrameIndex), Avatar->ExecutedImpactCounts.Num(), FrameIndex + 1))
+		{
+			TestEqual(FString::Printf(TEXT("Impacts carried by the frame %d execute"), FrameIndex), Avatar->ExecutedImpactCounts[FrameIndex], NumImpactsPerFrame);
+		}
+	}
+
+	TestEqual(TEXT("Executes received by the owner"), Owner->ExecutedImpactCounts.Num(), 0);
+
+	// Nothing is left over for a frame without hits
+	World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+	TestEqual(TEXT("Executes received after a frame without hits"), Avatar->ExecutedImpactCounts.Num(), NumFrames);
+
+	// Impacts past the per batch limit are sent in a second execute of the same frame rather than dropped
+	const int32 MaxImpactsPerBatch = GetMaxImpactsPerBatch();
+	const int32 NumOverflowImpacts = 3;
+	AddImpacts(GCM, AbilitySystemComponent, MaxImpactsPerBatch + NumOverflowImpacts, NumFrames);
+	World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+
+	if (TestEqual(TEXT("Executes received for a frame over the batch limit"), Avatar->ExecutedImpactCounts.Num(), NumFrames + 2))
+	{
+		TestEqual(TEXT("Impacts carried by the full batch"), Avatar->ExecutedImpactCounts[NumFrames], MaxImpactsPerBatch);
+		TestEqual(TEXT("Impacts carried by the overflow batch"), Avatar->ExecutedImpactCounts[NumFrames + 1], NumOverflowImpacts);
+	}
+
+	LyraTestWorld::DestroyWorld(World);
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
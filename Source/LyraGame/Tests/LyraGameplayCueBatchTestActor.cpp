@@ -0,0 +1,18 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraGameplayCueBatchTestActor.h"
+
+#include "AbilitySystem/LyraGameplayCueManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraGameplayCueBatchTestActor)
+
+void ALyraGameplayCueBatchTestActor::HandleGameplayCue(UObject* Self, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters)
+{
+	if (EventType == EGameplayCueEvent::Executed)
+	{
+		TArray<FVector> Locations;
+		TArray<FVector> Normals;
+		TArray<UPhysicalMaterial*> PhysicalMaterials;
+		ExecutedImpactCounts.Add(ULyraGameplayCueManager::GetBatchedImpacts(Parameters, Locations, Normals, PhysicalMaterials));
+	}
+}
@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "GameFramework/Actor.h"
+#include "GameplayCueInterface.h"
+
+#include "LyraGameplayCueBatchTestActor.generated.h"
+
+/**
+ * ALyraGameplayCueBatchTestActor
+ *
+ * Records the gameplay cue executes it receives, used by the cue batching tests
+ */
+UCLASS(NotBlueprintable, Transient, HideDropdown)
+class ALyraGameplayCueBatchTestActor : public AActor, public IGameplayCueInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	//~IGameplayCueInterface interface
+	virtual void HandleGameplayCue(UObject* Self, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters) override;
+	//~End of IGameplayCueInterface interface
+
+	// Number of impacts carried by each execute received, in order
+	TArray<int32> ExecutedImpactCounts;
+};
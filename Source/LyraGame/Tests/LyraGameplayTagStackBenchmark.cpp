@@ -0,0 +1,187 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "NativeGameplayTags.h"
+#include "System/GameplayTagStack.h"
+
+namespace LyraGameplayTagStackBenchmark
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_MagazineAmmo, "Lyra.ShooterGame.Weapon.MagazineAmmo");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_SpareAmmo, "Lyra.ShooterGame.Weapon.SpareAmmo");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Eliminations, "ShooterGame.Score.Eliminations");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Deaths, "ShooterGame.Score.Deaths");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Assists, "ShooterGame.Score.Assists");
+
+	// Rough shooter match: a 16 player lobby firing a 30 round rifle, with score stats updated every few shots
+	static constexpr int32 NumContainers = 16;
+	static constexpr int32 NumShotsPerContainer = 20000;
+	static constexpr int32 MagazineSize = 30;
+	static constexpr int32 SpareAmmo = 120;
+
+	// The previous implementation of FGameplayTagStackContainer (linear search, count map, full array rebuild when a tag runs out), kept as a baseline
+	struct FLegacyStack : public FFastArraySerializerItem
+	{
+		FGameplayTag Tag;
+		int32 StackCount = 0;
+	};
+
+	struct FLegacyContainer : public FFastArraySerializer
+	{
+		TArray<FLegacyStack> Stacks;
+		TMap<FGameplayTag, int32> TagToCountMap;
+		int32 NumArrayRebuilds = 0;
+
+		void AddStack(FGameplayTag Tag, int32 StackCount)
+		{
+			for (FLegacyStack& Stack : Stacks)
+			{
+				if (Stack.Tag == Tag)
+				{
+					Stack.StackCount += StackCount;
+					TagToCountMap[Tag] = Stack.StackCount;
+					MarkItemDirty(Stack);
+					return;
+				}
+			}
+
+			FLegacyStack& NewStack = Stacks.AddDefaulted_GetRef();
+			NewStack.Tag = Tag;
+			NewStack.StackCount = StackCount;
+			MarkItemDirty(NewStack);
+			TagToCountMap.Add(Tag, StackCount);
+		}
+
+		void RemoveStack(FGameplayTag Tag, int32 StackCount)
+		{
+			for (auto It = Stacks.CreateIterator(); It; ++It)
+			{
+				FLegacyStack& Stack = *It;
+				if (Stack.Tag == Tag)
+				{
+					if (Stack.StackCount <= StackCount)
+					{
+						It.RemoveCurrent();
+						TagToCountMap.Remove(Tag);
+						MarkArrayDirty();
+						++NumArrayRebuilds;
+					}
+					else
+					{
+						Stack.StackCount -= StackCount;
+						TagToCountMap[Tag] = Stack.StackCount;
+						MarkItemDirty(Stack);
+					}
+					return;
+				}
+			}
+		}
+
+		int32 GetStackCount(FGameplayTag Tag) const
+		{
+			return TagToCountMap.FindRef(Tag);
+		}
+	};
+
+	// Fires every shot of the match against a set of containers, returning the time taken in seconds
+	template<typename ContainerType>
+	double RunShotWorkload(TArray<ContainerType>& Containers)
+	{
+		for (ContainerType& Container : Containers)
+		{
+			Container.AddStack(TAG_Eliminations, 1);
+			Container.AddStack(TAG_Deaths, 1);
+			Container.AddStack(TAG_Assists, 1);
+			Container.AddStack(TAG_MagazineAmmo, MagazineSize);
+			Container.AddStack(TAG_SpareAmmo, SpareAmmo);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 ShotIndex = 0; ShotIndex < NumShotsPerContainer; ++ShotIndex)
+		{
+			for (int32 ContainerIndex = 0; ContainerIndex < Containers.Num(); ++ContainerIndex)
+			{
+				ContainerType& Container = Containers[ContainerIndex];
+
+				// Ammo cost check and payment
+				if (Container.GetStackCount(TAG_MagazineAmmo) < 1)
+				{
+					// Reload, topping the spare ammo back up when it runs out
+					if (Container.GetStackCount(TAG_SpareAmmo) < MagazineSize)
+					{
+						Container.AddStack(TAG_SpareAmmo, SpareAmmo);
+					}
+					Container.RemoveStack(TAG_SpareAmmo, MagazineSize);
+					Container.AddStack(TAG_MagazineAmmo, MagazineSize);
+				}
+				Container.RemoveStack(TAG_MagazineAmmo, 1);
+
+				// Score stats, spread out over the lobby
+				if (((ShotIndex + ContainerIndex) % 8) == 0)
+				{
+					Container.AddStack(TAG_Eliminations, 1);
+				}
+				if (((ShotIndex + ContainerIndex) % 11) == 0)
+				{
+					Container.AddStack(TAG_Deaths, 1);
+				}
+				if (((ShotIndex + ContainerIndex) % 17) == 0)
+				{
+					Container.AddStack(TAG_Assists, 1);
+				}
+			}
+		}
+
+		return FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraGameplayTagStackBenchmark, "Lyra.System.GameplayTagStack.ShotWorkloadBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::PerfFilter)
+
+bool FLyraGameplayTagStackBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace LyraGameplayTagStackBenchmark;
+
+	TArray<FLegacyContainer> LegacyContainers;
+	LegacyContainers.SetNum(NumContainers);
+
+	TArray<FGameplayTagStackContainer> IndexedContainers;
+	IndexedContainers.SetNum(NumContainers);
+
+	const double LegacySeconds = RunShotWorkload(LegacyContainers);
+	const double IndexedSeconds = RunShotWorkload(IndexedContainers);
+
+	// Every item added to a fast array is assigned a new replication ID, so these count how many items clients had to create
+	int32 NumLegacyArrayRebuilds = 0;
+	int32 NumLegacyItemsCreated = 0;
+	int32 NumIndexedItemsCreated = 0;
+	const FGameplayTag Tags[] = { TAG_MagazineAmmo, TAG_SpareAmmo, TAG_Eliminations, TAG_Deaths, TAG_Assists };
+	for (int32 ContainerIndex = 0; ContainerIndex < NumContainers; ++ContainerIndex)
+	{
+		NumLegacyArrayRebuilds += LegacyContainers[ContainerIndex].NumArrayRebuilds;
+		NumLegacyItemsCreated += LegacyContainers[ContainerIndex].IDCounter;
+		NumIndexedItemsCreated += IndexedContainers[ContainerIndex].IDCounter;
+
+		for (const FGameplayTag& Tag : Tags)
+		{
+			const int32 LegacyCount = LegacyContainers[ContainerIndex].GetStackCount(Tag);
+			const int32 IndexedCount = IndexedContainers[ContainerIndex].GetStackCount(Tag);
+			TestEqual(FString::Printf(TEXT("Stack count of %s in container %d"), *Tag.ToString(), ContainerIndex), IndexedCount, LegacyCount);
+			TestEqual(FString::Printf(TEXT("ContainsTag(%s) in container %d"), *Tag.ToString(), ContainerIndex), IndexedContainers[ContainerIndex].ContainsTag(Tag), LegacyCount > 0);
+		}
+	}
+
+	// Emptied items are kept, so each tag is only ever created once per container
+	TestEqual(TEXT("Items created by the indexed containers"), NumIndexedItemsCreated, NumContainers * (int32)UE_ARRAY_COUNT(Tags));
+
+	const int32 NumShots = NumContainers * NumShotsPerContainer;
+	AddInfo(FString::Printf(TEXT("Legacy:  %.3f ms for %d shots (%.1f ns/shot), %d full array rebuilds, %d items created"), LegacySeconds * 1000.0, NumShots, LegacySeconds * 1.0e9 / NumShots, NumLegacyArrayRebuilds, NumLegacyItemsCreated));
+	AddInfo(FString::Printf(TEXT("Indexed: %.3f ms for %d shots (%.1f ns/shot), %d items created"), IndexedSeconds * 1000.0, NumShots, IndexedSeconds * 1.0e9 / NumShots, NumIndexedItemsCreated));
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
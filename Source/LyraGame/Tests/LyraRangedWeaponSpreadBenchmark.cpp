@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "LyraTestWorld.h"
+#include "UObject/UnrealType.h"
+#include "Weapons/LyraRangedWeaponInstance.h"
+
+namespace LyraRangedWeaponSpreadBenchmark
+{
+	// Rough busy match: 128 armed pawns ticked for 20 seconds at 60Hz, each firing every few frames
+	static constexpr int32 NumPawns = 128;
+	static constexpr int32 NumTicks = 1200;
+	static constexpr int32 FramesBetweenShots = 6;
+	static constexpr float DeltaSeconds = 1.0f / 60.0f;
+
+	// Sets one of the weapon's heat curves, they are only exposed to the editor
+	void SetHeatCurve(ULyraRangedWeaponInstance* Weapon, FName CurveName, std::initializer_list<TPair<float, float>> Keys)
+	{
+		const FStructProperty* CurveProperty = FindFProperty<FStructProperty>(ULyraRangedWeaponInstance::StaticClass(), CurveName);
+		check(CurveProperty && (CurveProperty->Struct == FRuntimeFloatCurve::StaticStruct()));
+
+		FRichCurve& Curve = CurveProperty->ContainerPtrToValuePtr<FRuntimeFloatCurve>(Weapon)->EditorCurveData;
+		Curve.Reset();
+		for (const TPair<float, float>& Key : Keys)
+		{
+			Curve.AddKey(Key.Key, Key.Value);
+		}
+	}
+
+	// An assault rifle style weapon, the spread curve is cubic between the keys
+	ULyraRangedWeaponInstance* MakeRifle(APawn* Pawn)
+	{
+		ULyraRangedWeaponInstance* Weapon = NewObject<ULyraRangedWeaponInstance>(Pawn);
+		SetHeatCurve(Weapon, TEXT("HeatToSpreadCurve"), { {0.0f, 0.5f}, {2.0f, 0.8f}, {4.0f, 1.5f}, {6.0f, 2.5f}, {8.0f, 3.2f}, {10.0f, 3.5f} });
+		SetHeatCurve(Weapon, TEXT("HeatToHeatPerShotCurve"), { {0.0f, 1.0f}, {8.0f, 1.5f} });
+		SetHeatCurve(Weapon, TEXT("HeatToCoolDownPerSecondCurve"), { {0.0f, 4.0f}, {10.0f, 2.0f} });
+		return Weapon;
+	}
+
+	// Equips every weapon and runs the match with lyra.Weapon.BakeHeatCurves set as requested, returns the time spent in the weapon updates
+	double RunWorkload(UWorld* World, const TArray<ULyraRangedWeaponInstance*>& Weapons, bool bBakeHeatCurves, TArray<float>& OutHeat, TArray<float>& OutSpread)
+	{
+		IConsoleVariable* BakeHeatCurvesCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("lyra.Weapon.BakeHeatCurves"));
+		check(BakeHeatCurvesCVar);
+		const bool bPreviousBakeHeatCurves = BakeHeatCurvesCVar->GetBool();
+		BakeHeatCurvesCVar->Set(bBakeHeatCurves, ECVF_SetByCode);
+
+		for (ULyraRangedWeaponInstance* Weapon : Weapons)
+		{
+			Weapon->OnEquipped();
+		}
+
+		double Seconds = 0.0;
+		for (int32 TickIndex = 0; TickIndex < NumTicks; ++TickIndex)
+		{
+			World->TimeSeconds += DeltaSeconds;
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 PawnIndex = 0; PawnIndex < Weapons.Num(); ++PawnIndex)
+			{
+				ULyraRangedWeaponInstance* Weapon = Weapons[PawnIndex];
+				if (((TickIndex + PawnIndex) % FramesBetweenShots) == 0)
+				{
+					Weapon->AddSpread();
+				}
+				Weapon->Tick(DeltaSeconds);
+			}
+			Seconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		OutHeat.Reset(Weapons.Num());
+		OutSpread.Reset(Weapons.Num());
+		for (ULyraRangedWeaponInstance* Weapon : Weapons)
+		{
+			OutHeat.Add(Weapon->GetCurrentHeat());
+			OutSpread.Add(Weapon->GetCalculatedSpreadAngle());
+			Weapon->OnUnequipped();
+		}
+
+		BakeHeatCurvesCVar->Set(bPreviousBakeHeatCurves, ECVF_SetByCode);
+		return Seconds;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLyraRangedWeaponSpreadBenchmark, "Lyra.Weapons.RangedWeapon.SpreadTickBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::PerfFilter)
+
+bool FLyraRangedWeaponSpreadBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace LyraRangedWeaponSpreadBenchmark;
+
+	UWorld* World = LyraTestWorld::CreateWorld(TEXT("LyraRangedWeaponSpreadBenchmark"));
+
+	TArray<ULyraRangedWeaponInstance*> Weapons;
+	for (int32 PawnIndex = 0; PawnIndex < NumPawns; ++PawnIndex)
+	{
+		Weapons.Add(MakeRifle(World->SpawnActor<APawn>()));
+	}
+
+	TArray<float> CurveHeat;
+	TArray<float> CurveSpread;
+	const double CurveSeconds = RunWorkload(World, Weapons, /*bBakeHeatCurves=*/ false, CurveHeat, CurveSpread);
+
+	TArray<float> BakedHeat;
+	TArray<float> BakedSpread;
+	const double BakedSeconds = RunWorkload(World, Weapons, /*bBakeHeatCurves=*/ true, BakedHeat, BakedSpread);
+
+	// The tables only approximate the curves between samples, so compare with a tolerance
+	for (int32 PawnIndex = 0; PawnIndex < NumPawns; ++PawnIndex)
+	{
+		TestNearlyEqual(FString::Printf(TEXT("Heat of pawn %d"), PawnIndex), BakedHeat[PawnIndex], CurveHeat[PawnIndex], 0.05f);
+		TestNearlyEqual(FString::Printf(TEXT("Spread of pawn %d"), PawnIndex), BakedSpread[PawnIndex], CurveSpread[PawnIndex], 0.01f);
+	}
+
+	const int32 NumWeaponTicks = NumPawns * NumTicks;
+	AddInfo(FString::Printf(TEXT("Curves: %.3f ms for %d weapon ticks (%.1f ns/tick)"), CurveSeconds * 1000.0, NumWeaponTicks, CurveSeconds * 1.0e9 / NumWeaponTicks));
+	AddInfo(FString::Printf(TEXT("Baked:  %.3f ms for %d weapon ticks (%.1f ns/tick)"), BakedSeconds * 1000.0, NumWeaponTicks, BakedSeconds * 1.0e9 / NumWeaponTicks));
+
+	LyraTestWorld::DestroyWorld(World);
+
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
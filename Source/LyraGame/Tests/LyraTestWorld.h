@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+// World setup shared by the Lyra automation tests
+namespace LyraTestWorld
+{
+	// Creates a game world that has begun play, for tests that only spawn and tick actors
+	inline UWorld* CreateWorld(const TCHAR* WorldName)
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, WorldName);
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	// Destroys a world made by CreateWorld
+	inline void DestroyWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	// Creates a game world owned by a standalone game instance that has begun play, for tests that use game instance or world subsystems
+	inline UWorld* CreateGameInstanceWorld(const TCHAR* WorldName)
+	{
+		UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+		GameInstance->AddToRoot();
+		GameInstance->InitializeStandalone(WorldName);
+
+		UWorld* World = GameInstance->GetWorld();
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	// Destroys a world made by CreateGameInstanceWorld, along with its game instance
+	inline void DestroyGameInstanceWorld(UWorld* World)
+	{
+		UGameInstance* GameInstance = World->GetGameInstance();
+		GameInstance->Shutdown();
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		GameInstance->RemoveFromRoot();
+	}
+}
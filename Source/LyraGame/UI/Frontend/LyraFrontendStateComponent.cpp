@@ -6,9 +6,12 @@
 #include "CommonSessionSubsystem.h"
 #include "CommonUserSubsystem.h"
 #include "ControlFlowManager.h"
+#include "GameModes/LyraExperienceManager.h"
 #include "GameModes/LyraExperienceManagerComponent.h"
+#include "GameModes/LyraUserFacingExperienceDefinition.h"
 #include "Kismet/GameplayStatics.h"
 #include "NativeGameplayTags.h"
+#include "Online/OnlineSessionNames.h"
 #include "PrimaryGameLayout.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 
@@ -211,6 +214,16 @@ void ULyraFrontendStateComponent::FlowStep_TryJoinRequestedSession(FControlFlowN
 					return;
 				}
 			});
+			// Sessions advertise the user facing experience they are running, start streaming it while we join and travel
+			FString UserFacingExperienceName;
+			bool bFoundUserFacingExperience = false;
+			GameInstance->GetRequestedSession()->GetStringSetting(SETTING_GAMEMODE, /*out*/ UserFacingExperienceName, /*out*/ bFoundUserFacingExperience);
+			if (bFoundUserFacingExperience && !UserFacingExperienceName.IsEmpty())
+			{
+				const FPrimaryAssetId UserFacingExperienceId(ULyraUserFacingExperienceDefinition::StaticClass()->GetFName(), FName(*UserFacingExperienceName));
+				GEngine->GetEngineSubsystem<ULyraExperienceManager>()->PrefetchExperience(UserFacingExperienceId, /*bWillHost=*/ false);
+			}
+
 			GameInstance->JoinRequestedSession();
 			return;
 		}
@@ -122,6 +122,66 @@ bool FIndicatorProjection::Project(const UIndicatorDescriptor& IndicatorDescript
 	return false;
 }
 
+bool FIndicatorProjection::GetComponentPointLocation(const UIndicatorDescriptor& IndicatorDescriptor, FVector& OutWorldLocation)
+{
+	if (USceneComponent* Component = IndicatorDescriptor.GetSceneComponent())
+	{
+		if (IndicatorDescriptor.GetComponentSocketName() != NAME_None)
+		{
+			OutWorldLocation = Component->GetSocketTransform(IndicatorDescriptor.GetComponentSocketName()).GetLocation();
+		}
+		else
+		{
+			OutWorldLocation = Component->GetComponentLocation();
+		}
+
+		OutWorldLocation += IndicatorDescriptor.GetWorldPositionOffset();
+		return true;
+	}
+
+	return false;
+}
+
+void FIndicatorProjection::ProjectComponentPoints(TConstArrayView<const UIndicatorDescriptor*> IndicatorDescriptors, TConstArrayView<FVector> WorldLocations,
+	const FSceneViewProjectionData& InProjectionData, const FVector2f& ScreenSize, TArrayView<FVector> OutScreenPositionsWithDepth)
+{
+	check(IndicatorDescriptors.Num() == WorldLocations.Num());
+	check(IndicatorDescriptors.Num() == OutScreenPositionsWithDepth.Num());
+
+	// ULocalPlayer::GetPixelPoint rebuilds this for every point
+	const FMatrix ViewProjectionMatrix = InProjectionData.ComputeViewProjectionMatrix();
+	const FVector2D HalfScreenSize = FVector2D(ScreenSize) * 0.5;
+	const FBox2f ScreenBox(FVector2f::Zero(), ScreenSize);
+
+	for (int32 Index = 0; Index < WorldLocations.Num(); ++Index)
+	{
+		const FVector& WorldLocation = WorldLocations[Index];
+
+		// Same as ULocalPlayer::GetPixelPoint
+		FPlane Result = ViewProjectionMatrix.TransformFVector4(FVector4(WorldLocation, 1.0));
+		const bool bInFrontOfCamera = (Result.W >= 0.0);
+		if (Result.W == 0.0)
+		{
+			Result.W = 1.0;
+		}
+		const double RHW = 1.0 / FMath::Abs(Result.W);
+
+		FVector2D OutScreenSpacePosition((Result.X * RHW * HalfScreenSize.X) + HalfScreenSize.X, HalfScreenSize.Y - (Result.Y * RHW * HalfScreenSize.Y));
+
+		const FVector2D& ScreenSpaceOffset = IndicatorDescriptors[Index]->GetScreenSpaceOffset();
+		OutScreenSpacePosition.X += ScreenSpaceOffset.X * (bInFrontOfCamera ? 1 : -1);
+		OutScreenSpacePosition.Y += ScreenSpaceOffset.Y;
+
+		if (!bInFrontOfCamera && ScreenBox.IsInside((FVector2f)OutScreenSpacePosition))
+		{
+			const FVector2f CenterToPosition = (FVector2f(OutScreenSpacePosition) - (ScreenSize / 2)).GetSafeNormal();
+			OutScreenSpacePosition = FVector2D((ScreenSize / 2) + CenterToPosition * ScreenSize);
+		}
+
+		OutScreenPositionsWithDepth[Index] = FVector(OutScreenSpacePosition.X, OutScreenSpacePosition.Y, FVector::Dist(InProjectionData.ViewOrigin, WorldLocation));
+	}
+}
+
 void UIndicatorDescriptor::SetIndicatorManagerComponent(ULyraIndicatorManagerComponent* InManager)
 {
 	// Make sure nobody has set this.
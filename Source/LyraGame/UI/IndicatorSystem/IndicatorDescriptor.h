@@ -19,6 +19,16 @@ struct FSceneViewProjectionData;
 struct FIndicatorProjection
 {
 	bool Project(const UIndicatorDescriptor& IndicatorDescriptor, const FSceneViewProjectionData& InProjectionData, const FVector2f& ScreenSize, FVector& ScreenPositionWithDepth);
+
+	// Returns the world location a ComponentPoint indicator projects (false if it has no scene component)
+	static bool GetComponentPointLocation(const UIndicatorDescriptor& IndicatorDescriptor, FVector& OutWorldLocation);
+
+	/**
+	 * Projects a batch of ComponentPoint indicators in one loop over contiguous world locations (see GetComponentPointLocation),
+	 * computing the view projection matrix once for the whole batch. Gives the same results as calling Project on each of them.
+	 */
+	static void ProjectComponentPoints(TConstArrayView<const UIndicatorDescriptor*> IndicatorDescriptors, TConstArrayView<FVector> WorldLocations,
+		const FSceneViewProjectionData& InProjectionData, const FVector2f& ScreenSize, TArrayView<FVector> OutScreenPositionsWithDepth);
 };
 
 UENUM(BlueprintType)
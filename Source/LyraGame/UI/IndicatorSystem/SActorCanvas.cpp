@@ -2,6 +2,7 @@
 
 #include "SActorCanvas.h"
 
+#include "Algo/StableSort.h"
 #include "Engine/GameViewportClient.h"
 #include "IActorIndicatorWidget.h"
 #include "Layout/ArrangedChildren.h"
@@ -202,6 +203,10 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 
 			bool IndicatorsChanged = false;
 
+			PointProjectionSlotIndices.Reset();
+			PointProjectionIndicators.Reset();
+			PointProjectionWorldLocations.Reset();
+
 			for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
 			{
 				SActorCanvas::FSlot& CurChild = CanvasChildren[ChildIndex];
@@ -235,39 +240,40 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 					IndicatorsChanged = true;
 				}
 
+				// Point indicators are gathered and projected together below, the bounding box modes need the bounds of each component
+				FVector WorldLocation;
+				if ((Indicator->GetProjectionMode() == EActorCanvasProjectionMode::ComponentPoint) && FIndicatorProjection::GetComponentPointLocation(*Indicator, OUT WorldLocation))
+				{
+					PointProjectionSlotIndices.Add(ChildIndex);
+					PointProjectionIndicators.Add(Indicator);
+					PointProjectionWorldLocations.Add(WorldLocation);
+					continue;
+				}
+
 				FVector ScreenPositionWithDepth;
 
 				FIndicatorProjection Projector;
 				const bool Success = Projector.Project(*Indicator, ProjectionData, PaintGeometry.Size, OUT ScreenPositionWithDepth);
 
-				if (!Success)
-				{
-					CurChild.SetHasValidScreenPosition(false);
-					CurChild.SetInFrontOfCamera(false);
-
-					IndicatorsChanged |= CurChild.bIsDirty();
-					CurChild.ClearDirtyFlag();
-					continue;
-				}
+				IndicatorsChanged |= ApplyProjectionToSlot(CurChild, Success, ScreenPositionWithDepth);
+			}
 
-				CurChild.SetInFrontOfCamera(Success);
-				CurChild.SetHasValidScreenPosition(CurChild.GetInFrontOfCamera() || Indicator->GetClampToScreen());
+			if (PointProjectionSlotIndices.Num() > 0)
+			{
+				PointProjectionResults.SetNumUninitialized(PointProjectionSlotIndices.Num(), EAllowShrinking::No);
+				FIndicatorProjection::ProjectComponentPoints(PointProjectionIndicators, PointProjectionWorldLocations, ProjectionData, PaintGeometry.Size, OUT PointProjectionResults);
 
-				if (CurChild.HasValidScreenPosition())
+				for (int32 PointIndex = 0; PointIndex < PointProjectionSlotIndices.Num(); ++PointIndex)
 				{
-					// Only dirty the screen position if we can actually show this indicator.
-					CurChild.SetScreenPosition(FVector2D(ScreenPositionWithDepth));
-					CurChild.SetDepth(ScreenPositionWithDepth.X);
+					IndicatorsChanged |= ApplyProjectionToSlot(CanvasChildren[PointProjectionSlotIndices[PointIndex]], true, PointProjectionResults[PointIndex]);
 				}
-
-				CurChild.SetPriority(Indicator->GetPriority());
-
-				IndicatorsChanged |= CurChild.bIsDirty();
-				CurChild.ClearDirtyFlag();
 			}
 
+			IndicatorsChanged |= SortSlots();
+
 			if (IndicatorsChanged)
 			{
+				bArrangementDirty = true;
 				Invalidate(EInvalidateWidget::Paint);
 			}
 		}
@@ -292,11 +298,112 @@ EActiveTimerReturnType SActorCanvas::UpdateCanvas(double InCurrentTime, float In
 	}
 }
 
+bool SActorCanvas::ApplyProjectionToSlot(FSlot& Slot, bool bProjected, const FVector& ScreenPositionWithDepth)
+{
+	if (!bProjected)
+	{
+		Slot.SetHasValidScreenPosition(false);
+		Slot.SetInFrontOfCamera(false);
+	}
+	else
+	{
+		Slot.SetInFrontOfCamera(bProjected);
+		Slot.SetHasValidScreenPosition(Slot.GetInFrontOfCamera() || Slot.Indicator->GetClampToScreen());
+
+		if (Slot.HasValidScreenPosition())
+		{
+			// Only dirty the screen position if we can actually show this indicator.
+			Slot.SetScreenPosition(FVector2D(ScreenPositionWithDepth));
+			Slot.SetDepth(ScreenPositionWithDepth.Z);
+		}
+
+		Slot.SetPriority(Slot.Indicator->GetPriority());
+	}
+
+	const bool bSlotChanged = Slot.bIsDirty();
+	Slot.ClearDirtyFlag();
+	return bSlotChanged;
+}
+
+bool SActorCanvas::SortSlots()
+{
+	auto SortPredicate = [](const FSlot* A, const FSlot* B)
+	{
+		return A->GetPriority() == B->GetPriority() ? A->GetDepth() > B->GetDepth() : A->GetPriority() < B->GetPriority();
+	};
+
+	// Indicators rarely swap places between frames, so start by counting how many are out of order
+	int32 NumOutOfOrder = 0;
+	for (int32 SlotIndex = 1; SlotIndex < SortedSlots.Num(); ++SlotIndex)
+	{
+		if (SortPredicate(SortedSlots[SlotIndex], SortedSlots[SlotIndex - 1]))
+		{
+			++NumOutOfOrder;
+		}
+	}
+
+	if (NumOutOfOrder == 0)
+	{
+		return false;
+	}
+
+	if (NumOutOfOrder <= FMath::Max(4, SortedSlots.Num() / 16))
+	{
+		// Insertion sort is close to linear on a nearly sorted array (and stable)
+		for (int32 SlotIndex = 1; SlotIndex < SortedSlots.Num(); ++SlotIndex)
+		{
+			const FSlot* SlotToInsert = SortedSlots[SlotIndex];
+
+			int32 InsertIndex = SlotIndex;
+			while ((InsertIndex > 0) && SortPredicate(SlotToInsert, SortedSlots[InsertIndex - 1]))
+			{
+				SortedSlots[InsertIndex] = SortedSlots[InsertIndex - 1];
+				--InsertIndex;
+			}
+			SortedSlots[InsertIndex] = SlotToInsert;
+		}
+	}
+	else
+	{
+		Algo::StableSort(SortedSlots, SortPredicate);
+	}
+
+	return true;
+}
+
+bool SActorCanvas::CanReuseArrangement(const FGeometry& AllottedGeometry) const
+{
+	if (bArrangementDirty)
+	{
+		return false;
+	}
+
+	if ((AllottedGeometry.GetLocalSize() != CachedArrangeLocalSize) ||
+		(AllottedGeometry.GetAccumulatedLayoutTransform() != CachedArrangeLayoutTransform) ||
+		(AllottedGeometry.GetAccumulatedRenderTransform() != CachedArrangeRenderTransform))
+	{
+		return false;
+	}
+
+	// Indicator widgets can change their own size (e.g., a distance readout), which moves them relative to their anchor
+	for (const FSlot* Slot : SortedSlots)
+	{
+		const TSharedRef<SWidget>& SlotWidget = Slot->GetWidget();
+		if (SlotWidget->GetVisibility().IsVisible() && (SlotWidget->GetDesiredSize() != Slot->ArrangedSize))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void SActorCanvas::SetShowAnyIndicators(bool bIndicators)
 {
 	if (bShowAnyIndicators != bIndicators)
 	{
 		bShowAnyIndicators = bIndicators;
+		bArrangementDirty = true;
 
 		if (!bShowAnyIndicators)
 		{
@@ -321,19 +428,7 @@ void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrange
 		const FIntPoint FixedPadding = FIntPoint(10.0f, 10.0f) + FIntPoint(ArrowWidgetSize.X, ArrowWidgetSize.Y);
 		const FVector Center = FVector(AllottedGeometry.Size * 0.5f, 0.0f);
 
-		// Sort the children
-		TArray<const SActorCanvas::FSlot*> SortedSlots;
-		for (int32 ChildIndex = 0; ChildIndex < CanvasChildren.Num(); ++ChildIndex)
-		{
-			SortedSlots.Add(&CanvasChildren[ChildIndex]);
-		}
-
-		SortedSlots.StableSort([](const SActorCanvas::FSlot& A, const SActorCanvas::FSlot& B)
-		{
-			return A.GetPriority() == B.GetPriority() ? A.GetDepth() > B.GetDepth() : A.GetPriority() < B.GetPriority();
-		});
-
-		// Go through all the sorted children
+		// Go through all the sorted children (sorted by UpdateCanvas)
 		for (int32 ChildIndex = 0; ChildIndex < SortedSlots.Num(); ++ChildIndex)
 		{
 			//grab a child
@@ -356,6 +451,7 @@ void SActorCanvas::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrange
 			//get the offset and final size of the slot
 			FVector2D SlotSize, SlotOffset, SlotPaddingMin, SlotPaddingMax;
 			GetOffsetAndSize(Indicator, SlotSize, SlotOffset, SlotPaddingMin, SlotPaddingMax);
+			CurChild.ArrangedSize = SlotSize;
 
 			bool bWasIndicatorClamped = false;
 
@@ -507,15 +603,25 @@ int32 SActorCanvas::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeo
 
 	OptionalPaintGeometry = AllottedGeometry;
 
-	FArrangedChildren ArrangedChildren(EVisibility::Visible);
-	ArrangeChildren(AllottedGeometry, ArrangedChildren);
+	// Only re-arrange when an indicator moved by at least a pixel, changed order or visibility, or the canvas itself moved
+	if (!CanReuseArrangement(AllottedGeometry))
+	{
+		FArrangedChildren ArrangedChildren(EVisibility::Visible);
+		ArrangeChildren(AllottedGeometry, ArrangedChildren);
+
+		CachedArrangedWidgets = ArrangedChildren.GetInternalArray();
+		CachedArrangeLocalSize = AllottedGeometry.GetLocalSize();
+		CachedArrangeLayoutTransform = AllottedGeometry.GetAccumulatedLayoutTransform();
+		CachedArrangeRenderTransform = AllottedGeometry.GetAccumulatedRenderTransform();
+		bArrangementDirty = false;
+	}
 
 	int32 MaxLayerId = LayerId;
 
 	const FPaintArgs NewArgs = Args.WithNewParent(this);
 	const bool bShouldBeEnabled = ShouldBeEnabled(bParentEnabled);
 
-	for (const FArrangedWidget& CurWidget : ArrangedChildren.GetInternalArray())
+	for (const FArrangedWidget& CurWidget : CachedArrangedWidgets)
 	{
 		if (!IsChildWidgetCulled(MyCullingRect, CurWidget))
 		{
@@ -627,10 +733,13 @@ SActorCanvas::FScopedWidgetSlotArguments SActorCanvas::AddActorSlot(UIndicatorDe
 {
 	TWeakPtr<SActorCanvas> WeakCanvas = SharedThis(this);
 	return FScopedWidgetSlotArguments{ MakeUnique<FSlot>(Indicator), this->CanvasChildren, INDEX_NONE
-		, [WeakCanvas](const FSlot*, int32)
+		, [WeakCanvas](const FSlot* NewSlot, int32)
 		{
 			if (TSharedPtr<SActorCanvas> Canvas = WeakCanvas.Pin())
 			{
+				// Sorted into place on the next update
+				Canvas->SortedSlots.Add(NewSlot);
+				Canvas->bArrangementDirty = true;
 				Canvas->UpdateActiveTimer();
 			}
 		}};
@@ -642,6 +751,9 @@ int32 SActorCanvas::RemoveActorSlot(const TSharedRef<SWidget>& SlotWidget)
 	{
 		if ( SlotWidget == CanvasChildren[SlotIdx].GetWidget() )
 		{
+			SortedSlots.Remove(&CanvasChildren[SlotIdx]);
+			bArrangementDirty = true;
+
 			CanvasChildren.RemoveAt(SlotIdx);
 
 			UpdateActiveTimer();
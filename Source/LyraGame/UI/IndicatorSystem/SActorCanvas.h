@@ -4,6 +4,7 @@
 
 #include "AsyncMixin.h"
 #include "Blueprint/UserWidgetPool.h"
+#include "Layout/ArrangedWidget.h"
 #include "Widgets/SPanel.h"
 
 class FActiveTimerHandle;
@@ -60,21 +61,19 @@ public:
 		FVector2D GetScreenPosition() const { return ScreenPosition; }
 		void SetScreenPosition(FVector2D InScreenPosition)
 		{
-			if (ScreenPosition != InScreenPosition)
+			// Sub-pixel movement doesn't change the layout, so the slot only moves once it is at least a pixel away
+			if (FVector2D::DistSquared(ScreenPosition, InScreenPosition) > 1.0)
 			{
 				ScreenPosition = InScreenPosition;
 				bDirty = true;
 			}
 		}
 
+		// Depth only affects the sort order, which SActorCanvas tracks itself, so it doesn't dirty the slot
 		double GetDepth() const { return Depth; }
 		void SetDepth(double InDepth)
 		{
-			if (Depth != InDepth)
-			{
-				Depth = InDepth;
-				bDirty = true;
-			}
+			Depth = InDepth;
 		}
 
 		int32 GetPriority() const { return Priority; }
@@ -159,6 +158,9 @@ public:
 		mutable uint8 bWasIndicatorClamped : 1;
 		mutable uint8 bWasIndicatorClampedStatusChanged : 1;
 
+		/** Size the slot was last arranged with, used to detect indicator widgets resizing themselves */
+		mutable FVector2D ArrangedSize = FVector2D::ZeroVector;
+
 		friend class SActorCanvas;
 	};
 
@@ -215,6 +217,15 @@ private:
 	void SetShowAnyIndicators(bool bIndicators);
 	EActiveTimerReturnType UpdateCanvas(double InCurrentTime, float InDeltaTime);
 
+	/** Applies the result of projecting a slot's indicator, returns true if the slot changed */
+	bool ApplyProjectionToSlot(FSlot& Slot, bool bProjected, const FVector& ScreenPositionWithDepth);
+
+	/** Restores the priority/depth order of SortedSlots, returns true if the order changed */
+	bool SortSlots();
+
+	/** Returns true if the arrangement from the last paint is still valid for this geometry */
+	bool CanReuseArrangement(const FGeometry& AllottedGeometry) const;
+
 	/** Helper function for calculating the offset */
 	void GetOffsetAndSize(const UIndicatorDescriptor* Indicator,
 		FVector2D& OutSize, 
@@ -236,6 +247,22 @@ private:
 	mutable TPanelChildren<FArrowSlot> ArrowChildren;
 	FCombinedChildren AllChildren;
 
+	/** The canvas slots in arrange order, kept sorted across frames so it only needs a few fixups each update */
+	TArray<const FSlot*> SortedSlots;
+
+	/** Scratch arrays for the batched ComponentPoint projection, indexed in parallel */
+	TArray<int32> PointProjectionSlotIndices;
+	TArray<const UIndicatorDescriptor*> PointProjectionIndicators;
+	TArray<FVector> PointProjectionWorldLocations;
+	TArray<FVector> PointProjectionResults;
+
+	/** Children arranged by the last paint, reused until a slot changes or the geometry does */
+	mutable TArray<FArrangedWidget> CachedArrangedWidgets;
+	mutable FVector2D CachedArrangeLocalSize = FVector2D::ZeroVector;
+	mutable FSlateLayoutTransform CachedArrangeLayoutTransform;
+	mutable FSlateRenderTransform CachedArrangeRenderTransform;
+	mutable bool bArrangementDirty = true;
+
 	FUserWidgetPool IndicatorPool;
 
 	const FSlateBrush* ActorCanvasArrowBrush = nullptr;
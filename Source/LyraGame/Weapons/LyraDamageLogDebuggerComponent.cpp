@@ -23,7 +23,7 @@ void ULyraDamageLogDebuggerComponent::BeginPlay()
 	Super::BeginPlay();
 
 	UGameplayMessageSubsystem& MessageSubsystem = UGameplayMessageSubsystem::Get(this);
-	ListenerHandle = MessageSubsystem.RegisterListener(TAG_Lyra_Damage_Message, this, &ThisClass::OnDamageMessage);
+	ListenerHandle = MessageSubsystem.RegisterBatchListener(TAG_Lyra_Damage_Message, this, &ThisClass::OnDamageMessages);
 }
 
 void ULyraDamageLogDebuggerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -81,19 +81,28 @@ void ULyraDamageLogDebuggerComponent::TickComponent(float DeltaTime, enum ELevel
 	}
 }
 
-void ULyraDamageLogDebuggerComponent::OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload)
+void ULyraDamageLogDebuggerComponent::OnDamageMessages(FGameplayTag Channel, TConstArrayView<FLyraVerbMessage> Payloads)
 {
-	if (Payload.Target == GetOwner())
+	// Every message in a batch was sent during the same frame, so they all land in a single log entry
+	FFrameDamageEntry* LogEntry = nullptr;
+
+	for (const FLyraVerbMessage& Payload : Payloads)
 	{
-		FFrameDamageEntry& LogEntry = DamageLog.FindOrAdd(GFrameCounter);
-		
-		if (LogEntry.TimeOfFirstHit == 0.0)
+		if (Payload.Target == GetOwner())
 		{
-			LogEntry.TimeOfFirstHit = GetWorld()->GetTimeSeconds();
-			LastDamageEntryTime = LogEntry.TimeOfFirstHit;
+			if (LogEntry == nullptr)
+			{
+				LogEntry = &DamageLog.FindOrAdd(GFrameCounter);
+			}
+
+			if (LogEntry->TimeOfFirstHit == 0.0)
+			{
+				LogEntry->TimeOfFirstHit = GetWorld()->GetTimeSeconds();
+				LastDamageEntryTime = LogEntry->TimeOfFirstHit;
+			}
+			LogEntry->NumImpacts++;
+			LogEntry->SumDamage += -Payload.Magnitude;
 		}
-		LogEntry.NumImpacts++;
-		LogEntry.SumDamage += -Payload.Magnitude;
 	}
 }
 
@@ -43,5 +43,5 @@ private:
 	TMap<int64, FFrameDamageEntry> DamageLog;
 
 private:
-	void OnDamageMessage(FGameplayTag Channel, const FLyraVerbMessage& Payload);
+	void OnDamageMessages(FGameplayTag Channel, TConstArrayView<FLyraVerbMessage> Payloads);
 };
@@ -7,6 +7,8 @@
 #include "AIController.h"
 #include "NativeGameplayTags.h"
 #include "Weapons/LyraWeaponStateComponent.h"
+#include "Weapons/LyraLagCompensationSubsystem.h"
+#include "GameFramework/GameStateBase.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystem/LyraGameplayAbilityTargetData_SingleTargetHit.h"
 #include "DrawDebugHelpers.h"
@@ -492,11 +494,18 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 			MyAbilityComponent->CallServerSetReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey(), LocalTargetDataHandle, ApplicationTag, MyAbilityComponent->ScopedPredictionKey);
 		}
 
-		const bool bIsTargetDataValid = true;
+		bool bIsTargetDataValid = true;
 
 		bool bProjectileWeapon = false;
 
 #if WITH_SERVER_CODE
+		// Rewind the targets to where the client saw them and replace any hits that don't hold up
+		const bool bShouldValidateHits = CurrentActorInfo->IsNetAuthority() && !CurrentActorInfo->IsLocallyControlled();
+		if (!bProjectileWeapon && bShouldValidateHits)
+		{
+			bIsTargetDataValid = ValidateTargetDataOnServer(LocalTargetDataHandle);
+		}
+
 		if (!bProjectileWeapon)
 		{
 			if (AController* Controller = GetControllerFromActorInfo())
@@ -535,6 +544,12 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 			check(WeaponData);
 			WeaponData->AddSpread();
 
+			// Play the impacts of every pellet as one batched cue
+			if (ImpactGameplayCueTag.IsValid())
+			{
+				ExecuteBatchedImpactGameplayCue(ImpactGameplayCueTag, LocalTargetDataHandle);
+			}
+
 			// Let the blueprint do stuff like apply effects to the targets
 			OnRangedWeaponTargetDataReady(LocalTargetDataHandle);
 		}
@@ -549,6 +564,86 @@ void ULyraGameplayAbility_RangedWeapon::OnTargetDataReadyCallback(const FGamepla
 	MyAbilityComponent->ConsumeClientReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey());
 }
 
+bool ULyraGameplayAbility_RangedWeapon::ValidateTargetDataOnServer(FGameplayAbilityTargetDataHandle& TargetData) const
+{
+	ULyraLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULyraLagCompensationSubsystem>();
+	if (LagCompensation == nullptr)
+	{
+		return true;
+	}
+
+	const ULyraRangedWeaponInstance* WeaponData = GetWeaponInstance();
+	const AActor* Shooter = GetAvatarActorFromActorInfo();
+	if ((WeaponData == nullptr) || (Shooter == nullptr))
+	{
+		return false;
+	}
+
+	const float SweepRadius = WeaponData->GetBulletTraceSweepRadius();
+
+	TArray<FLyraRewindHitRequest, TInlineAllocator<16>> Requests;
+	TArray<FLyraGameplayAbilityTargetData_SingleTargetHit*, TInlineAllocator<16>> RequestTargetData;
+	double Timestamp = 0.0;
+
+	for (int32 DataIndex = 0; DataIndex < TargetData.Num(); ++DataIndex)
+	{
+		FGameplayAbilityTargetData* Data = TargetData.Get(DataIndex);
+		if ((Data != nullptr) && Data->GetScriptStruct()->IsChildOf(FLyraGameplayAbilityTargetData_SingleTargetHit::StaticStruct()))
+		{
+			FLyraGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = static_cast<FLyraGameplayAbilityTargetData_SingleTargetHit*>(Data);
+
+			FLyraRewindHitRequest& Request = Requests.AddDefaulted_GetRef();
+			Request.HitActor = SingleTargetHit->HitResult.GetActor();
+			Request.TraceStart = SingleTargetHit->HitResult.TraceStart;
+			Request.TraceEnd = SingleTargetHit->HitResult.TraceEnd;
+			Request.SweepRadius = SweepRadius;
+
+			RequestTargetData.Add(SingleTargetHit);
+
+			// Every hit in a cartridge is traced at the same time
+			Timestamp = SingleTargetHit->Timestamp;
+		}
+	}
+
+	if (Requests.Num() == 0)
+	{
+		return true;
+	}
+
+	TArray<ELyraRewindHitResult, TInlineAllocator<16>> Results;
+	Results.SetNumUninitialized(Requests.Num());
+
+	const double RewindTime = LagCompensation->GetRewindTime(GetControllerFromActorInfo(), Timestamp);
+	if (!LagCompensation->ValidateHits(RewindTime, Shooter, WeaponData->GetMaxDamageRange(), Requests, Results))
+	{
+		UE_LOG(LogLyraAbilitySystem, Verbose, TEXT("Weapon ability %s rejected target data, timestamp %.3f is outside of the rewind window"), *GetPathName(), Timestamp);
+		return false;
+	}
+
+	if (Results.Contains(ELyraRewindHitResult::InvalidTrace))
+	{
+		UE_LOG(LogLyraAbilitySystem, Warning, TEXT("Weapon ability %s rejected target data, a trace did not start at %s or was longer than the weapon's range"), *GetPathName(), *GetNameSafe(Shooter));
+		return false;
+	}
+
+	for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); ++RequestIndex)
+	{
+		if (Results[RequestIndex] == ELyraRewindHitResult::Missed)
+		{
+			// Replace the claimed hit with a miss along the same trace, so no damage is applied and the client hit marker is withdrawn
+			FLyraGameplayAbilityTargetData_SingleTargetHit* SingleTargetHit = RequestTargetData[RequestIndex];
+			const FHitResult ClaimedHit = SingleTargetHit->HitResult;
+
+			SingleTargetHit->HitResult = FHitResult(ClaimedHit.TraceStart, ClaimedHit.TraceEnd);
+			SingleTargetHit->HitResult.Location = ClaimedHit.TraceEnd;
+			SingleTargetHit->HitResult.ImpactPoint = ClaimedHit.TraceEnd;
+			SingleTargetHit->bHitReplaced = true;
+		}
+	}
+
+	return true;
+}
+
 void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 {
 	check(CurrentActorInfo);
@@ -576,11 +671,16 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 	{
 		const int32 CartridgeID = FMath::Rand();
 
+		// Stamp the hits with our estimate of the server time so the server can rewind the targets we were aiming at
+		const AGameStateBase* GameState = GetWorld()->GetGameState();
+		const double Timestamp = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+
 		for (const FHitResult& FoundHit : FoundHits)
 		{
 			FLyraGameplayAbilityTargetData_SingleTargetHit* NewTargetData = new FLyraGameplayAbilityTargetData_SingleTargetHit();
 			NewTargetData->HitResult = FoundHit;
 			NewTargetData->CartridgeID = CartridgeID;
+			NewTargetData->Timestamp = Timestamp;
 
 			TargetData.Add(NewTargetData);
 		}
@@ -596,3 +696,21 @@ void ULyraGameplayAbility_RangedWeapon::StartRangedWeaponTargeting()
 	OnTargetDataReadyCallback(TargetData, FGameplayTag());
 }
 
+void ULyraGameplayAbility_RangedWeapon::ExecuteBatchedImpactGameplayCue(FGameplayTag GameplayCueTag, const FGameplayAbilityTargetDataHandle& TargetData)
+{
+	for (int32 DataIndex = 0; DataIndex < TargetData.Num(); ++DataIndex)
+	{
+		const FGameplayAbilityTargetData* Data = TargetData.Get(DataIndex);
+		const FHitResult* HitResult = Data ? Data->GetHitResult() : nullptr;
+		if (HitResult == nullptr)
+		{
+			continue;
+		}
+
+		FGameplayCueParameters Parameters;
+		Parameters.EffectContext = MakeEffectContext(CurrentSpecHandle, CurrentActorInfo);
+		Parameters.EffectContext.AddHitResult(*HitResult);
+
+		ExecuteGameplayCueBatched(GameplayCueTag, Parameters);
+	}
+}
@@ -111,6 +111,10 @@ protected:
 
 	void OnTargetDataReadyCallback(const FGameplayAbilityTargetDataHandle& InData, FGameplayTag ApplicationTag);
 
+	// Validates hits reported by a remote client against the lag compensated targets, replacing any that missed
+	// Returns false if the target data as a whole should be rejected
+	bool ValidateTargetDataOnServer(FGameplayAbilityTargetDataHandle& TargetData) const;
+
 	UFUNCTION(BlueprintCallable)
 	void StartRangedWeaponTargeting();
 
@@ -118,6 +122,15 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnRangedWeaponTargetDataReady(const FGameplayAbilityTargetDataHandle& TargetData);
 
+	// Executes a batched gameplay cue for every hit in the target data, so all the pellets of a cartridge arrive as a single multi-hit cue
+	UFUNCTION(BlueprintCallable, Category="Lyra|Ability", Meta = (GameplayTagFilter = "GameplayCue"))
+	void ExecuteBatchedImpactGameplayCue(FGameplayTag GameplayCueTag, const FGameplayAbilityTargetDataHandle& TargetData);
+
+	// Impact cue executed for every hit once the shot has been committed, batched so all the impacts of a frame are sent with a single multicast
+	// Leave empty if the blueprint plays its own impact cues
+	UPROPERTY(EditDefaultsOnly, Category="Lyra|Ability", Meta = (Categories = "GameplayCue"))
+	FGameplayTag ImpactGameplayCueTag;
+
 private:
 	FDelegateHandle OnTargetDataReadyCallbackDelegateHandle;
 };
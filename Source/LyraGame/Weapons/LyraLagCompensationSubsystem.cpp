@@ -0,0 +1,303 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LyraLagCompensationSubsystem.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LyraLagCompensationSubsystem)
+
+namespace LyraLagCompensation
+{
+	static int32 HistoryFrames = 64;
+	static FAutoConsoleVariableRef CVarHistoryFrames(
+		TEXT("Lyra.LagCompensation.HistoryFrames"),
+		HistoryFrames,
+		TEXT("Number of server frames of hitbox history to keep per character (read when the world starts)"),
+		ECVF_Default);
+
+	static float MaxRewindTime = 0.5f;
+	static FAutoConsoleVariableRef CVarMaxRewindTime(
+		TEXT("Lyra.LagCompensation.MaxRewindTime"),
+		MaxRewindTime,
+		TEXT("Hits claimed further in the past than this (in seconds) are rejected outright"),
+		ECVF_Default);
+
+	static float HitTolerance = 40.0f;
+	static FAutoConsoleVariableRef CVarHitTolerance(
+		TEXT("Lyra.LagCompensation.HitTolerance"),
+		HitTolerance,
+		TEXT("Extra distance (in uu) a trace may pass outside of a rewound capsule and still count as a hit, covers limbs and interpolation error"),
+		ECVF_Default);
+
+	static float MaxTraceStartOffset = 200.0f;
+	static FAutoConsoleVariableRef CVarMaxTraceStartOffset(
+		TEXT("Lyra.LagCompensation.MaxTraceStartOffset"),
+		MaxTraceStartOffset,
+		TEXT("Furthest (in uu) a claimed trace may start from the shooter, now or rewound, covers the camera offset and eye height"),
+		ECVF_Default);
+
+	static int32 InitialSlotCapacity = 32;
+}
+
+bool ULyraLagCompensationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	// Hits are only validated by the authority, clients have no use for the history
+	const UWorld* World = Outer ? Outer->GetWorld() : nullptr;
+	return (World != nullptr) && World->IsGameWorld() && (World->GetNetMode() != NM_Client);
+}
+
+void ULyraLagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	HistoryFrames = FMath::Max(LyraLagCompensation::HistoryFrames, 2);
+	FrameTimes.SetNumZeroed(HistoryFrames);
+	GrowSlots(LyraLagCompensation::InitialSlotCapacity);
+}
+
+void ULyraLagCompensationSubsystem::Deinitialize()
+{
+	FrameTimes.Empty();
+	SampleCenters.Empty();
+	SampleRotations.Empty();
+	SampleRadiusAndHalfHeights.Empty();
+	SlotCharacters.Empty();
+	FreeSlots.Empty();
+	ActorToSlot.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId ULyraLagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULyraLagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+void ULyraLagCompensationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (ActorToSlot.Num() == 0)
+	{
+		return;
+	}
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULyraLagCompensationSubsystem_Sample);
+
+	NewestFrameIndex = (NewestFrameIndex + 1) % HistoryFrames;
+	NumFramesRecorded = FMath::Min(NumFramesRecorded + 1, HistoryFrames);
+	FrameTimes[NewestFrameIndex] = GetWorld()->GetTimeSeconds();
+
+	for (int32 Slot = 0; Slot < SlotCharacters.Num(); ++Slot)
+	{
+		SampleSlot(Slot, NewestFrameIndex);
+	}
+}
+
+void ULyraLagCompensationSubsystem::RegisterCharacter(ACharacter* Character)
+{
+	check(Character);
+
+	if (ActorToSlot.Contains(Character))
+	{
+		return;
+	}
+
+	int32 Slot = INDEX_NONE;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = SlotCharacters.Num();
+		if (Slot >= SlotCapacity)
+		{
+			GrowSlots(SlotCapacity * 2);
+		}
+		SlotCharacters.AddDefaulted();
+	}
+
+	SlotCharacters[Slot] = Character;
+	ActorToSlot.Add(Character, Slot);
+
+	// Fill the whole history with the current pose so rewinding to before the character was registered is still sane
+	for (int32 FrameIndex = 0; FrameIndex < HistoryFrames; ++FrameIndex)
+	{
+		SampleSlot(Slot, FrameIndex);
+	}
+}
+
+void ULyraLagCompensationSubsystem::UnregisterCharacter(ACharacter* Character)
+{
+	int32 Slot = INDEX_NONE;
+	if (ActorToSlot.RemoveAndCopyValue(Character, /*out*/ Slot))
+	{
+		SlotCharacters[Slot].Reset();
+		FreeSlots.Add(Slot);
+	}
+}
+
+double ULyraLagCompensationSubsystem::GetRewindTime(const AController* Shooter, double ClientTimestamp) const
+{
+	const double ServerTime = GetWorld()->GetTimeSeconds();
+
+	// The client stamps shots with its estimate of the current server time, but the targets it was aiming at
+	// were replicated to it half a round trip ago
+	double OneWayLatency = 0.0;
+	if (const APlayerState* PlayerState = Shooter ? Shooter->PlayerState.Get() : nullptr)
+	{
+		OneWayLatency = PlayerState->GetPingInMilliseconds() * 0.5 / 1000.0;
+	}
+
+	// The timestamp is in the game state's replicated server time, convert it to this world's clock
+	double TimestampInWorldTime = ClientTimestamp;
+	if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+	{
+		TimestampInWorldTime = ClientTimestamp - (GameState->GetServerWorldTimeSeconds() - ServerTime);
+	}
+
+	return FMath::Min(TimestampInWorldTime - OneWayLatency, ServerTime);
+}
+
+bool ULyraLagCompensationSubsystem::ValidateHits(double RewindTime, const AActor* Shooter, float MaxTraceLength, TConstArrayView<FLyraRewindHitRequest> Requests, TArrayView<ELyraRewindHitResult> OutResults) const
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ULyraLagCompensationSubsystem_ValidateHits);
+
+	check(Requests.Num() == OutResults.Num());
+	check(Shooter);
+
+	const double ServerTime = GetWorld()->GetTimeSeconds();
+	if ((RewindTime < ServerTime - LyraLagCompensation::MaxRewindTime) || (NumFramesRecorded == 0))
+	{
+		return false;
+	}
+
+	// Find the two recorded frames either side of the rewind time, once for the whole batch
+	int32 NewerFrame = GetFrameIndex(0);
+	int32 OlderFrame = NewerFrame;
+	float Alpha = 0.0f;
+
+	if (RewindTime < FrameTimes[NewerFrame])
+	{
+		// Frame times only decrease with age, so binary search by age
+		int32 LowAge = 0;
+		int32 HighAge = NumFramesRecorded - 1;
+		if (RewindTime < FrameTimes[GetFrameIndex(HighAge)])
+		{
+			// Older than anything we have recorded
+			return false;
+		}
+
+		while (HighAge - LowAge > 1)
+		{
+			const int32 MidAge = (LowAge + HighAge) / 2;
+			if (FrameTimes[GetFrameIndex(MidAge)] > RewindTime)
+			{
+				LowAge = MidAge;
+			}
+			else
+			{
+				HighAge = MidAge;
+			}
+		}
+
+		NewerFrame = GetFrameIndex(LowAge);
+		OlderFrame = GetFrameIndex(HighAge);
+
+		const double FrameDelta = FrameTimes[NewerFrame] - FrameTimes[OlderFrame];
+		Alpha = (FrameDelta > UE_DOUBLE_SMALL_NUMBER) ? (float)((RewindTime - FrameTimes[OlderFrame]) / FrameDelta) : 1.0f;
+	}
+
+	// The trace start comes from the client, so it must be close to where the shooter is now or was when it fired
+	TArray<FVector, TInlineAllocator<2>> ShooterLocations;
+	ShooterLocations.Add(Shooter->GetActorLocation());
+	if (const int32* ShooterSlotPtr = ActorToSlot.Find(Shooter))
+	{
+		ShooterLocations.Add(FMath::Lerp(SampleCenters[GetSampleIndex(*ShooterSlotPtr, OlderFrame)], SampleCenters[GetSampleIndex(*ShooterSlotPtr, NewerFrame)], (double)Alpha));
+	}
+
+	// Allow for float error, the client traces exactly the weapon's range
+	const double MaxTraceLengthSquared = FMath::Square(MaxTraceLength + 1.0);
+	const double MaxTraceStartOffsetSquared = FMath::Square(LyraLagCompensation::MaxTraceStartOffset);
+
+	for (int32 RequestIndex = 0; RequestIndex < Requests.Num(); ++RequestIndex)
+	{
+		const FLyraRewindHitRequest& Request = Requests[RequestIndex];
+
+		const bool bTraceStartsAtShooter = ShooterLocations.ContainsByPredicate([&Request, MaxTraceStartOffsetSquared](const FVector& ShooterLocation)
+		{
+			return FVector::DistSquared(ShooterLocation, Request.TraceStart) <= MaxTraceStartOffsetSquared;
+		});
+
+		if (!bTraceStartsAtShooter || (FVector::DistSquared(Request.TraceStart, Request.TraceEnd) > MaxTraceLengthSquared))
+		{
+			OutResults[RequestIndex] = ELyraRewindHitResult::InvalidTrace;
+			continue;
+		}
+
+		const int32* SlotPtr = Request.HitActor ? ActorToSlot.Find(Request.HitActor) : nullptr;
+		if (SlotPtr == nullptr)
+		{
+			OutResults[RequestIndex] = ELyraRewindHitResult::NotTracked;
+			continue;
+		}
+
+		const int32 OlderSample = GetSampleIndex(*SlotPtr, OlderFrame);
+		const int32 NewerSample = GetSampleIndex(*SlotPtr, NewerFrame);
+
+		const FVector Center = FMath::Lerp(SampleCenters[OlderSample], SampleCenters[NewerSample], (double)Alpha);
+		const FQuat Rotation = FQuat::FastLerp(SampleRotations[OlderSample], SampleRotations[NewerSample], (double)Alpha).GetNormalized();
+		const FVector2f RadiusAndHalfHeight = FMath::Lerp(SampleRadiusAndHalfHeights[OlderSample], SampleRadiusAndHalfHeights[NewerSample], Alpha);
+
+		// Capsule vs swept sphere is the distance between the capsule axis and the trace segment
+		const FVector AxisExtent = Rotation.GetUpVector() * FMath::Max(RadiusAndHalfHeight.Y - RadiusAndHalfHeight.X, 0.0f);
+		FVector ClosestOnAxis;
+		FVector ClosestOnTrace;
+		FMath::SegmentDistToSegmentSafe(Center - AxisExtent, Center + AxisExtent, Request.TraceStart, Request.TraceEnd, /*out*/ ClosestOnAxis, /*out*/ ClosestOnTrace);
+
+		const double AllowedDistance = RadiusAndHalfHeight.X + Request.SweepRadius + LyraLagCompensation::HitTolerance;
+		OutResults[RequestIndex] = (FVector::DistSquared(ClosestOnAxis, ClosestOnTrace) <= FMath::Square(AllowedDistance)) ? ELyraRewindHitResult::Confirmed : ELyraRewindHitResult::Missed;
+	}
+
+	return true;
+}
+
+int32 ULyraLagCompensationSubsystem::GetFrameIndex(int32 Age) const
+{
+	return (NewestFrameIndex - Age + HistoryFrames) % HistoryFrames;
+}
+
+void ULyraLagCompensationSubsystem::SampleSlot(int32 Slot, int32 FrameIndex)
+{
+	const ACharacter* Character = SlotCharacters[Slot].Get();
+	const UCapsuleComponent* Capsule = Character ? Character->GetCapsuleComponent() : nullptr;
+	if (Capsule == nullptr)
+	{
+		return;
+	}
+
+	const int32 SampleIndex = GetSampleIndex(Slot, FrameIndex);
+	SampleCenters[SampleIndex] = Capsule->GetComponentLocation();
+	SampleRotations[SampleIndex] = Capsule->GetComponentQuat();
+	SampleRadiusAndHalfHeights[SampleIndex] = FVector2f(Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight());
+}
+
+void ULyraLagCompensationSubsystem::GrowSlots(int32 NewSlotCapacity)
+{
+	// Samples are slot-major, so existing slots keep their indices and new slots are appended
+	SlotCapacity = NewSlotCapacity;
+	SampleCenters.SetNumZeroed(SlotCapacity * HistoryFrames);
+	SampleRotations.SetNum(SlotCapacity * HistoryFrames);
+	SampleRadiusAndHalfHeights.SetNumZeroed(SlotCapacity * HistoryFrames);
+}
@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "LyraLagCompensationSubsystem.generated.h"
+
+class ACharacter;
+class UObject;
+
+// A single claimed hit to validate against the rewound hitbox of the actor it hit
+struct FLyraRewindHitRequest
+{
+	// The actor the client claims to have hit
+	const AActor* HitActor = nullptr;
+
+	// The bullet trace the client performed
+	FVector TraceStart = FVector::ZeroVector;
+	FVector TraceEnd = FVector::ZeroVector;
+
+	// Radius of the bullet sweep, zero for a ray
+	float SweepRadius = 0.0f;
+};
+
+// What the server decided about a claimed hit
+enum class ELyraRewindHitResult : uint8
+{
+	// The trace passed through the rewound hitbox
+	Confirmed,
+
+	// The hit actor has no recorded history (e.g., world geometry), so it can't be validated
+	NotTracked,
+
+	// The trace missed the rewound hitbox, the hit should be replaced with a miss
+	Missed,
+
+	// The trace did not start at the shooter or was longer than the weapon's range, the shot should be rejected
+	InvalidTrace
+};
+
+/**
+ * ULyraLagCompensationSubsystem
+ *
+ * Server-side history of character hitboxes, used to validate hits claimed by clients against
+ * where the target was when the client fired rather than where it is now.
+ *
+ * Every server frame the capsule of each registered character is sampled into a ring buffer.
+ * The history is stored as structure-of-arrays (one array per field, slot-major) so sampling and
+ * rewinding a batch of hits only touches the fields it needs. Rewinding finds the bracketing frames
+ * once per batch and interpolates each hit target from them, so the cost per shot is constant
+ * regardless of how many shots are fired over the match.
+ */
+UCLASS()
+class ULyraLagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	//~FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~End of FTickableGameObject interface
+
+	// Starts recording hitbox history for a character, should only be called on the authority
+	void RegisterCharacter(ACharacter* Character);
+
+	// Stops recording hitbox history for a character
+	void UnregisterCharacter(ACharacter* Character);
+
+	// Returns the time to rewind to for a shot fired by the specified controller at ClientTimestamp (in server world time, as estimated by the client)
+	double GetRewindTime(const AController* Shooter, double ClientTimestamp) const;
+
+	/**
+	 * Validates a batch of hits fired at the same time against the recorded hitboxes
+	 *
+	 * @param RewindTime		The server time to rewind to (see GetRewindTime)
+	 * @param Shooter			The actor that fired, every trace must start close to it
+	 * @param MaxTraceLength	The weapon's range, longer traces are invalid
+	 * @param Requests			The hits to validate
+	 * @param OutResults		Receives one result per request
+	 *
+	 * @return false if RewindTime is outside of the recorded history, in which case the whole batch should be rejected
+	 */
+	bool ValidateHits(double RewindTime, const AActor* Shooter, float MaxTraceLength, TConstArrayView<FLyraRewindHitRequest> Requests, TArrayView<ELyraRewindHitResult> OutResults) const;
+
+private:
+	// Index of a frame in the ring buffer, Age 0 being the newest frame
+	int32 GetFrameIndex(int32 Age) const;
+
+	// Index of a sample in the per slot arrays
+	int32 GetSampleIndex(int32 Slot, int32 FrameIndex) const { return (Slot * HistoryFrames) + FrameIndex; }
+
+	// Records the current capsule of a slot's character into the specified frame
+	void SampleSlot(int32 Slot, int32 FrameIndex);
+
+	void GrowSlots(int32 NewSlotCapacity);
+
+private:
+	// Number of frames kept for each character
+	int32 HistoryFrames = 0;
+
+	// Number of character slots the sample arrays are sized for
+	int32 SlotCapacity = 0;
+
+	// Ring buffer position of the newest frame, INDEX_NONE until the first sample
+	int32 NewestFrameIndex = INDEX_NONE;
+
+	// Number of frames recorded so far, capped at HistoryFrames
+	int32 NumFramesRecorded = 0;
+
+	// Server time of each frame in the ring buffer
+	TArray<double> FrameTimes;
+
+	// Capsule samples, indexed by GetSampleIndex
+	TArray<FVector> SampleCenters;
+	TArray<FQuat> SampleRotations;
+	TArray<FVector2f> SampleRadiusAndHalfHeights;
+
+	// Character recorded in each slot, null for free slots
+	TArray<TWeakObjectPtr<ACharacter>> SlotCharacters;
+	TArray<int32> FreeSlots;
+	TMap<TObjectKey<AActor>, int32> ActorToSlot;
+};
@@ -4,6 +4,7 @@
 #include "NativeGameplayTags.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
 #include "Camera/LyraCameraComponent.h"
 #include "Physics/PhysicalMaterialWithTags.h"
 #include "Weapons/LyraWeaponInstance.h"
@@ -12,6 +13,42 @@
 
 UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Lyra_Weapon_SteadyAimingCamera, "Lyra.Weapon.SteadyAimingCamera");
 
+namespace LyraConsoleVariables
+{
+	static bool bBakeHeatCurves = true;
+	static FAutoConsoleVariableRef CVarBakeHeatCurves(
+		TEXT("lyra.Weapon.BakeHeatCurves"),
+		bBakeHeatCurves,
+		TEXT("Should ranged weapons update their heat and spread from tables baked from the heat curves (otherwise the curves are evaluated directly)"),
+		ECVF_Default);
+}
+
+//////////////////////////////////////////////////////////////////////
+// FLyraHeatCurveLUT
+
+void FLyraHeatCurveLUT::Bake(const FRichCurve& Curve, float InMinHeat, float InMaxHeat, int32 NumSamples)
+{
+	// A degenerate heat range only ever evaluates to a single value
+	if (InMaxHeat <= InMinHeat)
+	{
+		NumSamples = 1;
+	}
+
+	MinHeat = InMinHeat;
+	HeatToSampleScale = (NumSamples > 1) ? (float)(NumSamples - 1) / (InMaxHeat - InMinHeat) : 0.0f;
+
+	Samples.SetNumUninitialized(NumSamples);
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		const float Heat = (NumSamples > 1) ? FMath::Lerp(InMinHeat, InMaxHeat, (float)Index / (float)(NumSamples - 1)) : InMinHeat;
+		Samples[Index] = Curve.Eval(Heat);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// ULyraRangedWeaponInstance
+
+
 ULyraRangedWeaponInstance::ULyraRangedWeaponInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -32,6 +69,12 @@ void ULyraRangedWeaponInstance::PostLoad()
 void ULyraRangedWeaponInstance::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (HeatToSpreadLUT.IsBaked())
+	{
+		BakeHeatCurves();
+	}
+
 	UpdateDebugVisualization();
 }
 
@@ -49,14 +92,13 @@ void ULyraRangedWeaponInstance::OnEquipped()
 {
 	Super::OnEquipped();
 
+	BakeHeatCurves();
+
 	// Start heat in the middle
-	float MinHeatRange;
-	float MaxHeatRange;
-	ComputeHeatRange(/*out*/ MinHeatRange, /*out*/ MaxHeatRange);
-	CurrentHeat = (MinHeatRange + MaxHeatRange) * 0.5f;
+	CurrentHeat = (BakedMinHeat + BakedMaxHeat) * 0.5f;
 
 	// Derive spread
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentSpreadAngle = EvalHeatCurve(HeatToSpreadCurve, HeatToSpreadLUT, CurrentHeat, LyraConsoleVariables::bBakeHeatCurves);
 
 	// Default the multipliers to 1x
 	CurrentSpreadAngleMultiplier = 1.0f;
@@ -108,14 +150,57 @@ void ULyraRangedWeaponInstance::ComputeSpreadRange(float& MinSpread, float& MaxS
 	HeatToSpreadCurve.GetRichCurveConst()->GetValueRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 }
 
+void ULyraRangedWeaponInstance::BakeHeatCurves()
+{
+	ComputeHeatRange(/*out*/ BakedMinHeat, /*out*/ BakedMaxHeat);
+
+	HeatToSpreadLUT.Bake(*HeatToSpreadCurve.GetRichCurveConst(), BakedMinHeat, BakedMaxHeat, HeatCurveResolution);
+	HeatToHeatPerShotLUT.Bake(*HeatToHeatPerShotCurve.GetRichCurveConst(), BakedMinHeat, BakedMaxHeat, HeatCurveResolution);
+	HeatToCoolDownPerSecondLUT.Bake(*HeatToCoolDownPerSecondCurve.GetRichCurveConst(), BakedMinHeat, BakedMaxHeat, HeatCurveResolution);
+
+	// Taken from the table rather than the curve keys so it matches the spread the table can actually reach
+	BakedMinSpread = HeatToSpreadLUT.GetMinValue();
+}
+
+bool ULyraRangedWeaponInstance::UseBakedHeatCurves()
+{
+	if (!LyraConsoleVariables::bBakeHeatCurves)
+	{
+		return false;
+	}
+
+	if (!HeatToSpreadLUT.IsBaked())
+	{
+		BakeHeatCurves();
+	}
+
+	return true;
+}
+
+float ULyraRangedWeaponInstance::ClampHeat(float NewHeat, bool bUseBakedCurves)
+{
+	if (bUseBakedCurves)
+	{
+		return FMath::Clamp(NewHeat, BakedMinHeat, BakedMaxHeat);
+	}
+
+	float MinHeat;
+	float MaxHeat;
+	ComputeHeatRange(/*out*/ MinHeat, /*out*/ MaxHeat);
+
+	return FMath::Clamp(NewHeat, MinHeat, MaxHeat);
+}
+
 void ULyraRangedWeaponInstance::AddSpread()
 {
+	const bool bUseBakedCurves = UseBakedHeatCurves();
+
 	// Sample the heat up curve
-	const float HeatPerShot = HeatToHeatPerShotCurve.GetRichCurveConst()->Eval(CurrentHeat);
-	CurrentHeat = ClampHeat(CurrentHeat + HeatPerShot);
+	const float HeatPerShot = EvalHeatCurve(HeatToHeatPerShotCurve, HeatToHeatPerShotLUT, CurrentHeat, bUseBakedCurves);
+	CurrentHeat = ClampHeat(CurrentHeat + HeatPerShot, bUseBakedCurves);
 
 	// Map the heat to the spread angle
-	CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+	CurrentSpreadAngle = EvalHeatCurve(HeatToSpreadCurve, HeatToSpreadLUT, CurrentHeat, bUseBakedCurves);
 
 #if WITH_EDITOR
 	UpdateDebugVisualization();
@@ -148,17 +233,21 @@ float ULyraRangedWeaponInstance::GetPhysicalMaterialAttenuation(const UPhysicalM
 bool ULyraRangedWeaponInstance::UpdateSpread(float DeltaSeconds)
 {
 	const float TimeSinceFired = GetWorld()->TimeSince(LastFireTime);
+	const bool bUseBakedCurves = UseBakedHeatCurves();
 
 	if (TimeSinceFired > SpreadRecoveryCooldownDelay)
 	{
-		const float CooldownRate = HeatToCoolDownPerSecondCurve.GetRichCurveConst()->Eval(CurrentHeat);
-		CurrentHeat = ClampHeat(CurrentHeat - (CooldownRate * DeltaSeconds));
-		CurrentSpreadAngle = HeatToSpreadCurve.GetRichCurveConst()->Eval(CurrentHeat);
+		const float CooldownRate = EvalHeatCurve(HeatToCoolDownPerSecondCurve, HeatToCoolDownPerSecondLUT, CurrentHeat, bUseBakedCurves);
+		CurrentHeat = ClampHeat(CurrentHeat - (CooldownRate * DeltaSeconds), bUseBakedCurves);
+		CurrentSpreadAngle = EvalHeatCurve(HeatToSpreadCurve, HeatToSpreadLUT, CurrentHeat, bUseBakedCurves);
+	}
+
+	float MinSpread = BakedMinSpread;
+	if (!bUseBakedCurves)
+	{
+		float MaxSpread;
+		ComputeSpreadRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 	}
-	
-	float MinSpread;
-	float MaxSpread;
-	ComputeSpreadRange(/*out*/ MinSpread, /*out*/ MaxSpread);
 
 	return FMath::IsNearlyEqual(CurrentSpreadAngle, MinSpread, KINDA_SMALL_NUMBER);
 }
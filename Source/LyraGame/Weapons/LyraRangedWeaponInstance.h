@@ -11,6 +11,45 @@
 
 class UPhysicalMaterial;
 
+/**
+ * FLyraHeatCurveLUT
+ *
+ * A heat curve baked into a fixed number of evenly spaced samples over the weapon's heat range,
+ * evaluated with linear interpolation between the two nearest samples
+ */
+struct FLyraHeatCurveLUT
+{
+public:
+	void Bake(const FRichCurve& Curve, float InMinHeat, float InMaxHeat, int32 NumSamples);
+
+	void Reset()
+	{
+		Samples.Reset();
+	}
+
+	bool IsBaked() const
+	{
+		return Samples.Num() > 0;
+	}
+
+	float GetMinValue() const
+	{
+		return FMath::Min(Samples);
+	}
+
+	float Eval(float Heat) const
+	{
+		const float Position = FMath::Clamp((Heat - MinHeat) * HeatToSampleScale, 0.0f, (float)(Samples.Num() - 1));
+		const int32 Index = FMath::Min((int32)Position, Samples.Num() - 2);
+		return (Index < 0) ? Samples[0] : FMath::Lerp(Samples[Index], Samples[Index + 1], Position - (float)Index);
+	}
+
+private:
+	TArray<float> Samples;
+	float MinHeat = 0.0f;
+	float HeatToSampleScale = 0.0f;
+};
+
 /**
  * ULyraRangedWeaponInstance
  *
@@ -43,6 +82,12 @@ public:
 		return CurrentSpreadAngle;
 	}
 
+	/** Returns the current heat */
+	float GetCurrentHeat() const
+	{
+		return CurrentHeat;
+	}
+
 	float GetCalculatedSpreadAngleMultiplier() const
 	{
 		return bHasFirstShotAccuracy ? 0.0f : CurrentSpreadAngleMultiplier;
@@ -94,6 +139,10 @@ protected:
 
 #endif
 
+	// Number of samples the heat curves are baked into when the weapon is equipped
+	UPROPERTY(EditAnywhere, Category="Spread|Fire Params", AdvancedDisplay, meta=(ClampMin=2, ClampMax=4096))
+	int32 HeatCurveResolution = 256;
+
 	// Spread exponent, affects how tightly shots will cluster around the center line
 	// when the weapon has spread (non-perfect accuracy). Higher values will cause shots
 	// to be closer to the center (default is 1.0 which means uniformly within the spread range)
@@ -214,6 +263,16 @@ private:
 	// The current crouching multiplier
 	float CrouchingMultiplier = 1.0f;
 
+	// The heat curves baked over the heat range, so the per tick update doesn't have to evaluate the rich curves
+	FLyraHeatCurveLUT HeatToSpreadLUT;
+	FLyraHeatCurveLUT HeatToHeatPerShotLUT;
+	FLyraHeatCurveLUT HeatToCoolDownPerSecondLUT;
+
+	// Ranges of the heat curves, cached when they are baked
+	float BakedMinHeat = 0.0f;
+	float BakedMaxHeat = 0.0f;
+	float BakedMinSpread = 0.0f;
+
 public:
 	void Tick(float DeltaSeconds);
 
@@ -224,6 +283,9 @@ public:
 
 	void AddSpread();
 
+	// Bakes the heat curves into lookup tables and caches their ranges (done automatically when equipped, the tables are used unless lyra.Weapon.BakeHeatCurves is disabled)
+	void BakeHeatCurves();
+
 	//~ILyraAbilitySourceInterface interface
 	virtual float GetDistanceAttenuation(float Distance, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr) const override;
 	virtual float GetPhysicalMaterialAttenuation(const UPhysicalMaterial* PhysicalMaterial, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr) const override;
@@ -233,13 +295,14 @@ private:
 	void ComputeSpreadRange(float& MinSpread, float& MaxSpread);
 	void ComputeHeatRange(float& MinHeat, float& MaxHeat);
 
-	inline float ClampHeat(float NewHeat)
-	{
-		float MinHeat;
-		float MaxHeat;
-		ComputeHeatRange(/*out*/ MinHeat, /*out*/ MaxHeat);
+	// Returns true if the baked tables should be used (baking them if needed), false if the curves should be evaluated directly
+	bool UseBakedHeatCurves();
+
+	float ClampHeat(float NewHeat, bool bUseBakedCurves);
 
-		return FMath::Clamp(NewHeat, MinHeat, MaxHeat);
+	inline float EvalHeatCurve(const FRuntimeFloatCurve& Curve, const FLyraHeatCurveLUT& LUT, float Heat, bool bUseBakedCurves) const
+	{
+		return bUseBakedCurves ? LUT.Eval(Heat) : Curve.GetRichCurveConst()->Eval(Heat);
 	}
 
 	// Updates the spread and returns true if the spread is at minimum
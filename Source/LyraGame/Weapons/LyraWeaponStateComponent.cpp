@@ -31,16 +31,41 @@ void ULyraWeaponStateComponent::TickComponent(float DeltaTime, enum ELevelTick T
 
 	if (APawn* Pawn = GetPawn<APawn>())
 	{
-		if (ULyraEquipmentManagerComponent* EquipmentManager = Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>())
+		if (ULyraRangedWeaponInstance* CurrentWeapon = GetCurrentRangedWeapon(Pawn))
 		{
-			if (ULyraRangedWeaponInstance* CurrentWeapon = Cast<ULyraRangedWeaponInstance>(EquipmentManager->GetFirstInstanceOfType(ULyraRangedWeaponInstance::StaticClass())))
-			{
-				CurrentWeapon->Tick(DeltaTime);
-			}
+			CurrentWeapon->Tick(DeltaTime);
 		}
 	}
 }
 
+ULyraRangedWeaponInstance* ULyraWeaponStateComponent::GetCurrentRangedWeapon(APawn* Pawn)
+{
+	if ((CachedPawn.Get() != Pawn) || !CachedEquipmentManager.IsValid())
+	{
+		CachedPawn = Pawn;
+		CachedEquipmentManager = Pawn->FindComponentByClass<ULyraEquipmentManagerComponent>();
+		CachedEquipmentRevision = INDEX_NONE;
+	}
+
+	ULyraEquipmentManagerComponent* EquipmentManager = CachedEquipmentManager.Get();
+	if (EquipmentManager == nullptr)
+	{
+		CachedRangedWeapon.Reset();
+		return nullptr;
+	}
+
+	// Search again whenever the pawn's equipment changed, finding no ranged weapon is cached until then as well
+	// (a weapon that was destroyed without being unequipped, e.g. with its pawn, leaves a stale pointer and is searched for again)
+	const int32 EquipmentRevision = EquipmentManager->GetEquipmentRevision();
+	if ((EquipmentRevision != CachedEquipmentRevision) || CachedRangedWeapon.IsStale())
+	{
+		CachedEquipmentRevision = EquipmentRevision;
+		CachedRangedWeapon = EquipmentManager->GetFirstInstanceOfType<ULyraRangedWeaponInstance>();
+	}
+
+	return CachedRangedWeapon.Get();
+}
+
 bool ULyraWeaponStateComponent::ShouldShowHitAsSuccess(const FHitResult& Hit) const
 {
 	AActor* HitActor = Hit.GetActor();
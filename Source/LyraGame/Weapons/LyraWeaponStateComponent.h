@@ -7,6 +7,9 @@
 
 #include "LyraWeaponStateComponent.generated.h"
 
+class APawn;
+class ULyraEquipmentManagerComponent;
+class ULyraRangedWeaponInstance;
 class UObject;
 struct FFrame;
 struct FGameplayAbilityTargetDataHandle;
@@ -80,6 +83,9 @@ protected:
 
 	void ActuallyUpdateDamageInstigatedTime();
 
+	// Returns the ranged weapon equipped by the controlled pawn, only searching the equipment when it has changed (or nothing was found)
+	ULyraRangedWeaponInstance* GetCurrentRangedWeapon(APawn* Pawn);
+
 private:
 	/** Last time this controller instigated weapon damage */
 	double LastWeaponDamageInstigatedTime = 0.0;
@@ -89,4 +95,10 @@ private:
 
 	/** The unconfirmed hits */
 	TArray<FLyraServerSideHitMarkerBatch> UnconfirmedServerSideHitMarkers;
+
+	/** The ranged weapon equipped by CachedPawn (null if it has none), looked up again when the pawn changes or its equipment revision does */
+	TWeakObjectPtr<ULyraRangedWeaponInstance> CachedRangedWeapon;
+	TWeakObjectPtr<ULyraEquipmentManagerComponent> CachedEquipmentManager;
+	TWeakObjectPtr<APawn> CachedPawn;
+	int32 CachedEquipmentRevision = INDEX_NONE;
 };